@@ -10,6 +10,8 @@ int main(int argc, char *argv[]) {
     fmt.setVersion(4, 1);
     fmt.setDepthBufferSize(24);
     fmt.setStencilBufferSize(8);
+    // Vsync: RenderView paces continuous camera motion on frameSwapped
+    fmt.setSwapInterval(1);
     QSurfaceFormat::setDefaultFormat(fmt);
 
     QApplication app(argc, argv);
@@ -1,18 +1,31 @@
 #version 410 core
-layout(location=0) in vec3 a_pos;
-layout(location=1) in vec3 a_normal;
+// Instanced normal glyphs: one line (2 vertices) per instance, no vertex attributes.
+// Instance i draws the normal of point (i * u_stride), fetched from texture buffers.
+uniform samplerBuffer u_positions;
+uniform samplerBuffer u_normals;
 
-uniform vec4 u_clipPlane;
-// Pass model-space data to geometry stage
-out vec3 v_pos;
-out vec3 v_normal;
-out float clip;
+uniform mat4 u_mvp;
+uniform float u_normalLen;        // length in world units
+uniform int u_stride;             // draw every u_stride-th point
+uniform vec4 u_clipPlane;         // clipping plane
+uniform float u_clipPlaneEnabled; // clip plane enabled
 
-// We set gl_Position but geometry shader will recompute with u_mvp
 void main() {
-    v_pos = a_pos;
-    v_normal = a_normal;
-    clip = dot(u_clipPlane, vec4(a_pos, 1.0));
-    gl_Position = vec4(a_pos, 1.0);
-}
+    int idx = gl_InstanceID * u_stride;
+    vec3 p0 = texelFetch(u_positions, idx).xyz;
+    vec3 n = texelFetch(u_normals, idx).xyz;
+    float lenN = length(n);
+
+    // Base point clip value; if it's outside, skip this normal entirely.
+    float baseClip = dot(u_clipPlane, vec4(p0, 1.0));
+    if (lenN < 1e-8 || (baseClip < 0.0 && u_clipPlaneEnabled > 0.9)) {
+        // Both vertices land outside the view volume, so the line is discarded
+        gl_Position = vec4(2.0, 2.0, 2.0, 1.0);
+        gl_ClipDistance[0] = -1.0;
+        return;
+    }
 
+    vec3 p = p0 + (n / lenN) * (u_normalLen * float(gl_VertexID));
+    gl_Position = u_mvp * vec4(p, 1.0);
+    gl_ClipDistance[0] = baseClip;
+}
@@ -0,0 +1,13 @@
+#version 410 core
+// ID buffer: writes (u_idOffset + point index) or (u_idOffset + triangle index) as RGBA8 bytes
+uniform uint u_idOffset;
+uniform int u_usePrimitiveId; // 1: triangles (gl_PrimitiveID), 0: points (vertex id)
+
+flat in int v_vertexId;
+out vec4 fragColor;
+
+void main() {
+    uint id = u_idOffset + uint(u_usePrimitiveId != 0 ? gl_PrimitiveID : v_vertexId);
+    fragColor = vec4(float(id & 0xFFu), float((id >> 8) & 0xFFu),
+                     float((id >> 16) & 0xFFu), float((id >> 24) & 0xFFu)) / 255.0;
+}
@@ -8,6 +8,8 @@
 #include <QObject>
 #include <memory>
 #include <QString>
+#include <vector>
+#include <cstdint>
 
 class BaseInputParameter : public QObject {
     Q_OBJECT
@@ -30,6 +32,10 @@ class PoissonReconstructionParameter : public BaseInputParameter {
     Q_PROPERTY(double distance MEMBER distance)
     Q_PROPERTY(int neighbors_number MEMBER neighbors_number)
     Q_PROPERTY(double spacing_scale MEMBER spacing_scale)
+    Q_PROPERTY(int tiles_per_axis MEMBER tiles_per_axis)
+    Q_PROPERTY(double tile_overlap_ratio MEMBER tile_overlap_ratio)
+    Q_PROPERTY(int max_parallel_tiles MEMBER max_parallel_tiles)
+    Q_PROPERTY(int memory_budget_mb MEMBER memory_budget_mb)
 
 public:
     explicit PoissonReconstructionParameter(QObject *parent = nullptr) : BaseInputParameter(parent) {}
@@ -42,6 +48,10 @@ public:
         copy->distance = distance;
         copy->neighbors_number = neighbors_number;
         copy->spacing_scale = spacing_scale;
+        copy->tiles_per_axis = tiles_per_axis;
+        copy->tile_overlap_ratio = tile_overlap_ratio;
+        copy->max_parallel_tiles = max_parallel_tiles;
+        copy->memory_budget_mb = memory_budget_mb;
         return copy;
     }
 
@@ -51,6 +61,10 @@ public:
         if (name == "distance") return QStringLiteral("Allowed point-to-surface deviation ≈ distance × average spacing. Smaller fits data (noisier); larger is smoother.");
         if (name == "neighbors_number") return QStringLiteral("Neighbor count used to estimate average spacing. Affects stability and performance.");
         if (name == "spacing_scale") return QStringLiteral("Scale applied to estimated average spacing. >1 smoother/coarser; <1 tighter/more details.");
+        if (name == "tiles_per_axis") return QStringLiteral("Tiled mode: split the bounding box into N×N×N tiles reconstructed independently. 1 disables tiling.");
+        if (name == "tile_overlap_ratio") return QStringLiteral("Tile overlap relative to the tile size. Larger overlap gives cleaner seams but more work per tile.");
+        if (name == "max_parallel_tiles") return QStringLiteral("Upper limit on tiles reconstructed at the same time. Peak memory ≈ running tiles × per-tile size. 0 uses all cores.");
+        if (name == "memory_budget_mb") return QStringLiteral("Tiled mode: approximate memory (MB) the running tiles may use together; lowers the number of parallel tiles when the largest tiles would exceed it. 0 = no limit.");
         return {};
     }
 
@@ -59,11 +73,19 @@ public:
     double distance = 0.375;
     int neighbors_number = 6; // used to calculate average spacing
     double spacing_scale = 1.0; // used to scale average spacing
+    int tiles_per_axis = 1; // 1 = single Poisson solve over the whole cloud
+    double tile_overlap_ratio = 0.15;
+    int max_parallel_tiles = 0; // 0 = hardware concurrency
+    int memory_budget_mb = 4096; // 0 = concurrency limited by max_parallel_tiles only
 };
 
 class ScaleSpaceReconstructionParameter : public BaseInputParameter {
     Q_OBJECT
     Q_PROPERTY(int iterations_number MEMBER iterations_number)
+    Q_PROPERTY(bool use_jet_smoother MEMBER use_jet_smoother)
+    Q_PROPERTY(int smoother_neighbors MEMBER smoother_neighbors)
+    Q_PROPERTY(bool use_advancing_front_mesher MEMBER use_advancing_front_mesher)
+    Q_PROPERTY(double max_facet_length_scale MEMBER max_facet_length_scale)
 public:
     explicit ScaleSpaceReconstructionParameter(QObject *parent = nullptr) : BaseInputParameter(parent) {}
     ~ScaleSpaceReconstructionParameter() override = default;
@@ -71,26 +93,146 @@ public:
     [[nodiscard]] std::unique_ptr<BaseInputParameter> clone() const override {
         auto copy = std::make_unique<ScaleSpaceReconstructionParameter>();
         copy->iterations_number = iterations_number;
+        copy->use_jet_smoother = use_jet_smoother;
+        copy->smoother_neighbors = smoother_neighbors;
+        copy->use_advancing_front_mesher = use_advancing_front_mesher;
+        copy->max_facet_length_scale = max_facet_length_scale;
         return copy;
     }
 
     [[nodiscard]] QString propertyToolTip(const QString& name) const override {
-        if (name == "iterations_number") return QStringLiteral("Number of scale-increase iterations. More is smoother/simpler (possible detail loss).");
+        if (name == "iterations_number") return QStringLiteral("Number of scale-increase iterations. More is smoother/simpler (possible detail loss). Raising it reuses the previous scales while the point cloud is unchanged.");
+        if (name == "use_jet_smoother") return QStringLiteral("Smooth each scale with jet fitting instead of weighted PCA. Jet keeps curvature better; PCA is faster.");
+        if (name == "smoother_neighbors") return QStringLiteral("Neighbors used by the smoother at each scale. Changing it restarts from scale 0.");
+        if (name == "use_advancing_front_mesher") return QStringLiteral("Mesh the smoothed points with advancing front instead of alpha shapes (fewer non-manifold artefacts).");
+        if (name == "max_facet_length_scale") return QStringLiteral("Advancing-front mesher: maximum facet edge length as a multiple of average spacing. 0 disables.");
         return {};
     }
 
     int iterations_number = 4;
+    bool use_jet_smoother = false;
+    int smoother_neighbors = 12;
+    bool use_advancing_front_mesher = false;
+    double max_facet_length_scale = 0.0;
 };
 
 class AdvancingFrontReconstructionParameter : public BaseInputParameter {
     Q_OBJECT
+    Q_PROPERTY(double radius_ratio_bound MEMBER radius_ratio_bound)
+    Q_PROPERTY(double beta MEMBER beta)
+    Q_PROPERTY(double max_facet_length_scale MEMBER max_facet_length_scale)
+    Q_PROPERTY(int tiles_per_axis MEMBER tiles_per_axis)
+    Q_PROPERTY(double tile_overlap_ratio MEMBER tile_overlap_ratio)
+    Q_PROPERTY(int max_parallel_tiles MEMBER max_parallel_tiles)
+    Q_PROPERTY(int seam_hole_max_edges MEMBER seam_hole_max_edges)
 public:
     explicit AdvancingFrontReconstructionParameter(QObject *parent = nullptr) : BaseInputParameter(parent) {}
     ~AdvancingFrontReconstructionParameter() override = default;
 
     [[nodiscard]] std::unique_ptr<BaseInputParameter> clone() const override {
-        return std::make_unique<AdvancingFrontReconstructionParameter>();
+        auto copy = std::make_unique<AdvancingFrontReconstructionParameter>();
+        copy->radius_ratio_bound = radius_ratio_bound;
+        copy->beta = beta;
+        copy->max_facet_length_scale = max_facet_length_scale;
+        copy->tiles_per_axis = tiles_per_axis;
+        copy->tile_overlap_ratio = tile_overlap_ratio;
+        copy->max_parallel_tiles = max_parallel_tiles;
+        copy->seam_hole_max_edges = seam_hole_max_edges;
+        return copy;
+    }
+
+    [[nodiscard]] QString propertyToolTip(const QString& name) const override {
+        if (name == "radius_ratio_bound") return QStringLiteral("Candidate facets whose circumradius exceeds this ratio × the radius of their neighbours are rejected. Smaller is stricter (fewer slivers, more holes).");
+        if (name == "beta") return QStringLiteral("Maximum dihedral angle deviation (radians) accepted when gluing a facet to the front. Default 0.52 (~30°).");
+        if (name == "max_facet_length_scale") return QStringLiteral("Reject facets with an edge longer than this × average spacing; avoids bridging holes and speeds up slivery inputs. 0 disables.");
+        if (name == "tiles_per_axis") return QStringLiteral("Tiled mode: split the bounding box into N×N×N cells reconstructed in parallel. 1 disables tiling.");
+        if (name == "tile_overlap_ratio") return QStringLiteral("Cell overlap relative to the cell size. Larger overlap gives cleaner seams but more work per cell.");
+        if (name == "max_parallel_tiles") return QStringLiteral("Cells reconstructed at the same time. 0 uses all cores.");
+        if (name == "seam_hole_max_edges") return QStringLiteral("Tiled mode: fill holes along cell seams whose border has at most this many edges. 0 disables.");
+        return {};
+    }
+
+    double radius_ratio_bound = 5.0;
+    double beta = 0.52;
+    double max_facet_length_scale = 0.0; // × average spacing; 0 = unbounded
+    int tiles_per_axis = 1; // 1 = single reconstruction over the whole cloud
+    double tile_overlap_ratio = 0.1;
+    int max_parallel_tiles = 0; // 0 = hardware concurrency
+    int seam_hole_max_edges = 12;
+};
+
+class ScreenedPoissonReconstructionParameter : public BaseInputParameter {
+    Q_OBJECT
+    Q_PROPERTY(int depth MEMBER depth)
+    Q_PROPERTY(int coarse_depth MEMBER coarse_depth)
+    Q_PROPERTY(double point_weight MEMBER point_weight)
+    Q_PROPERTY(int max_iterations MEMBER max_iterations)
+    Q_PROPERTY(double tolerance MEMBER tolerance)
+public:
+    explicit ScreenedPoissonReconstructionParameter(QObject *parent = nullptr) : BaseInputParameter(parent) {}
+    ~ScreenedPoissonReconstructionParameter() override = default;
+
+    [[nodiscard]] std::unique_ptr<BaseInputParameter> clone() const override {
+        auto copy = std::make_unique<ScreenedPoissonReconstructionParameter>();
+        copy->depth = depth;
+        copy->coarse_depth = coarse_depth;
+        copy->point_weight = point_weight;
+        copy->max_iterations = max_iterations;
+        copy->tolerance = tolerance;
+        return copy;
+    }
+
+    [[nodiscard]] QString propertyToolTip(const QString& name) const override {
+        if (name == "depth") return QStringLiteral("Finest lattice: 2^depth cells along the longest axis. +1 doubles the resolution and roughly quadruples time and memory.");
+        if (name == "coarse_depth") return QStringLiteral("Depth of the first (coarsest) solve; each finer level starts from the previous solution.");
+        if (name == "point_weight") return QStringLiteral("Screening weight: how strongly the surface is pulled through the samples. 0 = plain Poisson (smoother, may drift).");
+        if (name == "max_iterations") return QStringLiteral("Conjugate-gradient iterations per level.");
+        if (name == "tolerance") return QStringLiteral("Relative residual at which each level stops iterating.");
+        return {};
+    }
+
+    int depth = 8;
+    int coarse_depth = 5;
+    double point_weight = 4.0;
+    int max_iterations = 100;
+    double tolerance = 1e-4;
+};
+
+class VoxelReconstructionParameter : public BaseInputParameter {
+    Q_OBJECT
+    Q_PROPERTY(double voxel_size MEMBER voxel_size)
+    Q_PROPERTY(double spacing_scale MEMBER spacing_scale)
+    Q_PROPERTY(int min_points_per_voxel MEMBER min_points_per_voxel)
+    Q_PROPERTY(int close_iterations MEMBER close_iterations)
+    Q_PROPERTY(int smoothing_passes MEMBER smoothing_passes)
+public:
+    explicit VoxelReconstructionParameter(QObject *parent = nullptr) : BaseInputParameter(parent) {}
+    ~VoxelReconstructionParameter() override = default;
+
+    [[nodiscard]] std::unique_ptr<BaseInputParameter> clone() const override {
+        auto copy = std::make_unique<VoxelReconstructionParameter>();
+        copy->voxel_size = voxel_size;
+        copy->spacing_scale = spacing_scale;
+        copy->min_points_per_voxel = min_points_per_voxel;
+        copy->close_iterations = close_iterations;
+        copy->smoothing_passes = smoothing_passes;
+        return copy;
+    }
+
+    [[nodiscard]] QString propertyToolTip(const QString& name) const override {
+        if (name == "voxel_size") return QStringLiteral("Voxel edge length (same unit as points). 0 derives it from the point density.");
+        if (name == "spacing_scale") return QStringLiteral("Automatic voxel size = this × the mean point spacing. Larger closes gaps between samples but loses detail.");
+        if (name == "min_points_per_voxel") return QStringLiteral("Voxels with fewer points are treated as empty; raise to ignore stray points.");
+        if (name == "close_iterations") return QStringLiteral("Morphological close (dilate then erode) steps; fills pores up to about twice this many voxels. 0 disables.");
+        if (name == "smoothing_passes") return QStringLiteral("Blur passes over the occupancy before extracting the surface; softens the voxel staircase.");
+        return {};
     }
+
+    double voxel_size = 0.0; // 0 = automatic
+    double spacing_scale = 2.0;
+    int min_points_per_voxel = 1;
+    int close_iterations = 1;
+    int smoothing_passes = 1;
 };
 
 // New: Mesh post-process parameters moved from MeshPostprocessOptions
@@ -101,6 +243,8 @@ class MeshPostprocessParameter : public BaseInputParameter {
     Q_PROPERTY(bool remove_isolated_vertices MEMBER remove_isolated_vertices)
     Q_PROPERTY(bool stitch_borders MEMBER stitch_borders)
     Q_PROPERTY(int fill_holes_max_cycle_edges MEMBER fill_holes_max_cycle_edges)
+    Q_PROPERTY(double fill_holes_max_diameter MEMBER fill_holes_max_diameter)
+    Q_PROPERTY(int fill_holes_mode MEMBER fill_holes_mode)
     Q_PROPERTY(int remesh_iterations MEMBER remesh_iterations)
     Q_PROPERTY(double remesh_target_edge_length MEMBER remesh_target_edge_length)
     Q_PROPERTY(int smooth_iterations MEMBER smooth_iterations)
@@ -116,6 +260,8 @@ public:
         copy->remove_isolated_vertices = remove_isolated_vertices;
         copy->stitch_borders = stitch_borders;
         copy->fill_holes_max_cycle_edges = fill_holes_max_cycle_edges;
+        copy->fill_holes_max_diameter = fill_holes_max_diameter;
+        copy->fill_holes_mode = fill_holes_mode;
         copy->remesh_iterations = remesh_iterations;
         copy->remesh_target_edge_length = remesh_target_edge_length;
         copy->smooth_iterations = smooth_iterations;
@@ -129,6 +275,8 @@ public:
         if (name == "remove_isolated_vertices") return QStringLiteral("Remove vertices not used by any face to clean the mesh.");
         if (name == "stitch_borders") return QStringLiteral("Stitch near-coincident boundary edges to close cracks, aiding hole filling and remeshing.");
         if (name == "fill_holes_max_cycle_edges") return QStringLiteral("Fill holes whose border cycle length is ≤ this value. Larger fills more; too large may close real openings.");
+        if (name == "fill_holes_max_diameter") return QStringLiteral("Also skip holes whose border bounding-box diagonal exceeds this length. 0 = no diameter limit.");
+        if (name == "fill_holes_mode") return QStringLiteral("0 = triangulate only, 1 = triangulate and refine (density matches the surrounding mesh), 2 = triangulate, refine and fair (smooth patch).");
         if (name == "remesh_iterations") return QStringLiteral("Number of isotropic remeshing iterations. More improves triangle quality, increases resampling.");
         if (name == "remesh_target_edge_length") return QStringLiteral("Target edge length. 0 uses average edge length; smaller subdivides, larger simplifies.");
         if (name == "smooth_iterations") return QStringLiteral("Number of angle-and-area smoothing iterations. More smoothing, possible shrinkage.");
@@ -141,12 +289,48 @@ public:
     bool remove_isolated_vertices = true;
     bool stitch_borders = false;
     int fill_holes_max_cycle_edges = 0;
+    double fill_holes_max_diameter = 0.0;
+    int fill_holes_mode = 0;
     int remesh_iterations = 0;
     double remesh_target_edge_length = 0.0;
     int smooth_iterations = 0;
     bool recompute_normals = true;
 };
 
+// New: Quadric-error mesh decimation parameters
+class MeshDecimationParameter : public BaseInputParameter {
+    Q_OBJECT
+    Q_PROPERTY(int target_face_count MEMBER target_face_count)
+    Q_PROPERTY(double target_ratio MEMBER target_ratio)
+    Q_PROPERTY(bool preserve_borders MEMBER preserve_borders)
+    Q_PROPERTY(int cluster_prepass_faces MEMBER cluster_prepass_faces)
+public:
+    explicit MeshDecimationParameter(QObject *parent = nullptr) : BaseInputParameter(parent) {}
+    ~MeshDecimationParameter() override = default;
+
+    [[nodiscard]] std::unique_ptr<BaseInputParameter> clone() const override {
+        auto copy = std::make_unique<MeshDecimationParameter>();
+        copy->target_face_count = target_face_count;
+        copy->target_ratio = target_ratio;
+        copy->preserve_borders = preserve_borders;
+        copy->cluster_prepass_faces = cluster_prepass_faces;
+        return copy;
+    }
+
+    [[nodiscard]] QString propertyToolTip(const QString& name) const override {
+        if (name == "target_face_count") return QStringLiteral("Stop collapsing edges at this many faces. 0 uses target_ratio instead.");
+        if (name == "target_ratio") return QStringLiteral("Target face count as a fraction of the current faces (used when target_face_count is 0), e.g. 0.1 keeps 10%.");
+        if (name == "preserve_borders") return QStringLiteral("Never collapse border edges and keep border vertices in place, so open boundaries keep their shape. With the clustering pre-pass only the original borders are locked: clustering can open new borders or non-manifold spots (dropped on reassembly), which are then simplified like any other edge.");
+        if (name == "cluster_prepass_faces") return QStringLiteral("Meshes with more faces than this are first reduced by parallel vertex clustering to about twice the target, then decimated with quadrics. 0 disables the pre-pass.");
+        return {};
+    }
+
+    int target_face_count = 0;
+    double target_ratio = 0.1;
+    bool preserve_borders = true;
+    int cluster_prepass_faces = 2000000;
+};
+
 // New: AABB filter parameters
 class AABBFilterParameter : public BaseInputParameter {
     Q_OBJECT
@@ -217,6 +401,84 @@ public:
     bool keepInside = true;
 };
 
+// New: Oriented box filter parameters
+class OrientedBoxFilterParameter : public BaseInputParameter {
+    Q_OBJECT
+    Q_PROPERTY(double cx MEMBER cx)
+    Q_PROPERTY(double cy MEMBER cy)
+    Q_PROPERTY(double cz MEMBER cz)
+    Q_PROPERTY(double rx MEMBER rx)
+    Q_PROPERTY(double ry MEMBER ry)
+    Q_PROPERTY(double rz MEMBER rz)
+    Q_PROPERTY(double hx MEMBER hx)
+    Q_PROPERTY(double hy MEMBER hy)
+    Q_PROPERTY(double hz MEMBER hz)
+    Q_PROPERTY(bool keepInside MEMBER keepInside)
+public:
+    explicit OrientedBoxFilterParameter(QObject *parent = nullptr) : BaseInputParameter(parent) {}
+    ~OrientedBoxFilterParameter() override = default;
+
+    [[nodiscard]] std::unique_ptr<BaseInputParameter> clone() const override {
+        auto copy = std::make_unique<OrientedBoxFilterParameter>();
+        copy->cx = cx; copy->cy = cy; copy->cz = cz;
+        copy->rx = rx; copy->ry = ry; copy->rz = rz;
+        copy->hx = hx; copy->hy = hy; copy->hz = hz;
+        copy->keepInside = keepInside;
+        return copy;
+    }
+
+    [[nodiscard]] QString propertyToolTip(const QString& name) const override {
+        if (name == "cx" || name == "cy" || name == "cz") return QStringLiteral("Box center coordinate.");
+        if (name == "rx" || name == "ry" || name == "rz") return QStringLiteral("Box rotation in degrees, applied X then Y then Z (same as the split plane).");
+        if (name == "hx" || name == "hy" || name == "hz") return QStringLiteral("Half extent along the rotated box axis.");
+        if (name == "keepInside") return QStringLiteral("If true, keep points inside the box; otherwise remove inside points (keep outside).");
+        return {};
+    }
+
+    double cx = 0.0;
+    double cy = 0.0;
+    double cz = 0.0;
+    double rx = 0.0;
+    double ry = 0.0;
+    double rz = 0.0;
+    double hx = 1.0;
+    double hy = 1.0;
+    double hz = 1.0;
+    bool keepInside = true;
+};
+
+// New: Half-space (plane) filter parameters; the split-plane docker fills them from the clip plane
+class HalfSpaceFilterParameter : public BaseInputParameter {
+    Q_OBJECT
+    Q_PROPERTY(double nx MEMBER nx)
+    Q_PROPERTY(double ny MEMBER ny)
+    Q_PROPERTY(double nz MEMBER nz)
+    Q_PROPERTY(double d MEMBER d)
+    Q_PROPERTY(bool keepPositive MEMBER keepPositive)
+public:
+    explicit HalfSpaceFilterParameter(QObject *parent = nullptr) : BaseInputParameter(parent) {}
+    ~HalfSpaceFilterParameter() override = default;
+
+    [[nodiscard]] std::unique_ptr<BaseInputParameter> clone() const override {
+        auto copy = std::make_unique<HalfSpaceFilterParameter>();
+        copy->nx = nx; copy->ny = ny; copy->nz = nz; copy->d = d; copy->keepPositive = keepPositive;
+        return copy;
+    }
+
+    [[nodiscard]] QString propertyToolTip(const QString& name) const override {
+        if (name == "nx" || name == "ny" || name == "nz") return QStringLiteral("Plane normal component (need not be unit length).");
+        if (name == "d") return QStringLiteral("Plane offset: the plane is n·p + d = 0.");
+        if (name == "keepPositive") return QStringLiteral("If true, keep points with n·p + d >= 0 (the side the split plane leaves visible); otherwise keep the other side.");
+        return {};
+    }
+
+    double nx = 0.0;
+    double ny = 0.0;
+    double nz = 1.0;
+    double d = 0.0;
+    bool keepPositive = true;
+};
+
 // New: Surface-from-uniform-volume filter parameters
 class UniformVolumeSurfaceFilterParameter : public BaseInputParameter {
     Q_OBJECT
@@ -247,10 +509,130 @@ public:
     int max_neighbors = 24;
 };
 
+// New: Outlier removal parameters (statistical or radius count)
+class OutlierRemovalParameter : public BaseInputParameter {
+    Q_OBJECT
+    Q_PROPERTY(int method MEMBER method)
+    Q_PROPERTY(int neighbors_number MEMBER neighbors_number)
+    Q_PROPERTY(double std_ratio MEMBER std_ratio)
+    Q_PROPERTY(double radius MEMBER radius)
+    Q_PROPERTY(int min_neighbors MEMBER min_neighbors)
+public:
+    explicit OutlierRemovalParameter(QObject *parent = nullptr) : BaseInputParameter(parent) {}
+    ~OutlierRemovalParameter() override = default;
+
+    [[nodiscard]] std::unique_ptr<BaseInputParameter> clone() const override {
+        auto copy = std::make_unique<OutlierRemovalParameter>();
+        copy->method = method;
+        copy->neighbors_number = neighbors_number;
+        copy->std_ratio = std_ratio;
+        copy->radius = radius;
+        copy->min_neighbors = min_neighbors;
+        return copy;
+    }
+
+    [[nodiscard]] QString propertyToolTip(const QString& name) const override {
+        if (name == "method") return QStringLiteral("0 = statistical (mean k-NN distance vs. global mean + std_ratio × sigma), 1 = radius count (fewer than min_neighbors within radius).");
+        if (name == "neighbors_number") return QStringLiteral("Statistical: neighbors k for the mean distance. Radius: neighbors used for the average spacing when radius is 0. Typical: 24.");
+        if (name == "std_ratio") return QStringLiteral("Statistical: points whose mean k-NN distance exceeds mean + std_ratio × sigma are removed. Smaller removes more. Typical: 1-3.");
+        if (name == "radius") return QStringLiteral("Radius count: search radius; 0 = average point spacing.");
+        if (name == "min_neighbors") return QStringLiteral("Radius count: points with fewer other points within the radius are removed.");
+        return {};
+    }
+
+    int method = 0;
+    int neighbors_number = 24;
+    double std_ratio = 2.0;
+    double radius = 0.0;
+    int min_neighbors = 6;
+};
+
+// New: Normal estimation parameters, shared by all NormalEstimationMethod values
+class NormalEstimationParameter : public BaseInputParameter {
+    Q_OBJECT
+    Q_PROPERTY(int neighbors_number MEMBER neighbors_number)
+    Q_PROPERTY(double radius MEMBER radius)
+    Q_PROPERTY(int max_neighbors MEMBER max_neighbors)
+    Q_PROPERTY(double vcm_offset_radius MEMBER vcm_offset_radius)
+    Q_PROPERTY(double vcm_convolution_radius MEMBER vcm_convolution_radius)
+    Q_PROPERTY(bool orient MEMBER orient)
+    Q_PROPERTY(int orientation_method MEMBER orientation_method)
+    Q_PROPERTY(int orientation_neighbors MEMBER orientation_neighbors)
+    Q_PROPERTY(bool only_missing MEMBER only_missing)
+public:
+    explicit NormalEstimationParameter(QObject *parent = nullptr) : BaseInputParameter(parent) {}
+    ~NormalEstimationParameter() override = default;
+
+    [[nodiscard]] std::unique_ptr<BaseInputParameter> clone() const override {
+        auto copy = std::make_unique<NormalEstimationParameter>();
+        copy->neighbors_number = neighbors_number;
+        copy->radius = radius;
+        copy->max_neighbors = max_neighbors;
+        copy->vcm_offset_radius = vcm_offset_radius;
+        copy->vcm_convolution_radius = vcm_convolution_radius;
+        copy->orient = orient;
+        copy->orientation_method = orientation_method;
+        copy->orientation_neighbors = orientation_neighbors;
+        copy->only_missing = only_missing;
+        return copy;
+    }
+
+    [[nodiscard]] QString propertyToolTip(const QString& name) const override {
+        if (name == "neighbors_number") return QStringLiteral("k nearest neighbors per point (Jet, Uniform Centroid, PCA). Typical: 24; 8-12 is much faster on dense, clean scans.");
+        if (name == "radius") return QStringLiteral("If > 0, use all neighbors within this radius instead of the k nearest (Jet, Uniform Centroid, PCA). Same unit as points.");
+        if (name == "max_neighbors") return QStringLiteral("With a radius: keep at most this many closest neighbors per point (0 = no cap). Bounds the cost in dense areas.");
+        if (name == "vcm_offset_radius") return QStringLiteral("VCM offset radius (0 = auto: 2 × average spacing).");
+        if (name == "vcm_convolution_radius") return QStringLiteral("VCM convolution radius (0 = auto: 4 × average spacing). Larger smooths more.");
+        if (name == "orient") return QStringLiteral("Give the normals a consistent sign after estimation.");
+        if (name == "orientation_method") return QStringLiteral("0 = CGAL MST (single-threaded), 1 = parallel MST, 2 = centroid sign (closed scans only).");
+        if (name == "orientation_neighbors") return QStringLiteral("Neighbors per point in the orientation graph (0 = same as neighbors_number).");
+        if (name == "only_missing") return QStringLiteral("Only estimate points without a valid normal; existing normals are kept and new ones are oriented to agree with them.");
+        return {};
+    }
+
+    int neighbors_number = 24;
+    double radius = 0.0;
+    int max_neighbors = 0;
+    double vcm_offset_radius = 0.0;
+    double vcm_convolution_radius = 0.0;
+    bool orient = true;
+    int orientation_method = 1;
+    int orientation_neighbors = 0;
+    bool only_missing = false;
+};
+
+// New: Normal orientation parameters
+class NormalOrientationParameter : public BaseInputParameter {
+    Q_OBJECT
+    Q_PROPERTY(int method MEMBER method)
+    Q_PROPERTY(int neighbors_number MEMBER neighbors_number)
+public:
+    explicit NormalOrientationParameter(QObject *parent = nullptr) : BaseInputParameter(parent) {}
+    ~NormalOrientationParameter() override = default;
+
+    [[nodiscard]] std::unique_ptr<BaseInputParameter> clone() const override {
+        auto copy = std::make_unique<NormalOrientationParameter>();
+        copy->method = method;
+        copy->neighbors_number = neighbors_number;
+        return copy;
+    }
+
+    [[nodiscard]] QString propertyToolTip(const QString& name) const override {
+        if (name == "method") return QStringLiteral("0 = CGAL MST (single-threaded), 1 = parallel MST (multi-threaded, same result quality), 2 = centroid sign (closed scans only, fastest).");
+        if (name == "neighbors_number") return QStringLiteral("Neighbors per point in the orientation graph (MST methods). Typical: 12-24; lower is faster on dense scans.");
+        return {};
+    }
+
+    int method = 1;
+    int neighbors_number = 24;
+};
+
 // New: Voxel downsample parameters
 class VoxelDownsampleParameter : public BaseInputParameter {
     Q_OBJECT
     Q_PROPERTY(double cell_size MEMBER cell_size)
+    Q_PROPERTY(int representative MEMBER representative)
+    Q_PROPERTY(int seed MEMBER seed)
 public:
     explicit VoxelDownsampleParameter(QObject *parent = nullptr) : BaseInputParameter(parent) {}
     ~VoxelDownsampleParameter() override = default;
@@ -258,23 +640,160 @@ public:
     [[nodiscard]] std::unique_ptr<BaseInputParameter> clone() const override {
         auto copy = std::make_unique<VoxelDownsampleParameter>();
         copy->cell_size = cell_size;
+        copy->representative = representative;
+        copy->seed = seed;
         return copy;
     }
 
     [[nodiscard]] QString propertyToolTip(const QString& name) const override {
         if (name == "cell_size") return QStringLiteral("Voxel grid cell size (same unit as points). Larger removes more points, increasing sparsity.");
+        if (name == "representative") return QStringLiteral("Point kept per cell: 0 = centroid (averaged normals, smoothest input for Poisson), 1 = first input point, 2 = random, 3 = closest to the cell center.");
+        if (name == "seed") return QStringLiteral("Seed for the random representative; the same seed picks the same points.");
         return {};
     }
 
     double cell_size = 0.0;
+    int representative = 0;
+    int seed = 0;
+};
+
+// New: Hierarchy clustering simplification (CGAL::hierarchy_simplify_point_set)
+class HierarchySimplifyParameter : public BaseInputParameter {
+    Q_OBJECT
+    Q_PROPERTY(int max_cluster_size MEMBER max_cluster_size)
+    Q_PROPERTY(double max_surface_variation MEMBER max_surface_variation)
+public:
+    explicit HierarchySimplifyParameter(QObject *parent = nullptr) : BaseInputParameter(parent) {}
+    ~HierarchySimplifyParameter() override = default;
+
+    [[nodiscard]] std::unique_ptr<BaseInputParameter> clone() const override {
+        auto copy = std::make_unique<HierarchySimplifyParameter>();
+        copy->max_cluster_size = max_cluster_size;
+        copy->max_surface_variation = max_surface_variation;
+        return copy;
+    }
+
+    [[nodiscard]] QString propertyToolTip(const QString& name) const override {
+        if (name == "max_cluster_size") return QStringLiteral("Clusters larger than this are split; each final cluster becomes one point. Larger removes more points.");
+        if (name == "max_surface_variation") return QStringLiteral("Clusters whose surface variation exceeds this are split, so curved and sharp regions keep more points. Range 0-1/3.");
+        return {};
+    }
+
+    int max_cluster_size = 10;
+    double max_surface_variation = 0.333;
+};
+
+// New: WLOP simplification and regularization (CGAL::wlop_simplify_and_regularize_point_set)
+class WLOPSimplifyParameter : public BaseInputParameter {
+    Q_OBJECT
+    Q_PROPERTY(double select_percentage MEMBER select_percentage)
+    Q_PROPERTY(double neighbor_radius MEMBER neighbor_radius)
+    Q_PROPERTY(int iterations MEMBER iterations)
+    Q_PROPERTY(bool require_uniform_sampling MEMBER require_uniform_sampling)
+public:
+    explicit WLOPSimplifyParameter(QObject *parent = nullptr) : BaseInputParameter(parent) {}
+    ~WLOPSimplifyParameter() override = default;
+
+    [[nodiscard]] std::unique_ptr<BaseInputParameter> clone() const override {
+        auto copy = std::make_unique<WLOPSimplifyParameter>();
+        copy->select_percentage = select_percentage;
+        copy->neighbor_radius = neighbor_radius;
+        copy->iterations = iterations;
+        copy->require_uniform_sampling = require_uniform_sampling;
+        return copy;
+    }
+
+    [[nodiscard]] QString propertyToolTip(const QString& name) const override {
+        if (name == "select_percentage") return QStringLiteral("Percentage of input points kept (0-100]. Typical: 2-10.");
+        if (name == "neighbor_radius") return QStringLiteral("Projection neighborhood radius; 0 = automatic (8 × average spacing). Too small leaves noise and clusters.");
+        if (name == "iterations") return QStringLiteral("Projection iterations. Typical: 35.");
+        if (name == "require_uniform_sampling") return QStringLiteral("Compute a density weight so non-uniform input ends up evenly spread (slower).");
+        return {};
+    }
+
+    double select_percentage = 5.0;
+    double neighbor_radius = 0.0;
+    int iterations = 35;
+    bool require_uniform_sampling = false;
+};
+
+// New: Bilateral point set smoothing (CGAL::bilateral_smooth_point_set); needs normals
+class BilateralSmoothingParameter : public BaseInputParameter {
+    Q_OBJECT
+    Q_PROPERTY(int neighbors_number MEMBER neighbors_number)
+    Q_PROPERTY(double neighbor_radius MEMBER neighbor_radius)
+    Q_PROPERTY(double sharpness_angle MEMBER sharpness_angle)
+    Q_PROPERTY(int iterations MEMBER iterations)
+public:
+    explicit BilateralSmoothingParameter(QObject *parent = nullptr) : BaseInputParameter(parent) {}
+    ~BilateralSmoothingParameter() override = default;
+
+    [[nodiscard]] std::unique_ptr<BaseInputParameter> clone() const override {
+        auto copy = std::make_unique<BilateralSmoothingParameter>();
+        copy->neighbors_number = neighbors_number;
+        copy->neighbor_radius = neighbor_radius;
+        copy->sharpness_angle = sharpness_angle;
+        copy->iterations = iterations;
+        return copy;
+    }
+
+    [[nodiscard]] QString propertyToolTip(const QString& name) const override {
+        if (name == "neighbors_number") return QStringLiteral("Neighbors per point; with a radius, the cap on the neighborhood size. Typical: 24.");
+        if (name == "neighbor_radius") return QStringLiteral("Neighborhood radius; 0 = use neighbors_number only.");
+        if (name == "sharpness_angle") return QStringLiteral("Degrees; smaller keeps sharper edges, larger smooths more. Typical: 25.");
+        if (name == "iterations") return QStringLiteral("Smoothing passes (each also updates the normals). Typical: 2-4.");
+        return {};
+    }
+
+    int neighbors_number = 24;
+    double neighbor_radius = 0.0;
+    double sharpness_angle = 25.0;
+    int iterations = 3;
+};
+
+// New: Screen-space selection (box/lasso) filter parameters.
+// The mask is built by RenderView for the cloud currently displayed: one byte per point, non-zero = selected.
+class SelectionMaskFilterParameter : public BaseInputParameter {
+    Q_OBJECT
+    Q_PROPERTY(bool keepSelected MEMBER keepSelected)
+public:
+    explicit SelectionMaskFilterParameter(QObject *parent = nullptr) : BaseInputParameter(parent) {}
+    ~SelectionMaskFilterParameter() override = default;
+
+    [[nodiscard]] std::unique_ptr<BaseInputParameter> clone() const override {
+        auto copy = std::make_unique<SelectionMaskFilterParameter>();
+        copy->mask = mask;
+        copy->cloudRevision = cloudRevision;
+        copy->keepSelected = keepSelected;
+        return copy;
+    }
+
+    [[nodiscard]] QString propertyToolTip(const QString& name) const override {
+        if (name == "keepSelected") return QStringLiteral("If true, keep only the selected points; otherwise delete the selected points.");
+        return {};
+    }
+
+    std::vector<std::uint8_t> mask; // size must match the point cloud
+    std::uint64_t cloudRevision = 0; // PointCloudModel::revision the mask was made on
+    bool keepSelected = false;
 };
 
 Q_DECLARE_METATYPE(BaseInputParameter*)
 // Optionally register derived pointer types as well
 Q_DECLARE_METATYPE(MeshPostprocessParameter*)
+Q_DECLARE_METATYPE(MeshDecimationParameter*)
 Q_DECLARE_METATYPE(AABBFilterParameter*)
 Q_DECLARE_METATYPE(SphereFilterParameter*)
+Q_DECLARE_METATYPE(OrientedBoxFilterParameter*)
+Q_DECLARE_METATYPE(HalfSpaceFilterParameter*)
 Q_DECLARE_METATYPE(UniformVolumeSurfaceFilterParameter*)
+Q_DECLARE_METATYPE(OutlierRemovalParameter*)
 Q_DECLARE_METATYPE(VoxelDownsampleParameter*)
+Q_DECLARE_METATYPE(HierarchySimplifyParameter*)
+Q_DECLARE_METATYPE(WLOPSimplifyParameter*)
+Q_DECLARE_METATYPE(BilateralSmoothingParameter*)
+Q_DECLARE_METATYPE(NormalEstimationParameter*)
+Q_DECLARE_METATYPE(NormalOrientationParameter*)
+Q_DECLARE_METATYPE(SelectionMaskFilterParameter*)
 
 #endif //POINTTOMESH_BASEINPUTPARAMETER_H
@@ -13,36 +13,312 @@ namespace PMP = CGAL::Polygon_mesh_processing;
 
 // Normal Estimation
 #include <CGAL/jet_estimate_normals.h>
+#include <CGAL/Monge_via_jet_fitting.h>
 #include <CGAL/mst_orient_normals.h>
 #include <CGAL/vcm_estimate_normals.h>
+#include <CGAL/hierarchy_simplify_point_set.h>
+#include <CGAL/wlop_simplify_and_regularize_point_set.h>
+#include <CGAL/bilateral_smooth_point_set.h>
 
 #include <CGAL/Scale_space_surface_reconstruction_3.h>
+#include <CGAL/Scale_space_reconstruction_3/Jet_smoother.h>
+#include <CGAL/Scale_space_reconstruction_3/Weighted_PCA_smoother.h>
+#include <CGAL/Scale_space_reconstruction_3/Alpha_shape_mesher.h>
+#include <CGAL/Scale_space_reconstruction_3/Advancing_front_mesher.h>
+#include <optional>
 #include <CGAL/Advancing_front_surface_reconstruction.h>
 #include <CGAL/compute_average_spacing.h>
 #include <array>
 
-// Neighbor search for centroid-based normals
+// CGAL neighbor search (tiled reconstruction)
 #include <CGAL/Search_traits_3.h>
-#include <CGAL/Kd_tree.h>
-#include <CGAL/Fuzzy_sphere.h>
+#include <CGAL/Orthogonal_k_neighbor_search.h>
 
 #include "BaseInputParameter.h"
 
 // New includes for point set processing and mesh post-processing
-#include <CGAL/grid_simplify_point_set.h>
 #include <CGAL/Polygon_mesh_processing/repair.h>
 #include <CGAL/Polygon_mesh_processing/repair_degeneracies.h>
 #include <CGAL/Polygon_mesh_processing/connected_components.h>
 #include <CGAL/Polygon_mesh_processing/remesh.h>
 #include <CGAL/Polygon_mesh_processing/triangulate_hole.h>
+#include <CGAL/Polygon_mesh_processing/refine.h>
+#include <CGAL/Polygon_mesh_processing/fair.h>
+#include <CGAL/boost/graph/Euler_operations.h>
 #include <CGAL/Polygon_mesh_processing/stitch_borders.h>
 #include <CGAL/Polygon_mesh_processing/angle_and_area_smoothing.h>
+#include <CGAL/Polygon_mesh_processing/clip.h>
+#include <CGAL/Polygon_mesh_processing/measure.h>
+#include <CGAL/Surface_mesh_simplification/edge_collapse.h>
+#include <CGAL/Surface_mesh_simplification/Policies/Edge_collapse/Face_count_stop_predicate.h>
+#include <CGAL/Surface_mesh_simplification/Policies/Edge_collapse/GarlandHeckbert_policies.h>
+#include <CGAL/Surface_mesh_simplification/Policies/Edge_collapse/Constrained_placement.h>
+
+// Triangle soups (tiled reconstruction)
+#include <sstream>
+#include <limits>
+#include <utility>
+#include "Parallel.h"
+#include "TiledReconstruction.h"
+#include "MeshAssembly.h"
+#include "ScreenedPoisson.h"
+#include "VoxelReconstruction.h"
+#include "NormalOrientation.h"
+#include "PcaNormals.h"
+#include "NeighborSearch.h"
+#include "VoxelDownsample.h"
+#include "OutlierRemoval.h"
+#include "CropKernels.h"
+#include "MeshClustering.h"
+#include <cmath>
+#include <chrono>
+#include <iterator>
+
+namespace {
+// Tiles with fewer points are skipped (too little data for a stable local solve)
+constexpr std::size_t kTileMinPoints = 64;
+// Tiled Poisson: faces farther than this many spacings from all points of their tile are
+// closure surfaces of the local solve, not data, and are discarded
+constexpr double kTileMaxDataDistance = 4.0;
+// Tiled Poisson: seam vertices of neighbouring tiles closer than this fraction of the spacing are
+// welded. A full spacing would also merge distinct vertices of thin features crossing a seam.
+constexpr double kTileWeldFraction = 0.25;
+// Rough peak footprint of one tiled Poisson solve per input point (Delaunay refinement, implicit
+// function, solver matrix and the tile's output mesh), used to size the tile concurrency
+constexpr std::size_t kPoissonTileBytesPerPoint = 2048;
+
+// Advancing-front priority: the default smallest Delaunay sphere radius, except that facets with an
+// edge longer than the bound get infinite priority and are never added to the front. Rejecting them
+// here is cheaper than letting the front grow across holes and cleaning up afterwards.
+struct MaxEdgeLengthPriority {
+    double squaredBound {0.0}; // 0 = unbounded
+
+    template <typename AdvancingFront, typename Cell_handle>
+    double operator()(const AdvancingFront& adv, Cell_handle& c, const int& index) const {
+        if (squaredBound > 0.0) {
+            const auto& p1 = c->vertex((index + 1) % 4)->point();
+            const auto& p2 = c->vertex((index + 2) % 4)->point();
+            const auto& p3 = c->vertex((index + 3) % 4)->point();
+            if (CGAL::to_double(CGAL::squared_distance(p1, p2)) > squaredBound ||
+                CGAL::to_double(CGAL::squared_distance(p2, p3)) > squaredBound ||
+                CGAL::to_double(CGAL::squared_distance(p1, p3)) > squaredBound) {
+                return adv.infinity();
+            }
+        }
+        return adv.smallest_radius_delaunay_sphere(c, index);
+    }
+};
+
+// Run advancing front on pts with the parameters of af (defaults if null)
+void runAdvancingFront(const std::vector<Point>& pts, const AdvancingFrontReconstructionParameter* af,
+                       std::vector<std::array<std::size_t,3>>& facets) {
+    const AdvancingFrontReconstructionParameter defaults;
+    const auto& opt = af ? *af : defaults;
+    MaxEdgeLengthPriority priority;
+    if (opt.max_facet_length_scale > 0.0 && pts.size() > 6) {
+        const double spacing = CGAL::compute_average_spacing<CGAL::Sequential_tag>(pts, 6);
+        const double bound = opt.max_facet_length_scale * spacing;
+        priority.squaredBound = bound * bound;
+    }
+    CGAL::advancing_front_surface_reconstruction(pts.begin(), pts.end(), std::back_inserter(facets),
+                                                 priority, opt.radius_ratio_bound, opt.beta);
+}
+
+bool isValidNormal(const Vector& n) {
+    const double len2 = n.squared_length();
+    return std::isfinite(len2) && len2 > 0.0;
+}
+
+// Neighborhood of q for the normal estimators: the k nearest, or the radius neighborhood capped at the
+// max_neighbors closest (0 = no cap). `skip` as for KdTree::nearest.
+void gatherNeighborhood(const NeighborSearch::KdTree& tree, const Point& q, const NormalEstimationParameter& p,
+                        std::vector<NeighborSearch::Neighbor>& out, std::size_t skip = static_cast<std::size_t>(-1)) {
+    const std::array<double, 3> query {q.x(), q.y(), q.z()};
+    if (!(p.radius > 0.0)) {
+        tree.nearest(query, static_cast<std::size_t>(p.neighbors_number), out, skip);
+    } else if (p.max_neighbors > 0) {
+        tree.nearest(query, static_cast<std::size_t>(p.max_neighbors), out, skip);
+        const double r2 = p.radius * p.radius;
+        out.erase(std::find_if(out.begin(), out.end(), [r2](const auto& nb) { return nb.squaredDistance > r2; }), out.end());
+    } else {
+        tree.withinRadius(query, p.radius, out, skip);
+    }
+}
+
+double millisecondsSince(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+// Parallel count over a mesh element range; pred only reads the mesh
+template <typename Range, typename Pred>
+std::size_t countIf(const Range& range, Pred&& pred) {
+    using Element = typename std::iterator_traits<decltype(range.begin())>::value_type;
+    const std::vector<Element> elements(range.begin(), range.end());
+    std::vector<std::size_t> partial(Parallel::chunkCount(elements.size()), 0);
+    Parallel::forChunks(elements.size(), [&](std::size_t c, std::size_t b, std::size_t e) {
+        for (std::size_t i = b; i < e; ++i) partial[c] += pred(elements[i]) ? 1 : 0;
+    });
+    std::size_t count = 0;
+    for (std::size_t v : partial) count += v;
+    return count;
+}
+
+// Border cycles (halfedges in next() order) of at most maxEdges edges and, if maxDiameter > 0, a bounding-box
+// diagonal of at most maxDiameter. Each border halfedge is visited once. Pinched cycles (a vertex met twice)
+// cannot be patched as a simple polygon; they are skipped and counted in *pinched.
+std::vector<std::vector<Mesh::Halfedge_index>> borderCycles(const Mesh& mesh, std::size_t maxEdges, double maxDiameter,
+                                                            std::size_t* pinched = nullptr) {
+    std::vector<std::vector<Mesh::Halfedge_index>> cycles;
+    std::vector<char> seen(mesh.number_of_halfedges() + mesh.number_of_removed_halfedges(), 0);
+    std::vector<std::size_t> stamp(mesh.number_of_vertices() + mesh.number_of_removed_vertices(), 0);
+    std::size_t cycleId = 0;
+    for (Mesh::Halfedge_index h : mesh.halfedges()) {
+        if (seen[h.idx()] || !mesh.is_border(h)) continue;
+        ++cycleId;
+        std::vector<Mesh::Halfedge_index> cycle;
+        CGAL::Bbox_3 box;
+        bool repeated = false;
+        Mesh::Halfedge_index cur = h;
+        do {
+            seen[cur.idx()] = 1;
+            cycle.push_back(cur);
+            const Mesh::Vertex_index v = mesh.source(cur);
+            repeated = repeated || stamp[v.idx()] == cycleId;
+            stamp[v.idx()] = cycleId;
+            box += mesh.point(v).bbox();
+            cur = mesh.next(cur);
+        } while (cur != h && cycle.size() <= seen.size());
+        if (cycle.size() > maxEdges) continue;
+        if (maxDiameter > 0.0) {
+            const double dx = box.xmax() - box.xmin(), dy = box.ymax() - box.ymin(), dz = box.zmax() - box.zmin();
+            if (dx * dx + dy * dy + dz * dz > maxDiameter * maxDiameter) continue;
+        }
+        if (repeated) {
+            if (pinched) ++*pinched;
+            continue;
+        }
+        cycles.push_back(std::move(cycle));
+    }
+    return cycles;
+}
+
+enum class HoleFillMode { Triangulate = 0, Refine = 1, RefineAndFair = 2 };
+
+struct HoleFillStats {
+    std::size_t filled = 0;
+    std::size_t fallbacks = 0;      // patch rejected by the mesh, filled by PMP::triangulate_hole instead
+    std::size_t failed = 0;
+    std::size_t addedVertices = 0;
+    std::size_t fairingFailures = 0;
+};
+
+// Fills the given border cycles (as returned by borderCycles). The patches (minimum-weight triangulations
+// of the hole polylines) are independent and computed in parallel. Each patch is then added serially; the
+// polyline triangulation does not know the mesh, so if a patch face is rejected (e.g. it would duplicate an
+// existing edge) the faces added so far are removed again and the hole goes through the mesh-aware
+// PMP::triangulate_hole instead. Refinement and fairing of the patch follow, per hole.
+HoleFillStats fillHoles(Mesh& mesh, const std::vector<std::vector<Mesh::Halfedge_index>>& holes, HoleFillMode mode) {
+    using Triangle = CGAL::Triple<int, int, int>;
+    std::vector<std::vector<Triangle>> patches(holes.size());
+    Parallel::forTasks(holes.size(), [&](std::size_t t) {
+        std::vector<Point> polyline;
+        polyline.reserve(holes[t].size());
+        for (auto h : holes[t]) polyline.push_back(mesh.point(mesh.source(h)));
+        PMP::triangulate_hole_polyline(polyline, std::back_inserter(patches[t]));
+    });
+
+    HoleFillStats stats;
+    std::vector<Mesh::Vertex_index> cycle;
+    std::vector<Mesh::Face_index> patchFaces;
+    for (std::size_t t = 0; t < holes.size(); ++t) {
+        cycle.clear();
+        patchFaces.clear();
+        for (auto h : holes[t]) cycle.push_back(mesh.source(h));
+        // Increasing polyline indices follow the border halfedges, i.e. the orientation of the hole.
+        // A triangle can only be attached next to ones already added, so retry until nothing changes.
+        std::vector<Triangle> pending = patches[t];
+        while (!pending.empty()) {
+            std::vector<Triangle> next;
+            for (const auto& tri : pending) {
+                std::array<int, 3> idx {tri.first, tri.second, tri.third};
+                std::sort(idx.begin(), idx.end());
+                const auto f = mesh.add_face(cycle[idx[0]], cycle[idx[1]], cycle[idx[2]]);
+                if (f == Mesh::null_face()) next.push_back(tri);
+                else patchFaces.push_back(f);
+            }
+            if (next.size() == pending.size()) break;
+            pending.swap(next);
+        }
+        if (patches[t].empty() || !pending.empty()) {
+            // Roll back the partial patch (newest first restores the border), then let CGAL fill the hole
+            for (auto it = patchFaces.rbegin(); it != patchFaces.rend(); ++it) CGAL::Euler::remove_face(mesh.halfedge(*it), mesh);
+            patchFaces.clear();
+            PMP::triangulate_hole(mesh, holes[t].front(), PMP::parameters::face_output_iterator(std::back_inserter(patchFaces)));
+            if (patchFaces.empty()) { ++stats.failed; continue; }
+            ++stats.fallbacks;
+        }
+        ++stats.filled;
+        if (mode == HoleFillMode::Triangulate) continue;
+
+        // Same density control as CGAL's triangulate_and_refine_hole
+        std::vector<Mesh::Face_index> refinedFaces;
+        std::vector<Mesh::Vertex_index> patchVertices;
+        PMP::refine(mesh, patchFaces, std::back_inserter(refinedFaces), std::back_inserter(patchVertices),
+                    PMP::parameters::density_control_factor(std::sqrt(2.0)));
+        stats.addedVertices += patchVertices.size();
+        if (mode == HoleFillMode::RefineAndFair && !patchVertices.empty() && !PMP::fair(mesh, patchVertices)) {
+            ++stats.fairingFailures;
+        }
+    }
+    return stats;
+}
+
+// Edge-is-constrained map for the simplification: border edges are never collapsed
+struct BorderEdgeMap {
+    using key_type = Mesh::Edge_index;
+    using value_type = bool;
+    using reference = bool;
+    using category = boost::readable_property_map_tag;
+    const Mesh* mesh;
+    friend bool get(const BorderEdgeMap& map, key_type e) { return map.mesh->is_border(e); }
+};
+}
+
+// Scale-space state reused while the point cloud and smoother settings are unchanged
+struct CGALPointCloudProcessor::ScaleSpaceCache {
+    using Reconstruction = CGAL::Scale_space_surface_reconstruction_3<K>;
+    using JetSmoother = CGAL::Scale_space_reconstruction_3::Jet_smoother<K, CGAL::Parallel_if_available_tag>;
+    using PCASmoother = CGAL::Scale_space_reconstruction_3::Weighted_PCA_smoother<K, CGAL::Default_diagonalize_traits<K::FT, 3>, CGAL::Parallel_if_available_tag>;
+
+    std::uint64_t revision {0};
+    bool jet {false};
+    int neighbors {0};
+    int scale {0}; // number of increase_scale iterations already applied
+    Reconstruction recon;
+    // Smoothers are kept too: the PCA smoother estimates its neighborhood radius on the first scale
+    std::optional<JetSmoother> jetSmoother;
+    std::optional<PCASmoother> pcaSmoother;
+
+    template <typename InputIterator>
+    ScaleSpaceCache(InputIterator begin, InputIterator end) : recon(begin, end) {}
+};
+
+// Points estimated in only_missing mode, with a tree over the whole cloud for their neighborhoods
+struct CGALPointCloudProcessor::NormalSubset {
+    const std::vector<std::uint32_t>& indices;
+    const NeighborSearch::KdTree& tree;
+};
 
 CGALPointCloudProcessor::CGALPointCloudProcessor() = default;
 
 CGALPointCloudProcessor::~CGALPointCloudProcessor() = default;
 
+std::vector<std::string> CGALPointCloudProcessor::takeMessages() {
+    return std::exchange(m_messages, {});
+}
+
 bool CGALPointCloudProcessor::loadPointCloud(const std::string &filePath) {
+    markPointCloudChanged();
     m_pointCloud.clear();
     m_mesh.clear();
 
@@ -51,36 +327,140 @@ bool CGALPointCloudProcessor::loadPointCloud(const std::string &filePath) {
                                CGAL::parameters::point_map(CGAL::First_of_pair_property_map<PointWithNormal>())
                                    .normal_map(CGAL::Second_of_pair_property_map<PointWithNormal>()))) {
         std::cerr << "Error: Cannot read points from " << filePath << std::endl;
+        rebuildNormalMask();
         return false;
     }
 
-    // If no normals were loaded, ensure the vector part of the pair is cleared to NULL_VECTOR
-    if (!hasNormals()) {
-        for(auto& p : m_pointCloud) {
-            p.second = CGAL::NULL_VECTOR;
-        }
+    // Per point: files without normal columns, or rows whose normal is zero/NaN, come out as missing
+    rebuildNormalMask();
+    if (m_missingNormals > 0 && m_missingNormals < m_pointCloud.size()) {
+        m_messages.push_back(std::to_string(m_missingNormals) + " of " + std::to_string(m_pointCloud.size()) +
+                             " points have no valid normal.");
     }
 
     return !m_pointCloud.empty();
 }
 
-bool CGALPointCloudProcessor::estimateNormals(NormalEstimationMethod normalMethod) {
+bool CGALPointCloudProcessor::estimateNormals(NormalEstimationMethod normalMethod, const BaseInputParameter* params) {
     if (m_pointCloud.empty()) {
         std::cerr << "Error: Point cloud is empty. Load a point cloud first." << std::endl;
         return false;
     }
 
+    // No parameters (e.g. normals needed by a reconstruction): use the defaults
+    const NormalEstimationParameter defaults;
+    const auto* p = params ? dynamic_cast<const NormalEstimationParameter*>(params) : &defaults;
+    if (!p) { std::cerr << "Error: NormalEstimationParameter expected." << std::endl; return false; }
+    if (p->radius < 0.0 || p->max_neighbors < 0 || p->vcm_offset_radius < 0.0 || p->vcm_convolution_radius < 0.0) {
+        std::cerr << "Error: radii and neighbor caps must be >= 0." << std::endl;
+        return false;
+    }
+    if (!(p->radius > 0.0) && p->neighbors_number < 1) {
+        std::cerr << "Error: neighbors_number must be >= 1 when no radius is given." << std::endl;
+        return false;
+    }
+    if (p->orient && (p->orientation_method < 0 || p->orientation_method > static_cast<int>(NormalOrientationMethod::CENTROID_SIGN))) {
+        std::cerr << "Error: Unknown orientation method " << p->orientation_method << "." << std::endl;
+        return false;
+    }
+    if (p->only_missing && m_missingNormals < m_pointCloud.size()) return estimateMissingNormals(normalMethod, *p);
+
+    bool ok = false;
     switch (normalMethod) {
         case NormalEstimationMethod::JET_ESTIMATION:
-            return estimateNormalsJet();
+            ok = estimateNormalsJet(*p);
+            break;
         case NormalEstimationMethod::UNIFORM_VOLUME_CENTROID:
-            return estimateNormalsUniformVolumeCentroid();
+            ok = estimateNormalsUniformVolumeCentroid(*p);
+            break;
         case NormalEstimationMethod::VCM_ESTIMATION:
-            return estimateNormalsVCM();
+            ok = estimateNormalsVCM(*p);
+            break;
+        case NormalEstimationMethod::PCA_ESTIMATION:
+            ok = estimateNormalsPCA(*p);
+            break;
         default:
             std::cerr << "Error: Unsupported normal estimation method." << std::endl;
             return false;
     }
+    rebuildNormalMask();
+    if (ok && m_missingNormals > 0) m_messages.push_back(std::to_string(m_missingNormals) + " points are still without a valid normal.");
+    if (!ok || !p->orient) return ok;
+
+    const int k_orient = p->orientation_neighbors > 0 ? p->orientation_neighbors : std::max(1, p->neighbors_number);
+    return orientNormals(static_cast<NormalOrientationMethod>(p->orientation_method), k_orient);
+}
+
+bool CGALPointCloudProcessor::estimateMissingNormals(NormalEstimationMethod normalMethod, const NormalEstimationParameter& p) {
+    if (m_missingNormals == 0) {
+        m_messages.push_back("All " + std::to_string(m_pointCloud.size()) + " points already have a normal; nothing to estimate.");
+        return true;
+    }
+    std::vector<std::uint32_t> missing;
+    missing.reserve(m_missingNormals);
+    for (std::size_t i = 0; i < m_normalValid.size(); ++i) {
+        if (!m_normalValid[i]) missing.push_back(static_cast<std::uint32_t>(i));
+    }
+
+    const NeighborSearch::KdTree tree(m_pointCloud);
+    const NormalSubset subset {missing, tree};
+    bool ok = false;
+    switch (normalMethod) {
+        case NormalEstimationMethod::JET_ESTIMATION:
+            ok = estimateNormalsJet(p, &subset);
+            break;
+        case NormalEstimationMethod::UNIFORM_VOLUME_CENTROID:
+            ok = estimateNormalsUniformVolumeCentroid(p, &subset);
+            break;
+        case NormalEstimationMethod::VCM_ESTIMATION:
+            ok = estimateNormalsVCM(p, &subset);
+            break;
+        case NormalEstimationMethod::PCA_ESTIMATION:
+            ok = estimateNormalsPCA(p, &subset);
+            break;
+        default:
+            std::cerr << "Error: Unsupported normal estimation method." << std::endl;
+            return false;
+    }
+
+    // The existing normals keep their sign; the new ones are turned to agree with them
+    if (ok && p.orient) {
+        const int k_orient = p.orientation_neighbors > 0 ? p.orientation_neighbors : std::max(1, p.neighbors_number);
+        NormalOrientation::Stats stats;
+        NormalOrientation::orientTowardsTrusted(m_pointCloud, tree, missing, m_normalValid, static_cast<std::size_t>(k_orient), &stats);
+        std::ostringstream msg;
+        msg << "Normal orientation (towards existing normals, k=" << k_orient << "): " << stats.rounds << " wave(s), "
+            << stats.flipped << " normals flipped";
+        if (stats.unreached > 0) msg << ", " << stats.unreached << " not connected to an existing normal and left as estimated";
+        msg << ".";
+        m_messages.push_back(msg.str());
+    }
+
+    // Only the subset changed
+    std::size_t repaired = 0;
+    for (auto i : missing) {
+        auto& normal = m_pointCloud[i].second;
+        m_normalValid[i] = isValidNormal(normal) ? 1 : 0;
+        if (m_normalValid[i]) ++repaired;
+        else normal = CGAL::NULL_VECTOR;
+    }
+    m_missingNormals -= repaired;
+    m_messages.push_back("Estimated " + std::to_string(repaired) + " of " + std::to_string(missing.size()) +
+                         " missing normals; the other " + std::to_string(m_pointCloud.size() - missing.size()) + " were kept.");
+    return ok;
+}
+
+bool CGALPointCloudProcessor::orientNormals(const BaseInputParameter* params) {
+    if (m_pointCloud.empty()) { std::cerr << "Error: No point cloud loaded." << std::endl; return false; }
+    const auto* p = params ? dynamic_cast<const NormalOrientationParameter*>(params) : nullptr;
+    if (!p) { std::cerr << "Error: NormalOrientationParameter expected." << std::endl; return false; }
+    if (m_missingNormals == m_pointCloud.size()) { std::cerr << "Error: Point cloud has no normals to orient." << std::endl; return false; }
+    if (p->method < 0 || p->method > static_cast<int>(NormalOrientationMethod::CENTROID_SIGN)) {
+        std::cerr << "Error: Unknown orientation method " << p->method << "." << std::endl;
+        return false;
+    }
+    if (p->neighbors_number < 1) { std::cerr << "Error: neighbors_number must be >= 1." << std::endl; return false; }
+    return orientNormals(static_cast<NormalOrientationMethod>(p->method), p->neighbors_number);
 }
 
 bool CGALPointCloudProcessor::processToMesh(MeshGenerationMethod meshMethod, const BaseInputParameter* params) {
@@ -102,6 +482,14 @@ bool CGALPointCloudProcessor::processToMesh(MeshGenerationMethod meshMethod, con
             const auto *af = params ? dynamic_cast<const AdvancingFrontReconstructionParameter*>(params) : nullptr;
             return processAdvancingFrontWithParams(af);
         }
+        case MeshGenerationMethod::SCREENED_POISSON_RECONSTRUCTION: {
+            const auto *sp = params ? dynamic_cast<const ScreenedPoissonReconstructionParameter*>(params) : nullptr;
+            return processScreenedPoissonWithParams(sp);
+        }
+        case MeshGenerationMethod::VOXEL_RECONSTRUCTION: {
+            const auto *vx = params ? dynamic_cast<const VoxelReconstructionParameter*>(params) : nullptr;
+            return processVoxelWithParams(vx);
+        }
         default:
             std::cerr << "Error: Unsupported mesh generation method." << std::endl;
             return false;
@@ -158,7 +546,11 @@ bool CGALPointCloudProcessor::computeMeshNormals() {
     // Create or get per-vertex normal property and compute
     auto vnormals = m_mesh.add_property_map<Mesh::Vertex_index, Vector>("v:normal", CGAL::NULL_VECTOR).first;
     try {
-        PMP::compute_vertex_normals(m_mesh, vnormals);
+        // Each vertex normal only reads its one-ring, so vertices are independent
+        const std::vector<Mesh::Vertex_index> vertices(m_mesh.vertices().begin(), m_mesh.vertices().end());
+        Parallel::forEach(vertices.size(), [&](std::size_t i) {
+            vnormals[vertices[i]] = PMP::compute_vertex_normal(vertices[i], m_mesh);
+        }, 1024);
     } catch (const std::exception& e) {
         std::cerr << "Error computing vertex normals: " << e.what() << std::endl;
         return false;
@@ -180,19 +572,42 @@ const Mesh &CGALPointCloudProcessor::getMesh() const {
 }
 
 bool CGALPointCloudProcessor::hasNormals() const {
-    if (m_pointCloud.empty()) {
-        return false;
-    }
-    // If the first point has a non-zero normal vector, we assume the file contained normals.
-    return m_pointCloud[0].second != CGAL::NULL_VECTOR;
+    return !m_pointCloud.empty() && m_missingNormals == 0;
+}
+
+std::size_t CGALPointCloudProcessor::missingNormalCount() const {
+    return m_missingNormals;
+}
+
+void CGALPointCloudProcessor::rebuildNormalMask() {
+    const std::size_t n = m_pointCloud.size();
+    m_normalValid.assign(n, 0);
+    std::vector<std::size_t> valid(Parallel::chunkCount(n), 0);
+    Parallel::forChunks(n, [&](std::size_t c, std::size_t b, std::size_t e) {
+        for (std::size_t i = b; i < e; ++i) {
+            auto& normal = m_pointCloud[i].second;
+            if (isValidNormal(normal)) { m_normalValid[i] = 1; ++valid[c]; }
+            else normal = CGAL::NULL_VECTOR; // NaN normals read as missing everywhere else too
+        }
+    });
+    m_missingNormals = n;
+    for (auto v : valid) m_missingNormals -= v;
+}
+
+void CGALPointCloudProcessor::recountMissingNormals() {
+    m_missingNormals = static_cast<std::size_t>(std::count(m_normalValid.begin(), m_normalValid.end(), std::uint8_t(0)));
 }
 
 // Helper implementations (mesh)
 bool CGALPointCloudProcessor::processPoissonWithParams(const PoissonReconstructionParameter* poisson) {
-    if (!hasNormals()) {
+    if (m_missingNormals == m_pointCloud.size()) {
         std::cerr << "Error: Normals are required for Poisson mesh generation but were not found or estimated." << std::endl;
         return false;
     }
+    if (m_missingNormals > 0) {
+        m_messages.push_back("Poisson: " + std::to_string(m_missingNormals) + " points without a normal add no orientation constraint.");
+    }
+    if (poisson && poisson->tiles_per_axis > 1) return processPoissonTiled(*poisson);
     m_mesh.clear();
     double sm_angle = 20.0;
     double sm_radius = 30.0;
@@ -225,166 +640,665 @@ bool CGALPointCloudProcessor::processPoissonWithParams(const PoissonReconstructi
     return true;
 }
 
-bool CGALPointCloudProcessor::processScaleSpaceWithParams(const ScaleSpaceReconstructionParameter* ss) {
-    std::vector<Point> pts;
-    pts.reserve(m_pointCloud.size());
-    for (const auto& pn : m_pointCloud) pts.push_back(pn.first);
-    using SSSR = CGAL::Scale_space_surface_reconstruction_3<K>;
-    SSSR recon(pts.begin(), pts.end());
-    int iters = 4;
-    if (ss) iters = ss->iterations_number;
-    if (iters < 0) iters = 0;
-    recon.increase_scale(iters);
-    recon.reconstruct_surface();
-
+bool CGALPointCloudProcessor::processPoissonTiled(const PoissonReconstructionParameter& poisson) {
     m_mesh.clear();
-    std::vector<Mesh::Vertex_index> vdesc;
-    vdesc.reserve(recon.number_of_points());
-    for (const auto& p : recon.points()) vdesc.push_back(m_mesh.add_vertex(p));
-    for (const auto& f : recon.facets()) {
-        Mesh::Vertex_index v0 = vdesc[f[0]];
-        Mesh::Vertex_index v1 = vdesc[f[1]];
-        Mesh::Vertex_index v2 = vdesc[f[2]];
-        if (v0 != v1 && v1 != v2 && v2 != v0) m_mesh.add_face(v0, v1, v2);
+    const int neighbors = std::max(1, poisson.neighbors_number);
+    const Tiling::Grid grid = Tiling::makeGrid(Tiling::boundsOf(m_pointCloud), poisson.tiles_per_axis, poisson.tile_overlap_ratio);
+    const auto buckets = Tiling::bucketPoints(m_pointCloud, grid);
+    const std::size_t tileCount = grid.tiles.size();
+    // Each running tile holds its own Delaunay triangulation and solver, so peak memory is roughly
+    // (tiles running at once) × (per-tile size); the memory budget caps the former for the largest tiles
+    const unsigned requested = poisson.max_parallel_tiles > 0 ? static_cast<unsigned>(poisson.max_parallel_tiles) : 0u;
+    const std::size_t budget = static_cast<std::size_t>(std::max(0, poisson.memory_budget_mb)) << 20;
+    const unsigned maxParallel = Tiling::parallelTilesWithin(buckets, kPoissonTileBytesPerPoint, budget, requested);
+
+    // Pass 1: average spacing per tile, combined into one global spacing so all tiles mesh at the same resolution
+    std::vector<double> tileSpacing(tileCount, 0.0);
+    Parallel::forTasks(tileCount, [&](std::size_t t) {
+        if (buckets[t].size() < kTileMinPoints) return;
+        std::vector<Point> pts;
+        pts.reserve(buckets[t].size());
+        for (auto i : buckets[t]) pts.push_back(m_pointCloud[i].first);
+        tileSpacing[t] = CGAL::compute_average_spacing<CGAL::Sequential_tag>(pts, neighbors);
+    }, maxParallel);
+    double weighted = 0.0, weight = 0.0;
+    for (std::size_t t = 0; t < tileCount; ++t) {
+        if (!(tileSpacing[t] > 0.0)) continue;
+        weighted += tileSpacing[t] * static_cast<double>(buckets[t].size());
+        weight += static_cast<double>(buckets[t].size());
+    }
+    if (!(weight > 0.0)) {
+        std::cerr << "Error: Tiled Poisson found no tile with enough points (" << kTileMinPoints << " required)." << std::endl;
+        return false;
+    }
+    const double spacing = weighted / weight * poisson.spacing_scale;
+
+    // Pass 2: independent Poisson solve per tile, clipped to the tile core
+    std::vector<Tiling::Soup> soups(tileCount);
+    std::vector<std::uint8_t> failed(tileCount, 0);
+    Parallel::forTasks(tileCount, [&](std::size_t t) {
+        if (buckets[t].size() < kTileMinPoints) return;
+        PointCloud pts;
+        pts.reserve(buckets[t].size());
+        for (auto i : buckets[t]) pts.push_back(m_pointCloud[i]);
+
+        Mesh tileMesh;
+        const bool ok = CGAL::poisson_surface_reconstruction_delaunay(
+            pts.begin(), pts.end(),
+            CGAL::First_of_pair_property_map<PointWithNormal>(),
+            CGAL::Second_of_pair_property_map<PointWithNormal>(),
+            tileMesh, spacing, poisson.angle, poisson.radius, poisson.distance);
+        if (!ok || tileMesh.is_empty()) { failed[t] = 1; return; }
+
+        Tiling::Soup soup = Tiling::soupFromMesh(tileMesh);
+        tileMesh.clear();
+        Tiling::clipToCore(soup, grid, t);
+
+        // Drop the local solve's closure surfaces (far from any input point of this tile)
+        using Traits = CGAL::Search_traits_3<K>;
+        using KnnSearch = CGAL::Orthogonal_k_neighbor_search<Traits>;
+        using Tree = KnnSearch::Tree;
+        std::vector<Point> raw;
+        raw.reserve(pts.size());
+        for (const auto& pn : pts) raw.push_back(pn.first);
+        Tree tree(raw.begin(), raw.end());
+        const double maxD2 = (kTileMaxDataDistance * spacing) * (kTileMaxDataDistance * spacing);
+        std::vector<std::uint8_t> near(soup.points.size(), 0);
+        for (std::size_t v = 0; v < soup.points.size(); ++v) {
+            KnnSearch search(tree, soup.points[v], 1);
+            near[v] = (search.begin() != search.end() && CGAL::to_double(search.begin()->second) <= maxD2) ? 1 : 0;
+        }
+        soup.triangles.erase(std::remove_if(soup.triangles.begin(), soup.triangles.end(), [&](const std::array<std::size_t,3>& f){
+            return !(near[f[0]] || near[f[1]] || near[f[2]]);
+        }), soup.triangles.end());
+        soups[t] = std::move(soup);
+    }, maxParallel);
+
+    std::size_t used = 0, failedCount = 0;
+    for (std::size_t t = 0; t < tileCount; ++t) {
+        if (failed[t]) ++failedCount;
+        else if (!soups[t].triangles.empty()) ++used;
     }
+
+    // Merge: weld seam vertices of neighbouring tiles, then build and stitch the mesh
+    Tiling::Soup merged;
+    const std::size_t welded = Tiling::mergeSoups(soups, kTileWeldFraction * spacing, merged);
+    std::vector<Tiling::Soup>().swap(soups);
+    if (merged.triangles.empty()) {
+        std::cerr << "Error: Tiled Poisson produced no faces." << std::endl;
+        return false;
+    }
+    if (!meshFromSoup(merged.points, merged.triangles)) return false;
+    const std::size_t stitched = PMP::stitch_borders(m_mesh);
+
+    std::ostringstream msg;
+    msg << "Tiled Poisson: " << tileCount << " tiles (" << used << " meshed, " << failedCount << " failed, up to "
+        << maxParallel << " at once), spacing "
+        << spacing << ", " << welded << " seam vertices welded, " << stitched << " border edges stitched, "
+        << m_mesh.number_of_faces() << " faces.";
+    m_messages.push_back(msg.str());
     return !m_mesh.is_empty();
 }
 
-bool CGALPointCloudProcessor::processAdvancingFrontWithParams(const AdvancingFrontReconstructionParameter* /*af*/) {
-    // No parameters currently, so run default advancing-front behavior
+bool CGALPointCloudProcessor::meshFromSoup(std::vector<Point>& points, std::vector<std::array<std::size_t,3>>& triangles) {
+    return meshFromSoup(points, triangles, m_mesh);
+}
+
+bool CGALPointCloudProcessor::meshFromSoup(std::vector<Point>& points, std::vector<std::array<std::size_t,3>>& triangles, Mesh& mesh) {
+    MeshAssembly::Report report;
+    const bool ok = MeshAssembly::assemble(points, triangles, mesh, &report);
+    m_messages.push_back(report.summary());
+    if (!ok) std::cerr << "Error: Mesh assembly produced no faces." << std::endl;
+    return ok;
+}
+
+bool CGALPointCloudProcessor::processScaleSpaceWithParams(const ScaleSpaceReconstructionParameter* ss) {
+    const ScaleSpaceReconstructionParameter defaults;
+    const auto& opt = ss ? *ss : defaults;
+    const int iters = std::max(0, opt.iterations_number);
+    const int neighbors = std::max(3, opt.smoother_neighbors);
+
+    // Reuse the cached scales when only the iteration count grew; anything else restarts from scale 0
+    auto& cache = m_scaleSpaceCache;
+    const bool reusable = cache && cache->revision == m_cloudRevision && cache->jet == opt.use_jet_smoother &&
+                          cache->neighbors == neighbors && cache->scale <= iters;
+    if (!reusable) {
+        std::vector<Point> pts;
+        pts.reserve(m_pointCloud.size());
+        for (const auto& pn : m_pointCloud) pts.push_back(pn.first);
+        cache = std::make_unique<ScaleSpaceCache>(pts.begin(), pts.end());
+        cache->revision = m_cloudRevision;
+        cache->jet = opt.use_jet_smoother;
+        cache->neighbors = neighbors;
+        if (cache->jet) cache->jetSmoother.emplace(static_cast<unsigned int>(neighbors));
+        else cache->pcaSmoother.emplace(static_cast<unsigned int>(neighbors));
+    }
+
+    const int todo = iters - cache->scale;
+    if (todo > 0) {
+        if (cache->jet) cache->recon.increase_scale(static_cast<unsigned int>(todo), *cache->jetSmoother);
+        else cache->recon.increase_scale(static_cast<unsigned int>(todo), *cache->pcaSmoother);
+        cache->scale = iters;
+    }
+    std::ostringstream msg;
+    msg << "Scale-space: scale " << iters << " (" << (reusable ? iters - todo : 0) << " reused, " << todo << " computed).";
+    m_messages.push_back(msg.str());
+
+    // Mesh the smoothed points
+    if (opt.use_advancing_front_mesher) {
+        double maxLength = 0.0;
+        if (opt.max_facet_length_scale > 0.0) {
+            maxLength = opt.max_facet_length_scale * CGAL::compute_average_spacing<CGAL::Parallel_if_available_tag>(
+                cache->recon.points(), 6);
+        }
+        cache->recon.reconstruct_surface(CGAL::Scale_space_reconstruction_3::Advancing_front_mesher<K>(maxLength));
+    } else {
+        // Alpha-shape radius: the smoothing neighborhood when the PCA smoother estimated it, otherwise from spacing
+        double squaredRadius = (cache->pcaSmoother && cache->pcaSmoother->squared_radius() > 0.0)
+                                   ? CGAL::to_double(cache->pcaSmoother->squared_radius()) : 0.0;
+        if (!(squaredRadius > 0.0)) {
+            const double spacing = CGAL::compute_average_spacing<CGAL::Parallel_if_available_tag>(cache->recon.points(), neighbors);
+            squaredRadius = 4.0 * spacing * spacing;
+        }
+        cache->recon.reconstruct_surface(CGAL::Scale_space_reconstruction_3::Alpha_shape_mesher<K>(squaredRadius));
+    }
+
+    std::vector<Point> points(cache->recon.points_begin(), cache->recon.points_end());
+    std::vector<std::array<std::size_t,3>> triangles;
+    triangles.reserve(cache->recon.number_of_facets());
+    for (const auto& f : cache->recon.facets()) triangles.push_back({f[0], f[1], f[2]});
+    return meshFromSoup(points, triangles);
+}
+
+bool CGALPointCloudProcessor::processAdvancingFrontWithParams(const AdvancingFrontReconstructionParameter* af) {
+    if (af && af->tiles_per_axis > 1) return processAdvancingFrontTiled(*af);
     std::vector<Point> pts;
     pts.reserve(m_pointCloud.size());
     for (const auto& pn : m_pointCloud) pts.push_back(pn.first);
 
     std::vector<std::array<std::size_t,3>> facets;
-    CGAL::advancing_front_surface_reconstruction(pts.begin(), pts.end(), std::back_inserter(facets));
+    runAdvancingFront(pts, af, facets);
+
+    facets.erase(std::remove_if(facets.begin(), facets.end(), [&](const auto& f) {
+        return f[0] >= pts.size() || f[1] >= pts.size() || f[2] >= pts.size();
+    }), facets.end());
+    return meshFromSoup(pts, facets);
+}
 
+bool CGALPointCloudProcessor::processAdvancingFrontTiled(const AdvancingFrontReconstructionParameter& af) {
     m_mesh.clear();
-    std::vector<Mesh::Vertex_index> vindices;
-    vindices.reserve(pts.size());
-    for (const auto& p : pts) vindices.push_back(m_mesh.add_vertex(p));
-    for (const auto& f : facets) {
-        const auto a = f[0], b = f[1], c = f[2];
-        if (a < vindices.size() && b < vindices.size() && c < vindices.size() && a != b && b != c && c != a) {
-            m_mesh.add_face(vindices[a], vindices[b], vindices[c]);
+    const Tiling::Grid grid = Tiling::makeGrid(Tiling::boundsOf(m_pointCloud), af.tiles_per_axis, af.tile_overlap_ratio);
+    const auto buckets = Tiling::bucketPoints(m_pointCloud, grid);
+    const std::size_t tileCount = grid.tiles.size();
+    const unsigned maxParallel = af.max_parallel_tiles > 0 ? static_cast<unsigned>(af.max_parallel_tiles) : 0u;
+
+    // Facets interpolate the input points, so each tile's output maps straight back to global point
+    // indices; a tile keeps the facets whose centroid lies in its core
+    using Facet = std::array<std::size_t,3>;
+    std::vector<std::vector<Facet>> tileFacets(tileCount);
+    Parallel::forTasks(tileCount, [&](std::size_t t) {
+        const auto& ids = buckets[t];
+        if (ids.size() < kTileMinPoints) return;
+        std::vector<Point> pts;
+        pts.reserve(ids.size());
+        for (auto i : ids) pts.push_back(m_pointCloud[i].first);
+
+        std::vector<Facet> local;
+        runAdvancingFront(pts, &af, local);
+
+        auto& out = tileFacets[t];
+        out.reserve(local.size());
+        for (const auto& f : local) {
+            const Point& a = pts[f[0]];
+            const Point& b = pts[f[1]];
+            const Point& c = pts[f[2]];
+            const Point centroid((a.x() + b.x() + c.x()) / 3.0, (a.y() + b.y() + c.y()) / 3.0, (a.z() + b.z() + c.z()) / 3.0);
+            if (grid.inCore(t, centroid)) out.push_back({ids[f[0]], ids[f[1]], ids[f[2]]});
+        }
+    }, maxParallel);
+
+    // Concatenate and drop duplicate facets (same vertex triple, any orientation)
+    std::vector<std::pair<Facet, Facet>> keyed; // (sorted triple, facet)
+    std::size_t total = 0;
+    for (const auto& f : tileFacets) total += f.size();
+    keyed.reserve(total);
+    for (auto& facets : tileFacets) {
+        for (const auto& f : facets) {
+            Facet key = f;
+            std::sort(key.begin(), key.end());
+            if (key[0] != key[1] && key[1] != key[2]) keyed.emplace_back(key, f);
+        }
+        std::vector<Facet>().swap(facets);
+    }
+    std::sort(keyed.begin(), keyed.end(), [](const auto& l, const auto& r){ return l.first < r.first; });
+    keyed.erase(std::unique(keyed.begin(), keyed.end(), [](const auto& l, const auto& r){ return l.first == r.first; }), keyed.end());
+    const std::size_t duplicates = total - keyed.size();
+    if (keyed.empty()) {
+        std::cerr << "Error: Tiled advancing front produced no facets." << std::endl;
+        return false;
+    }
+
+    // Compact to the referenced points
+    std::vector<std::size_t> remap(m_pointCloud.size(), std::numeric_limits<std::size_t>::max());
+    std::vector<Point> points;
+    std::vector<Facet> triangles;
+    triangles.reserve(keyed.size());
+    for (const auto& kf : keyed) {
+        Facet tri {};
+        for (int k = 0; k < 3; ++k) {
+            auto& r = remap[kf.second[k]];
+            if (r == std::numeric_limits<std::size_t>::max()) { r = points.size(); points.push_back(m_pointCloud[kf.second[k]].first); }
+            tri[k] = r;
         }
+        triangles.push_back(tri);
     }
+    std::vector<std::pair<Facet, Facet>>().swap(keyed);
+
+    if (!meshFromSoup(points, triangles)) return false;
+    const std::size_t stitched = PMP::stitch_borders(m_mesh);
+
+    // Close the small gaps left where neighbouring cells triangulated the seam differently
+    std::size_t filled = 0;
+    if (af.seam_hole_max_edges > 0) {
+        std::vector<Mesh::Halfedge_index> borders;
+        for (Mesh::Halfedge_index h : halfedges(m_mesh)) {
+            if (CGAL::is_border(h, m_mesh)) borders.push_back(h);
+        }
+        for (Mesh::Halfedge_index h : borders) {
+            if (!CGAL::is_border(h, m_mesh)) continue; // filled through another halfedge of the same cycle
+            int count = 0;
+            bool seam = false;
+            Mesh::Halfedge_index cur = h;
+            do {
+                if (!seam && grid.nearSeam(m_mesh.point(m_mesh.target(cur)), grid.margin)) seam = true;
+                cur = m_mesh.next(cur);
+                ++count;
+            } while (cur != h && count <= af.seam_hole_max_edges);
+            if (cur == h && seam) {
+                PMP::triangulate_hole(m_mesh, h);
+                ++filled;
+            }
+        }
+    }
+
+    std::ostringstream msg;
+    msg << "Tiled advancing front: " << tileCount << " cells, " << duplicates << " duplicate facets removed, "
+        << stitched << " border edges stitched, " << filled << " seam holes filled, "
+        << m_mesh.number_of_faces() << " faces.";
+    m_messages.push_back(msg.str());
     return !m_mesh.is_empty();
 }
 
-// Helper implementations (normals)
-bool CGALPointCloudProcessor::estimateNormalsJet() {
-    const int k_neighbors = 24;
-    CGAL::jet_estimate_normals<CGAL::Sequential_tag>(m_pointCloud, k_neighbors,
-                                                     CGAL::parameters::point_map(CGAL::First_of_pair_property_map<PointWithNormal>())
-                                                         .normal_map(CGAL::Second_of_pair_property_map<PointWithNormal>()));
+bool CGALPointCloudProcessor::processScreenedPoissonWithParams(const ScreenedPoissonReconstructionParameter* sp) {
+    const ScreenedPoissonReconstructionParameter defaults;
+    const auto& opt = sp ? *sp : defaults;
+    ScreenedPoisson::Options options;
+    options.depth = opt.depth;
+    options.coarseDepth = opt.coarse_depth;
+    options.pointWeight = opt.point_weight;
+    options.maxIterations = std::max(1, opt.max_iterations);
+    options.tolerance = opt.tolerance;
+
+    std::vector<Point> points;
+    std::vector<std::array<std::size_t,3>> triangles;
+    ScreenedPoisson::Stats stats;
+    if (!ScreenedPoisson::reconstruct(m_pointCloud, options, points, triangles, &stats)) {
+        m_mesh.clear();
+        std::cerr << "Error: Screened Poisson produced no surface (are the normals oriented?)." << std::endl;
+        return false;
+    }
 
-    CGAL::mst_orient_normals(m_pointCloud, k_neighbors,
-                             CGAL::parameters::point_map(CGAL::First_of_pair_property_map<PointWithNormal>())
-                                 .normal_map(CGAL::Second_of_pair_property_map<PointWithNormal>()));
-    return true;
+    std::ostringstream msg;
+    msg << "Screened Poisson: " << stats.levels << " levels, " << stats.nodes << " nodes on the finest level, "
+        << stats.iterations << " CG iterations, residual " << stats.residual << ", iso " << stats.iso << ".";
+    m_messages.push_back(msg.str());
+    return meshFromSoup(points, triangles);
 }
 
-bool CGALPointCloudProcessor::estimateNormalsUniformVolumeCentroid() {
-    using Traits = CGAL::Search_traits_3<K>;
-    using KnnSearch = CGAL::Orthogonal_k_neighbor_search<Traits>;
-    using Tree = KnnSearch::Tree;
-
-    std::vector<Point> pts;
-    pts.reserve(m_pointCloud.size());
-    for (const auto& pn : m_pointCloud) pts.push_back(pn.first);
-    Tree tree(pts.begin(), pts.end());
+bool CGALPointCloudProcessor::processVoxelWithParams(const VoxelReconstructionParameter* vx) {
+    const VoxelReconstructionParameter defaults;
+    const auto& opt = vx ? *vx : defaults;
+    VoxelReconstruction::Options options;
+    options.voxelSize = opt.voxel_size;
+    options.spacingScale = opt.spacing_scale;
+    options.minPointsPerVoxel = opt.min_points_per_voxel;
+    options.closeIterations = opt.close_iterations;
+    options.smoothingPasses = opt.smoothing_passes;
+
+    std::vector<Point> points;
+    std::vector<std::array<std::size_t,3>> triangles;
+    VoxelReconstruction::Stats stats;
+    if (!VoxelReconstruction::reconstruct(m_pointCloud, options, points, triangles, &stats)) {
+        m_mesh.clear();
+        std::cerr << "Error: Voxel reconstruction produced no surface." << std::endl;
+        return false;
+    }
 
-    const int k_neighbors = 24;
-    auto nmap = CGAL::Second_of_pair_property_map<PointWithNormal>();
+    std::ostringstream msg;
+    msg << "Voxel reconstruction: voxel size " << stats.voxelSize << ", " << stats.resolution << " voxels along the longest axis, "
+        << stats.occupiedVoxels << " occupied, " << stats.nodes << " stored.";
+    m_messages.push_back(msg.str());
+    return meshFromSoup(points, triangles);
+}
 
-    for (std::size_t i = 0; i < pts.size(); ++i) {
-        const Point& query = pts[i];
-        int k = std::min<int>(k_neighbors + 1, static_cast<int>(pts.size()));
-        KnnSearch search(tree, query, k);
+// Helper implementations (normals); orientation is applied by the caller
+bool CGALPointCloudProcessor::estimateNormalsJet(const NormalEstimationParameter& p, const NormalSubset* subset) {
+    if (subset) {
+        // jet_estimate_normals only searches the range it estimates, so the subset is fitted here with the
+        // same degree-2 Monge jet on neighborhoods taken from the whole cloud
+        using Monge = CGAL::Monge_via_jet_fitting<K>;
+        constexpr std::size_t kMinPoints = 6; // coefficients of a degree-2 jet
+        const auto& indices = subset->indices;
+        Parallel::forChunks(indices.size(), [&](std::size_t, std::size_t b, std::size_t e) {
+            std::vector<NeighborSearch::Neighbor> found;
+            std::vector<Point> neighborhood;
+            for (std::size_t t = b; t < e; ++t) {
+                const std::size_t i = indices[t];
+                gatherNeighborhood(subset->tree, m_pointCloud[i].first, p, found);
+                if (found.size() < kMinPoints) { m_pointCloud[i].second = CGAL::NULL_VECTOR; continue; }
+                neighborhood.clear();
+                for (const auto& nb : found) neighborhood.push_back(m_pointCloud[nb.index].first);
+                const auto form = Monge()(neighborhood.begin(), neighborhood.end(), 2, 2);
+                m_pointCloud[i].second = form.normal_direction();
+            }
+        }, 256);
+        return true;
+    }
 
-        K::FT cx = 0, cy = 0, cz = 0;
-        int count = 0;
-        for (const auto& res : search) {
-            if (res.second == 0) continue; // skip self
-            const Point& p = res.first;
-            cx += p.x(); cy += p.y(); cz += p.z();
-            ++count;
-        }
+    const auto np = CGAL::parameters::point_map(CGAL::First_of_pair_property_map<PointWithNormal>())
+                        .normal_map(CGAL::Second_of_pair_property_map<PointWithNormal>());
+    if (p.radius > 0.0) {
+        // With a radius, CGAL uses k only as a cap on the neighborhood size (0 = no cap)
+        CGAL::jet_estimate_normals<CGAL::Parallel_if_available_tag>(m_pointCloud, static_cast<unsigned int>(p.max_neighbors),
+                                                                     np.neighbor_radius(p.radius));
+    } else {
+        CGAL::jet_estimate_normals<CGAL::Parallel_if_available_tag>(m_pointCloud, static_cast<unsigned int>(p.neighbors_number), np);
+    }
+    return true;
+}
 
-        if (count == 0) {
-            put(nmap, m_pointCloud[i], CGAL::NULL_VECTOR);
-            continue;
-        }
+bool CGALPointCloudProcessor::estimateNormalsUniformVolumeCentroid(const NormalEstimationParameter& p, const NormalSubset* subset) {
+    // Without a subset every point is estimated, in tree order
+    std::optional<NeighborSearch::KdTree> ownTree;
+    if (!subset) ownTree.emplace(m_pointCloud);
+    const NeighborSearch::KdTree& tree = subset ? subset->tree : *ownTree;
+    const std::size_t count = subset ? subset->indices.size() : m_pointCloud.size();
+
+    Parallel::forChunks(count, [&](std::size_t, std::size_t b, std::size_t e) {
+        std::vector<NeighborSearch::Neighbor> found;
+        for (std::size_t t = b; t < e; ++t) {
+            const std::size_t i = subset ? subset->indices[t] : tree.order()[t];
+            const Point& query = m_pointCloud[i].first;
+            // k nearest, or the capped radius neighborhood, not counting the point itself
+            gatherNeighborhood(tree, query, p, found, i);
+
+            double cx = 0, cy = 0, cz = 0;
+            int n = 0;
+            for (const auto& nb : found) {
+                if (nb.squaredDistance == 0.0) continue; // duplicates of the query carry no direction
+                const Point& q = m_pointCloud[nb.index].first;
+                cx += q.x(); cy += q.y(); cz += q.z();
+                ++n;
+            }
+            if (n == 0) {
+                m_pointCloud[i].second = CGAL::NULL_VECTOR;
+                continue;
+            }
 
-        const Point centroid(cx / count, cy / count, cz / count);
-        Vector v = Vector(centroid, query);
-        const auto s = v.squared_length();
-        if (s <= static_cast<K::FT>(1e-16)) {
-            put(nmap, m_pointCloud[i], CGAL::NULL_VECTOR);
-        } else {
-            const double len = std::sqrt(CGAL::to_double(s));
-            put(nmap, m_pointCloud[i], v / len);
+            const Point centroid(cx / n, cy / n, cz / n);
+            const Vector v = Vector(centroid, query);
+            const double s = CGAL::to_double(v.squared_length());
+            m_pointCloud[i].second = s <= 1e-16 ? CGAL::NULL_VECTOR : v / std::sqrt(s);
         }
-    }
-
-    CGAL::mst_orient_normals(m_pointCloud, k_neighbors,
-                             CGAL::parameters::point_map(CGAL::First_of_pair_property_map<PointWithNormal>())
-                                 .normal_map(CGAL::Second_of_pair_property_map<PointWithNormal>()));
+    }, 1024);
     return true;
 }
 
-bool CGALPointCloudProcessor::estimateNormalsVCM() {
-    const double spacing = CGAL::compute_average_spacing<CGAL::Sequential_tag>(
-        m_pointCloud, 6,
-        CGAL::parameters::point_map(CGAL::First_of_pair_property_map<PointWithNormal>())
-    );
-    const double neighbor_radius = 2.0 * spacing;
-    const double convolution_radius = 4.0 * spacing;
+bool CGALPointCloudProcessor::estimateNormalsVCM(const NormalEstimationParameter& p, const NormalSubset* subset) {
+    double offset_radius = p.vcm_offset_radius;
+    double convolution_radius = p.vcm_convolution_radius;
+    if (!(offset_radius > 0.0) || !(convolution_radius > 0.0)) {
+        const double spacing = CGAL::compute_average_spacing<CGAL::Parallel_if_available_tag>(
+            m_pointCloud, 6,
+            CGAL::parameters::point_map(CGAL::First_of_pair_property_map<PointWithNormal>())
+        );
+        if (!(offset_radius > 0.0)) offset_radius = 2.0 * spacing;
+        if (!(convolution_radius > 0.0)) convolution_radius = 4.0 * spacing;
+    }
 
+    // The covariance measure is convolved over the whole cloud and has no per-point form, so a subset is
+    // estimated on a copy and only its normals are written back
+    PointCloud scratch;
+    if (subset) scratch = m_pointCloud;
     CGAL::vcm_estimate_normals(
-        m_pointCloud,
-        neighbor_radius,
+        subset ? scratch : m_pointCloud,
+        offset_radius,
         convolution_radius,
         CGAL::parameters::point_map(CGAL::First_of_pair_property_map<PointWithNormal>())
             .normal_map(CGAL::Second_of_pair_property_map<PointWithNormal>())
     );
+    if (subset) {
+        for (auto i : subset->indices) m_pointCloud[i].second = scratch[i].second;
+    }
 
-    const int k_neighbors = 24;
-    CGAL::mst_orient_normals(m_pointCloud, k_neighbors,
-                             CGAL::parameters::point_map(CGAL::First_of_pair_property_map<PointWithNormal>())
-                                 .normal_map(CGAL::Second_of_pair_property_map<PointWithNormal>()));
+    std::ostringstream msg;
+    msg << "VCM radii: offset " << offset_radius << ", convolution " << convolution_radius << ".";
+    if (subset) msg << " VCM has no local form: the whole cloud was processed to fill the missing normals.";
+    m_messages.push_back(msg.str());
+    return true;
+}
+
+bool CGALPointCloudProcessor::estimateNormalsPCA(const NormalEstimationParameter& p, const NormalSubset* subset) {
+    PcaNormals::Options options;
+    options.neighbors = p.neighbors_number;
+    options.radius = p.radius;
+    options.maxNeighbors = p.max_neighbors;
+    PcaNormals::Stats stats;
+    const bool ok = subset ? PcaNormals::estimate(m_pointCloud, subset->tree, subset->indices, options, &stats)
+                           : PcaNormals::estimate(m_pointCloud, options, &stats);
+    if (!ok) {
+        std::cerr << "Error: PCA normal estimation failed." << std::endl;
+        return false;
+    }
+
+    std::ostringstream msg;
+    msg << "PCA normals: " << stats.meanNeighbors << " neighbors per point on average";
+    if (stats.degenerate > 0) msg << ", " << stats.degenerate << " points with fewer than 3 neighbors left without a normal";
+    msg << ".";
+    m_messages.push_back(msg.str());
+    return true;
+}
+
+bool CGALPointCloudProcessor::orientNormals(NormalOrientationMethod method, int k_neighbors) {
+    NormalOrientation::Stats stats;
+    std::ostringstream msg;
+    switch (method) {
+        case NormalOrientationMethod::MST_CGAL: {
+            const auto unoriented = CGAL::mst_orient_normals(m_pointCloud, k_neighbors,
+                                                             CGAL::parameters::point_map(CGAL::First_of_pair_property_map<PointWithNormal>())
+                                                                 .normal_map(CGAL::Second_of_pair_property_map<PointWithNormal>()));
+            msg << "Normal orientation (CGAL MST, k=" << k_neighbors << "): "
+                << std::distance(unoriented, m_pointCloud.end()) << " points could not be oriented.";
+            break;
+        }
+        case NormalOrientationMethod::PARALLEL_MST:
+            if (!NormalOrientation::orientParallelMst(m_pointCloud, static_cast<std::size_t>(k_neighbors), &stats)) {
+                std::cerr << "Error: Parallel MST orientation failed (too few points or graph too large)." << std::endl;
+                return false;
+            }
+            msg << "Normal orientation (parallel MST, k=" << k_neighbors << "): " << stats.edges << " graph edges, "
+                << stats.rounds << " Boruvka rounds, " << stats.components << " component(s), " << stats.flipped << " normals flipped.";
+            break;
+        case NormalOrientationMethod::CENTROID_SIGN:
+            NormalOrientation::orientCentroidSign(m_pointCloud, &stats);
+            msg << "Normal orientation (centroid sign): " << stats.flipped << " normals flipped.";
+            break;
+        default:
+            std::cerr << "Error: Unsupported normal orientation method." << std::endl;
+            return false;
+    }
+    m_messages.push_back(msg.str());
     return true;
 }
 
 // New: point cloud utilities
-bool CGALPointCloudProcessor::downsampleVoxel(double cell_size) {
+bool CGALPointCloudProcessor::downsampleVoxel(double cell_size, int representative, std::uint64_t seed) {
     if (m_pointCloud.empty()) { std::cerr << "Error: No point cloud loaded." << std::endl; return false; }
     if (!(cell_size > 0.0)) { std::cerr << "Error: cell_size must be > 0." << std::endl; return false; }
+    if (representative < 0 || representative > static_cast<int>(VoxelDownsample::Representative::ClosestToCenter)) {
+        std::cerr << "Error: Unknown voxel representative " << representative << "." << std::endl;
+        return false;
+    }
 
-    const std::size_t before = m_pointCloud.size();
-    auto end = CGAL::grid_simplify_point_set(m_pointCloud,
-                                             cell_size,
-                                             CGAL::parameters::point_map(CGAL::First_of_pair_property_map<PointWithNormal>()));
-    m_pointCloud.erase(end, m_pointCloud.end());
-
-    return m_pointCloud.size() <= before; // true even if unchanged
+    VoxelDownsample::Options options;
+    options.cellSize = cell_size;
+    options.representative = static_cast<VoxelDownsample::Representative>(representative);
+    options.seed = seed;
+    VoxelDownsample::Stats stats;
+    if (!VoxelDownsample::downsample(m_pointCloud, options, &stats)) {
+        std::cerr << "Error: cell_size is too small for the extent of the point cloud (more than 2^21 cells per axis)." << std::endl;
+        return false;
+    }
+    markPointCloudChanged();
+    rebuildNormalMask(); // output is in cell order, with averaged normals for centroids
+
+    static const char* const names[] = {"centroid", "first", "random", "closest to center"};
+    std::ostringstream msg;
+    msg << "Voxel downsampling: " << stats.cells << " occupied cells of size " << cell_size << ", " << names[representative]
+        << " kept per cell (" << stats.sortPasses << " radix passes).";
+    m_messages.push_back(msg.str());
+    return true;
 }
 
 bool CGALPointCloudProcessor::downsampleVoxel(const BaseInputParameter* params) {
     if (m_pointCloud.empty()) { std::cerr << "Error: No point cloud loaded." << std::endl; return false; }
     const auto* p = params ? dynamic_cast<const VoxelDownsampleParameter*>(params) : nullptr;
     if (!p) { std::cerr << "Error: VoxelDownsampleParameter expected." << std::endl; return false; }
-    const double cell_size = p->cell_size;
-    if (!(cell_size > 0.0)) { std::cerr << "Error: cell_size must be > 0." << std::endl; return false; }
+    return downsampleVoxel(p->cell_size, p->representative, static_cast<std::uint64_t>(p->seed));
+}
+
+bool CGALPointCloudProcessor::resamplePointSet(PointSetResamplingMethod method, const BaseInputParameter* params) {
+    if (m_pointCloud.empty()) { std::cerr << "Error: No point cloud loaded." << std::endl; return false; }
+    switch (method) {
+        case PointSetResamplingMethod::HIERARCHY_SIMPLIFY: {
+            const auto* p = params ? dynamic_cast<const HierarchySimplifyParameter*>(params) : nullptr;
+            if (!p) { std::cerr << "Error: HierarchySimplifyParameter expected." << std::endl; return false; }
+            return simplifyHierarchy(*p);
+        }
+        case PointSetResamplingMethod::WLOP_SIMPLIFY: {
+            const auto* p = params ? dynamic_cast<const WLOPSimplifyParameter*>(params) : nullptr;
+            if (!p) { std::cerr << "Error: WLOPSimplifyParameter expected." << std::endl; return false; }
+            return simplifyWLOP(*p);
+        }
+        case PointSetResamplingMethod::BILATERAL_SMOOTHING: {
+            const auto* p = params ? dynamic_cast<const BilateralSmoothingParameter*>(params) : nullptr;
+            if (!p) { std::cerr << "Error: BilateralSmoothingParameter expected." << std::endl; return false; }
+            return smoothBilateral(*p);
+        }
+        default:
+            std::cerr << "Error: Unknown point set resampling method." << std::endl;
+            return false;
+    }
+}
+
+bool CGALPointCloudProcessor::simplifyHierarchy(const HierarchySimplifyParameter& p) {
+    if (p.max_cluster_size < 1) { std::cerr << "Error: max_cluster_size must be >= 1." << std::endl; return false; }
+    if (!(p.max_surface_variation >= 0.0)) { std::cerr << "Error: max_surface_variation must be >= 0." << std::endl; return false; }
 
+    // Reorders the range and moves the removed points to the back; normals travel with their points
     const std::size_t before = m_pointCloud.size();
-    auto end = CGAL::grid_simplify_point_set(m_pointCloud,
-                                             cell_size,
-                                             CGAL::parameters::point_map(CGAL::First_of_pair_property_map<PointWithNormal>()));
-    m_pointCloud.erase(end, m_pointCloud.end());
+    const auto firstRemoved = CGAL::hierarchy_simplify_point_set(
+        m_pointCloud, CGAL::parameters::point_map(CGAL::First_of_pair_property_map<PointWithNormal>())
+                          .size(static_cast<unsigned int>(p.max_cluster_size))
+                          .maximum_variation(p.max_surface_variation));
+    m_pointCloud.erase(firstRemoved, m_pointCloud.end());
+    m_pointCloud.shrink_to_fit();
+    markPointCloudChanged();
+    rebuildNormalMask();
+
+    std::ostringstream msg;
+    msg << "Hierarchy simplification: kept " << m_pointCloud.size() << " of " << before << " points (cluster size <= "
+        << p.max_cluster_size << ", variation <= " << p.max_surface_variation << ").";
+    m_messages.push_back(msg.str());
+    return true;
+}
 
-    return m_pointCloud.size() <= before;
+bool CGALPointCloudProcessor::simplifyWLOP(const WLOPSimplifyParameter& p) {
+    if (!(p.select_percentage > 0.0 && p.select_percentage <= 100.0)) {
+        std::cerr << "Error: select_percentage must be in (0, 100]." << std::endl;
+        return false;
+    }
+    if (!(p.neighbor_radius >= 0.0)) { std::cerr << "Error: neighbor_radius must be >= 0 (0 = automatic)." << std::endl; return false; }
+    if (p.iterations < 1) { std::cerr << "Error: iterations must be >= 1." << std::endl; return false; }
+
+    const auto np = CGAL::parameters::point_map(CGAL::First_of_pair_property_map<PointWithNormal>())
+                        .select_percentage(p.select_percentage)
+                        .number_of_iterations(static_cast<unsigned int>(p.iterations))
+                        .require_uniform_sampling(p.require_uniform_sampling);
+    std::vector<Point> projected;
+    if (p.neighbor_radius > 0.0) {
+        CGAL::wlop_simplify_and_regularize_point_set<CGAL::Parallel_if_available_tag>(
+            m_pointCloud, std::back_inserter(projected), np.neighbor_radius(p.neighbor_radius));
+    } else {
+        CGAL::wlop_simplify_and_regularize_point_set<CGAL::Parallel_if_available_tag>(m_pointCloud, std::back_inserter(projected), np);
+    }
+    if (projected.empty()) { std::cerr << "Error: WLOP produced no points." << std::endl; return false; }
+
+    // WLOP outputs positions only; each new point takes the normal of its nearest input point
+    // (missing stays missing), which keeps an existing orientation for reconstruction
+    const std::size_t before = m_pointCloud.size();
+    const NeighborSearch::KdTree tree(m_pointCloud);
+    PointCloud resampled(projected.size());
+    Parallel::forChunks(projected.size(), [&](std::size_t, std::size_t b, std::size_t e) {
+        std::vector<NeighborSearch::Neighbor> found;
+        for (std::size_t i = b; i < e; ++i) {
+            const Point& q = projected[i];
+            tree.nearest({q.x(), q.y(), q.z()}, 1, found);
+            resampled[i] = {q, found.empty() ? CGAL::NULL_VECTOR : m_pointCloud[found.front().index].second};
+        }
+    }, 1024);
+    m_pointCloud.swap(resampled);
+    markPointCloudChanged();
+    rebuildNormalMask();
+
+    std::ostringstream msg;
+    msg << "WLOP simplification: " << m_pointCloud.size() << " of " << before << " points after " << p.iterations
+        << " iterations; normals copied from the nearest input point.";
+    m_messages.push_back(msg.str());
+    return true;
+}
+
+bool CGALPointCloudProcessor::smoothBilateral(const BilateralSmoothingParameter& p) {
+    if (p.neighbors_number < 1 && !(p.neighbor_radius > 0.0)) {
+        std::cerr << "Error: neighbors_number must be >= 1 when no radius is given." << std::endl;
+        return false;
+    }
+    if (!(p.neighbor_radius >= 0.0)) { std::cerr << "Error: neighbor_radius must be >= 0." << std::endl; return false; }
+    if (!(p.sharpness_angle > 0.0 && p.sharpness_angle < 90.0)) { std::cerr << "Error: sharpness_angle must be in (0, 90)." << std::endl; return false; }
+    if (p.iterations < 1) { std::cerr << "Error: iterations must be >= 1." << std::endl; return false; }
+    if (m_missingNormals > 0) {
+        std::cerr << "Error: Bilateral smoothing needs a normal on every point (" << m_missingNormals
+                  << " missing); estimate normals first." << std::endl;
+        return false;
+    }
+
+    const auto np = CGAL::parameters::point_map(CGAL::First_of_pair_property_map<PointWithNormal>())
+                        .normal_map(CGAL::Second_of_pair_property_map<PointWithNormal>())
+                        .sharpness_angle(p.sharpness_angle);
+    const auto k = static_cast<unsigned int>(std::max(p.neighbors_number, 0));
+    std::ostringstream msg;
+    msg << "Bilateral smoothing: mean displacement per pass";
+    for (int it = 0; it < p.iterations; ++it) {
+        const double displacement = p.neighbor_radius > 0.0
+            ? CGAL::bilateral_smooth_point_set<CGAL::Parallel_if_available_tag>(m_pointCloud, k, np.neighbor_radius(p.neighbor_radius))
+            : CGAL::bilateral_smooth_point_set<CGAL::Parallel_if_available_tag>(m_pointCloud, k, np);
+        msg << (it == 0 ? " " : ", ") << displacement;
+    }
+    markPointCloudChanged();
+    rebuildNormalMask(); // the normals are smoothed as well
+    msg << ".";
+    m_messages.push_back(msg.str());
+    return true;
 }
 
 bool CGALPointCloudProcessor::filterAABB(const BaseInputParameter* params) {
@@ -392,26 +1306,15 @@ bool CGALPointCloudProcessor::filterAABB(const BaseInputParameter* params) {
     const auto* aabb = params ? dynamic_cast<const AABBFilterParameter*>(params) : nullptr;
     if (!aabb) { std::cerr << "Error: AABBFilterParameter expected." << std::endl; return false; }
 
-    const double min_x = aabb->min_x, min_y = aabb->min_y, min_z = aabb->min_z;
-    const double max_x = aabb->max_x, max_y = aabb->max_y, max_z = aabb->max_z;
-    const bool keepInside = aabb->keepInside;
-
-    if (!(min_x <= max_x && min_y <= max_y && min_z <= max_z)) {
+    if (!(aabb->min_x <= aabb->max_x && aabb->min_y <= aabb->max_y && aabb->min_z <= aabb->max_z)) {
         std::cerr << "Error: Invalid AABB extents." << std::endl; return false;
     }
-    auto inside = [&](const Point& p) {
-        return p.x() >= min_x && p.x() <= max_x &&
-               p.y() >= min_y && p.y() <= max_y &&
-               p.z() >= min_z && p.z() <= max_z;
-    };
-
-    const std::size_t before = m_pointCloud.size();
-    m_pointCloud.erase(std::remove_if(m_pointCloud.begin(), m_pointCloud.end(), [&](const PointWithNormal& pn){
-        const bool in = inside(pn.first);
-        return keepInside ? !in : in;
-    }), m_pointCloud.end());
 
-    return m_pointCloud.size() <= before;
+    const auto slabs = CropKernels::boxSlabs({aabb->min_x, aabb->min_y, aabb->min_z}, {aabb->max_x, aabb->max_y, aabb->max_z});
+    std::vector<char> keep;
+    CropKernels::classify(m_pointCloud, slabs.data(), slabs.size(), aabb->keepInside, keep);
+    keepPoints(keep);
+    return true;
 }
 
 bool CGALPointCloudProcessor::filterSphere(const BaseInputParameter* params) {
@@ -419,23 +1322,69 @@ bool CGALPointCloudProcessor::filterSphere(const BaseInputParameter* params) {
     const auto* s = params ? dynamic_cast<const SphereFilterParameter*>(params) : nullptr;
     if (!s) { std::cerr << "Error: SphereFilterParameter expected." << std::endl; return false; }
 
-    const double cx = s->cx, cy = s->cy, cz = s->cz, radius = s->radius;
-    const bool keepInside = s->keepInside;
+    if (!(s->radius > 0.0)) { std::cerr << "Error: radius must be > 0." << std::endl; return false; }
 
-    if (!(radius > 0.0)) { std::cerr << "Error: radius must be > 0." << std::endl; return false; }
-    const double r2 = radius * radius;
+    std::vector<char> keep;
+    CropKernels::classifySphere(m_pointCloud, {s->cx, s->cy, s->cz}, s->radius, s->keepInside, keep);
+    keepPoints(keep);
+    return true;
+}
 
-    const std::size_t before = m_pointCloud.size();
-    m_pointCloud.erase(std::remove_if(m_pointCloud.begin(), m_pointCloud.end(), [&](const PointWithNormal& pn){
-        const auto dx = CGAL::to_double(pn.first.x()) - cx;
-        const auto dy = CGAL::to_double(pn.first.y()) - cy;
-        const auto dz = CGAL::to_double(pn.first.z()) - cz;
-        const double d2 = dx*dx + dy*dy + dz*dz;
-        const bool in = d2 <= r2;
-        return keepInside ? !in : in;
-    }), m_pointCloud.end());
+bool CGALPointCloudProcessor::filterOrientedBox(const BaseInputParameter* params) {
+    if (m_pointCloud.empty()) { std::cerr << "Error: No point cloud loaded." << std::endl; return false; }
+    const auto* box = params ? dynamic_cast<const OrientedBoxFilterParameter*>(params) : nullptr;
+    if (!box) { std::cerr << "Error: OrientedBoxFilterParameter expected." << std::endl; return false; }
+    if (!(box->hx >= 0.0 && box->hy >= 0.0 && box->hz >= 0.0)) {
+        std::cerr << "Error: Half extents must be >= 0." << std::endl; return false;
+    }
 
-    return m_pointCloud.size() <= before;
+    // Box axes are the columns of R = Rz * Ry * Rx, the Euler convention of the split-plane docker
+    constexpr double kDegToRad = 3.14159265358979323846 / 180.0;
+    const double sx = std::sin(box->rx * kDegToRad), cx = std::cos(box->rx * kDegToRad);
+    const double sy = std::sin(box->ry * kDegToRad), cy = std::cos(box->ry * kDegToRad);
+    const double sz = std::sin(box->rz * kDegToRad), cz = std::cos(box->rz * kDegToRad);
+    const std::array<std::array<double, 3>, 3> axes {{
+        {cz * cy, sz * cy, -sy},
+        {cz * sy * sx - sz * cx, sz * sy * sx + cz * cx, cy * sx},
+        {cz * sy * cx + sz * sx, sz * sy * cx - cz * sx, cy * cx},
+    }};
+    const auto slabs = CropKernels::orientedBoxSlabs({box->cx, box->cy, box->cz}, axes, {box->hx, box->hy, box->hz});
+    std::vector<char> keep;
+    CropKernels::classify(m_pointCloud, slabs.data(), slabs.size(), box->keepInside, keep);
+    keepPoints(keep);
+    return true;
+}
+
+bool CGALPointCloudProcessor::filterHalfSpace(const BaseInputParameter* params) {
+    if (m_pointCloud.empty()) { std::cerr << "Error: No point cloud loaded." << std::endl; return false; }
+    const auto* plane = params ? dynamic_cast<const HalfSpaceFilterParameter*>(params) : nullptr;
+    if (!plane) { std::cerr << "Error: HalfSpaceFilterParameter expected." << std::endl; return false; }
+    if (!(plane->nx * plane->nx + plane->ny * plane->ny + plane->nz * plane->nz > 0.0)) {
+        std::cerr << "Error: Plane normal must be non-zero." << std::endl; return false;
+    }
+
+    const auto slab = CropKernels::halfSpace({plane->nx, plane->ny, plane->nz}, plane->d);
+    std::vector<char> keep;
+    CropKernels::classify(m_pointCloud, &slab, 1, plane->keepPositive, keep);
+    keepPoints(keep);
+    return true;
+}
+
+bool CGALPointCloudProcessor::filterByMask(const BaseInputParameter* params) {
+    if (m_pointCloud.empty()) { std::cerr << "Error: No point cloud loaded." << std::endl; return false; }
+    const auto* sel = params ? dynamic_cast<const SelectionMaskFilterParameter*>(params) : nullptr;
+    if (!sel) { std::cerr << "Error: SelectionMaskFilterParameter expected." << std::endl; return false; }
+    if (sel->mask.size() != m_pointCloud.size()) {
+        std::cerr << "Error: Selection mask size (" << sel->mask.size() << ") does not match point count ("
+                  << m_pointCloud.size() << "); the point cloud changed since the selection was made." << std::endl;
+        return false;
+    }
+
+    // The mask is indexed by the original position
+    std::vector<char> keep(m_pointCloud.size());
+    Parallel::forEach(keep.size(), [&](std::size_t i) { keep[i] = (sel->mask[i] != 0) == sel->keepSelected; });
+    keepPoints(keep);
+    return true;
 }
 
 bool CGALPointCloudProcessor::filterSurfaceFromUniformVolume(const BaseInputParameter* params) {
@@ -446,42 +1395,76 @@ bool CGALPointCloudProcessor::filterSurfaceFromUniformVolume(const BaseInputPara
     if (!(opt->radius_scale > 0.0)) { std::cerr << "Error: radius_scale must be > 0." << std::endl; return false; }
     if (!(opt->max_neighbors >= 0)) { std::cerr << "Error: max_neighbors must be >= 0." << std::endl; return false; }
 
-    // Estimate average spacing for scale
-    const double spacing = CGAL::compute_average_spacing<CGAL::Sequential_tag>(
-        m_pointCloud, opt->neighbors_number,
-        CGAL::parameters::point_map(CGAL::First_of_pair_property_map<PointWithNormal>())
-    );
+    // One tree for the spacing estimate and the neighbor counts; the spacing is a mean, so a sample does
+    constexpr std::size_t kSpacingSamples = 100000;
+    const NeighborSearch::KdTree tree(m_pointCloud);
+    const double spacing = NeighborSearch::averageSpacing(m_pointCloud, tree, static_cast<std::size_t>(opt->neighbors_number),
+                                                          kSpacingSamples);
     const double radius = spacing * opt->radius_scale;
 
-    using Traits = CGAL::Search_traits_3<K>;
-    using Tree = CGAL::Kd_tree<Traits>;
-    using Fuzzy_sphere = CGAL::Fuzzy_sphere<Traits>;
+    // Counting stops at max_neighbors + 1, so interior points (the bulk of a volume sample) exit early
+    const std::size_t limit = static_cast<std::size_t>(opt->max_neighbors) + 1;
+    std::vector<char> keep(m_pointCloud.size(), 0);
+    Parallel::forChunks(m_pointCloud.size(), [&](std::size_t, std::size_t b, std::size_t e) {
+        for (std::size_t t = b; t < e; ++t) {
+            const std::size_t i = tree.order()[t];
+            const Point& p = m_pointCloud[i].first;
+            keep[i] = tree.countWithinRadius({p.x(), p.y(), p.z()}, radius, limit, i) < limit;
+        }
+    }, 1024);
 
-    std::vector<Point> pts; pts.reserve(m_pointCloud.size());
-    for (const auto& pn : m_pointCloud) pts.push_back(pn.first);
-    Tree tree(pts.begin(), pts.end());
+    const std::size_t before = m_pointCloud.size();
+    const std::size_t w = keepPoints(keep);
 
-    std::vector<char> keep(pts.size(), 0);
-    std::vector<Point> buffer; buffer.reserve(64);
-    for (std::size_t i = 0; i < pts.size(); ++i) {
-        buffer.clear();
-        Fuzzy_sphere region(pts[i], radius);
-        tree.search(std::back_inserter(buffer), region);
-        int count = static_cast<int>(buffer.size());
-        // Remove self if included (Kd_tree may return the query point depending on implementation)
-        // Conservatively subtract 1 when radius > 0 and there is at least one result.
-        if (count > 0) --count;
-        if (count <= opt->max_neighbors) keep[i] = 1;
-    }
+    std::ostringstream msg;
+    msg << "Surface filter: radius " << radius << " (" << opt->radius_scale << " x spacing " << spacing << "), kept "
+        << w << " of " << before << " points.";
+    m_messages.push_back(msg.str());
+    return m_pointCloud.size() <= before;
+}
+
+bool CGALPointCloudProcessor::removeOutliers(const BaseInputParameter* params) {
+    if (m_pointCloud.empty()) { std::cerr << "Error: No point cloud loaded." << std::endl; return false; }
+    const auto* opt = params ? dynamic_cast<const OutlierRemovalParameter*>(params) : nullptr;
+    if (!opt) { std::cerr << "Error: OutlierRemovalParameter expected." << std::endl; return false; }
+    if (opt->method != 0 && opt->method != 1) { std::cerr << "Error: method must be 0 (statistical) or 1 (radius count)." << std::endl; return false; }
+    if (!(opt->neighbors_number > 0)) { std::cerr << "Error: neighbors_number must be > 0." << std::endl; return false; }
+    if (opt->method == 0 && !(opt->std_ratio >= 0.0)) { std::cerr << "Error: std_ratio must be >= 0." << std::endl; return false; }
+    if (opt->method == 1 && !(opt->radius >= 0.0)) { std::cerr << "Error: radius must be >= 0 (0 = auto)." << std::endl; return false; }
+    if (opt->method == 1 && !(opt->min_neighbors > 0)) { std::cerr << "Error: min_neighbors must be > 0." << std::endl; return false; }
 
     const std::size_t before = m_pointCloud.size();
-    std::size_t w = 0;
-    for (std::size_t i = 0; i < m_pointCloud.size(); ++i) {
-        if (keep[i]) m_pointCloud[w++] = m_pointCloud[i];
+    const NeighborSearch::KdTree tree(m_pointCloud);
+    const auto k = static_cast<std::size_t>(opt->neighbors_number);
+    std::ostringstream msg;
+    std::vector<char> keep;
+    if (opt->method == 0) {
+        OutlierRemoval::StatisticalStats stats;
+        keep = OutlierRemoval::statistical(m_pointCloud, tree, k, opt->std_ratio, &stats);
+        msg << "Statistical outlier removal: mean " << k << "-NN distance " << stats.meanDistance << ", sigma "
+            << stats.sigma << ", threshold " << stats.threshold;
+    } else {
+        constexpr std::size_t kSpacingSamples = 100000;
+        const double radius = opt->radius > 0.0 ? opt->radius
+                                                : NeighborSearch::averageSpacing(m_pointCloud, tree, k, kSpacingSamples);
+        keep = OutlierRemoval::radius(m_pointCloud, tree, radius, static_cast<std::size_t>(opt->min_neighbors));
+        msg << "Radius outlier removal: radius " << radius << (opt->radius > 0.0 ? "" : " (average spacing)")
+            << ", at least " << opt->min_neighbors << " neighbors";
     }
-    m_pointCloud.resize(w);
+    const std::size_t kept = keepPoints(keep);
+    msg << ", removed " << (before - kept) << " of " << before << " points.";
+    m_messages.push_back(msg.str());
+    return true;
+}
 
-    return m_pointCloud.size() <= before;
+std::size_t CGALPointCloudProcessor::keepPoints(const std::vector<char>& keep) {
+    const std::size_t before = m_pointCloud.size();
+    const std::size_t kept = CropKernels::compact(m_pointCloud, m_normalValid, keep);
+    if (kept != before) {
+        recountMissingNormals();
+        markPointCloudChanged();
+    }
+    return kept;
 }
 
 // New: mesh post-processing
@@ -490,96 +1473,321 @@ bool CGALPointCloudProcessor::postProcessMesh(const BaseInputParameter* params)
     const auto* options = params ? dynamic_cast<const MeshPostprocessParameter*>(params) : nullptr;
     if (!options) { std::cerr << "Error: MeshPostprocessParameter expected." << std::endl; return false; }
 
+    // Every stage reports its time and effect, or why it was skipped (its precondition checks are
+    // parallel and read-only, and much cheaper than the stage itself)
+    using Clock = std::chrono::steady_clock;
+    const auto total = Clock::now();
+    const auto report = [this](const char* stage, Clock::time_point start, const std::string& detail) {
+        std::ostringstream msg;
+        msg << "Post-process " << stage << ": " << detail << " (" << millisecondsSince(start) << " ms).";
+        m_messages.push_back(msg.str());
+    };
+    const auto faceChange = [this](std::size_t before) {
+        return std::to_string(before) + " -> " + std::to_string(m_mesh.number_of_faces()) + " faces";
+    };
+    const auto borderHalfedges = [this]() {
+        return countIf(m_mesh.halfedges(), [this](Mesh::Halfedge_index h) { return m_mesh.is_border(h); });
+    };
+
     // Optionally remove degenerate faces first to avoid issues downstream
     if (options->remove_degenerate_faces) {
-        PMP::remove_degenerate_faces(m_mesh);
+        const auto start = Clock::now();
+        const std::size_t before = m_mesh.number_of_faces();
+        const std::size_t degenerate =
+            countIf(m_mesh.faces(), [this](Mesh::Face_index f) { return PMP::is_degenerate_triangle_face(f, m_mesh); }) +
+            countIf(m_mesh.edges(), [this](Mesh::Edge_index e) { return PMP::is_degenerate_edge(e, m_mesh); });
+        if (degenerate == 0) {
+            report("degenerate removal", start, "skipped, no degenerate faces or edges");
+        } else {
+            PMP::remove_degenerate_faces(m_mesh);
+            report("degenerate removal", start, faceChange(before));
+        }
     }
 
     // Stitch borders (can help before hole filling and remeshing)
     if (options->stitch_borders) {
-        PMP::stitch_borders(m_mesh);
+        const auto start = Clock::now();
+        if (borderHalfedges() == 0) {
+            report("stitching", start, "skipped, mesh has no border");
+        } else {
+            const std::size_t stitched = PMP::stitch_borders(m_mesh);
+            report("stitching", start, std::to_string(stitched) + " halfedge pairs stitched");
+        }
     }
 
     // Keep only the largest (or top-N) connected components
     if (options->keep_largest_components > 0) {
-        std::size_t nb_cc = PMP::connected_components(m_mesh, m_mesh.add_property_map<Mesh::Face_index, std::size_t>("f:CC", 0).first);
-        (void)nb_cc; // not used further
-        if (options->keep_largest_components == 1) {
-            PMP::keep_largest_connected_components(m_mesh, 1);
+        const auto start = Clock::now();
+        const auto keep = static_cast<std::size_t>(options->keep_largest_components);
+        auto fcc = m_mesh.add_property_map<Mesh::Face_index, std::size_t>("f:CC", 0).first;
+        const std::size_t components = PMP::connected_components(m_mesh, fcc);
+        if (components <= keep) {
+            report("component filter", start, "skipped, " + std::to_string(components) + " component(s)");
         } else {
-            PMP::keep_largest_connected_components(m_mesh, static_cast<std::size_t>(options->keep_largest_components));
+            // Face count per component from per-chunk histograms, then drop all but the largest
+            const std::vector<Mesh::Face_index> faces(m_mesh.faces().begin(), m_mesh.faces().end());
+            std::vector<std::vector<std::size_t>> partial(Parallel::chunkCount(faces.size()));
+            Parallel::forChunks(faces.size(), [&](std::size_t c, std::size_t b, std::size_t e) {
+                partial[c].assign(components, 0);
+                for (std::size_t i = b; i < e; ++i) ++partial[c][fcc[faces[i]]];
+            });
+            std::vector<std::size_t> sizes(components, 0);
+            for (const auto& part : partial) {
+                for (std::size_t cc = 0; cc < part.size(); ++cc) sizes[cc] += part[cc];
+            }
+            std::vector<std::size_t> order(components);
+            for (std::size_t cc = 0; cc < components; ++cc) order[cc] = cc;
+            std::stable_sort(order.begin(), order.end(), [&](std::size_t l, std::size_t r) { return sizes[l] > sizes[r]; });
+            const std::vector<std::size_t> removed(order.begin() + static_cast<std::ptrdiff_t>(keep), order.end());
+            const std::size_t before = m_mesh.number_of_faces();
+            PMP::remove_connected_components(m_mesh, removed, fcc);
+            report("component filter", start, std::to_string(removed.size()) + " of " + std::to_string(components) +
+                                                  " components removed, " + faceChange(before));
         }
+        m_mesh.remove_property_map(fcc);
     }
 
     // Remove isolated vertices after possible face removals
     if (options->remove_isolated_vertices) {
-        PMP::remove_isolated_vertices(m_mesh);
+        const auto start = Clock::now();
+        if (countIf(m_mesh.vertices(), [this](Mesh::Vertex_index v) { return m_mesh.is_isolated(v); }) == 0) {
+            report("isolated vertex removal", start, "skipped, none isolated");
+        } else {
+            const std::size_t removed = PMP::remove_isolated_vertices(m_mesh);
+            report("isolated vertex removal", start, std::to_string(removed) + " vertices removed");
+        }
     }
 
-    // Fill small holes
+    // Fill small holes: border cycles within the size limits, triangulated in parallel
     if (options->fill_holes_max_cycle_edges > 0) {
-        // Iterate over a snapshot of border halfedges by scanning all halfedges
-        std::vector<Mesh::Halfedge_index> borders;
-        borders.reserve(num_halfedges(m_mesh));
-        for (Mesh::Halfedge_index h : halfedges(m_mesh)) {
-            if (CGAL::is_border(h, m_mesh)) borders.push_back(h);
-        }
-        for (Mesh::Halfedge_index h : borders) {
-            if (!CGAL::is_border(h, m_mesh)) continue; // may have been filled already
-            // Count border cycle length by walking next() around the hole
-            int count = 0;
-            Mesh::Halfedge_index cur = h;
-            const int max_check = options->fill_holes_max_cycle_edges;
-            do {
-                cur = m_mesh.next(cur);
-                ++count;
-                if (cur == Mesh::null_halfedge()) { count = max_check + 1; break; }
-            } while (cur != h && count <= max_check);
-
-            if (count <= max_check) {
-                PMP::triangulate_hole(m_mesh, h);
-            }
+        const auto start = Clock::now();
+        if (borderHalfedges() == 0) {
+            report("hole filling", start, "skipped, mesh has no border");
+        } else {
+            std::size_t pinched = 0;
+            const auto holes = borderCycles(m_mesh, static_cast<std::size_t>(options->fill_holes_max_cycle_edges),
+                                            options->fill_holes_max_diameter, &pinched);
+            const auto mode = static_cast<HoleFillMode>(std::clamp(options->fill_holes_mode, 0, 2));
+            const std::size_t before = m_mesh.number_of_faces();
+            const HoleFillStats stats = holes.empty() ? HoleFillStats {} : fillHoles(m_mesh, holes, mode);
+            std::string detail = std::to_string(stats.filled) + " of " + std::to_string(holes.size()) +
+                                 " small holes filled, " + faceChange(before);
+            if (stats.fallbacks > 0) detail += ", " + std::to_string(stats.fallbacks) + " via triangulate_hole";
+            if (stats.failed > 0) detail += ", " + std::to_string(stats.failed) + " failed";
+            if (pinched > 0) detail += ", " + std::to_string(pinched) + " pinched skipped";
+            if (mode != HoleFillMode::Triangulate) detail += ", " + std::to_string(stats.addedVertices) + " vertices added";
+            if (stats.fairingFailures > 0) detail += ", fairing failed on " + std::to_string(stats.fairingFailures);
+            report("hole filling", start, detail);
         }
     }
 
     // Isotropic remeshing
     if (options->remesh_iterations > 0) {
-        // Determine target edge length if not given
+        const auto start = Clock::now();
+        // Determine target edge length if not given: average edge length, summed per chunk
         double target = options->remesh_target_edge_length;
         if (!(target > 0.0)) {
-            // Approximate average edge length
-            double sum = 0.0; std::size_t cnt = 0;
-            for (auto e : m_mesh.edges()) {
-                const auto h = m_mesh.halfedge(e);
-                const auto& p0 = m_mesh.point(m_mesh.source(h));
-                const auto& p1 = m_mesh.point(m_mesh.target(h));
-                const double dx = CGAL::to_double(p0.x() - p1.x());
-                const double dy = CGAL::to_double(p0.y() - p1.y());
-                const double dz = CGAL::to_double(p0.z() - p1.z());
-                sum += std::sqrt(dx*dx + dy*dy + dz*dz);
-                ++cnt;
-            }
-            if (cnt > 0) target = sum / static_cast<double>(cnt);
+            const std::vector<Mesh::Edge_index> edges(m_mesh.edges().begin(), m_mesh.edges().end());
+            std::vector<double> partial(Parallel::chunkCount(edges.size()), 0.0);
+            Parallel::forChunks(edges.size(), [&](std::size_t c, std::size_t b, std::size_t e) {
+                for (std::size_t i = b; i < e; ++i) {
+                    const auto h = m_mesh.halfedge(edges[i]);
+                    partial[c] += std::sqrt(CGAL::squared_distance(m_mesh.point(m_mesh.source(h)), m_mesh.point(m_mesh.target(h))));
+                }
+            });
+            double sum = 0.0;
+            for (double v : partial) sum += v;
+            if (!edges.empty()) target = sum / static_cast<double>(edges.size());
             if (!(target > 0.0)) target = 1.0; // safe fallback
         }
+        const std::size_t before = m_mesh.number_of_faces();
         PMP::isotropic_remeshing(faces(m_mesh), target, m_mesh,
                                  PMP::parameters::number_of_iterations(options->remesh_iterations)
                                      .protect_constraints(false));
+        std::ostringstream detail;
+        detail << options->remesh_iterations << " iterations at edge length " << target << ", " << faceChange(before);
+        report("remeshing", start, detail.str());
     }
 
     // Smoothing
     if (options->smooth_iterations > 0) {
+        const auto start = Clock::now();
         PMP::angle_and_area_smoothing(
             m_mesh,
             PMP::parameters::number_of_iterations(options->smooth_iterations)
                 .use_angle_smoothing(true)
                 .use_area_smoothing(true)
         );
+        report("smoothing", start, std::to_string(options->smooth_iterations) + " iterations");
     }
 
     if (options->recompute_normals) {
-        computeMeshNormals();
+        const auto start = Clock::now();
+        if (m_mesh.is_empty()) {
+            report("normals", start, "skipped, mesh is empty");
+        } else {
+            computeMeshNormals();
+            report("normals", start, std::to_string(m_mesh.number_of_vertices()) + " vertex normals");
+        }
+    }
+
+    const auto done = Clock::now();
+    std::ostringstream msg;
+    msg << "Post-process total: " << std::chrono::duration<double, std::milli>(done - total).count() << " ms, "
+        << m_mesh.number_of_faces() << " faces.";
+    m_messages.push_back(msg.str());
+    return true;
+}
+
+bool CGALPointCloudProcessor::clipMesh(const BaseInputParameter* params) {
+    if (m_mesh.is_empty()) { std::cerr << "Error: Mesh is empty." << std::endl; return false; }
+    const auto* plane = params ? dynamic_cast<const HalfSpaceFilterParameter*>(params) : nullptr;
+    if (!plane) { std::cerr << "Error: HalfSpaceFilterParameter expected." << std::endl; return false; }
+    if (!(plane->nx * plane->nx + plane->ny * plane->ny + plane->nz * plane->nz > 0.0)) {
+        std::cerr << "Error: Plane normal must be non-zero." << std::endl; return false;
+    }
+
+    // Kept side is a·p + d >= 0
+    const double sign = plane->keepPositive ? 1.0 : -1.0;
+    const double a = sign * plane->nx, b = sign * plane->ny, c = sign * plane->nz, d = sign * plane->d;
+
+    // Parallel side test over the vertices; a mesh entirely on one side needs no cut
+    std::vector<Mesh::Vertex_index> vertices(m_mesh.vertices().begin(), m_mesh.vertices().end());
+    std::vector<std::size_t> removedPerChunk(Parallel::chunkCount(vertices.size()), 0);
+    Parallel::forChunks(vertices.size(), [&](std::size_t chunk, std::size_t begin, std::size_t end) {
+        std::size_t removed = 0;
+        for (std::size_t i = begin; i < end; ++i) {
+            const Point& p = m_mesh.point(vertices[i]);
+            removed += a * p.x() + b * p.y() + c * p.z() + d < 0.0;
+        }
+        removedPerChunk[chunk] = removed;
+    });
+    std::size_t removed = 0;
+    for (std::size_t r : removedPerChunk) removed += r;
+
+    const std::size_t facesBefore = m_mesh.number_of_faces();
+    std::ostringstream msg;
+    if (removed == 0) {
+        msg << "Mesh clip: all " << vertices.size() << " vertices are on the kept side; mesh unchanged.";
+        m_messages.push_back(msg.str());
+        return true;
+    }
+    if (removed == vertices.size()) {
+        m_mesh.clear();
+        msg << "Mesh clip: the whole mesh is on the removed side; removed " << facesBefore << " faces.";
+        m_messages.push_back(msg.str());
+        return true;
+    }
+
+    // PMP::clip keeps the negative side of its plane, so pass the flipped plane; open meshes are
+    // cut as surfaces (no cap)
+    try {
+        PMP::clip(m_mesh, K::Plane_3(-a, -b, -c, -d), PMP::parameters::clip_volume(false));
+    } catch (const std::exception& e) {
+        std::cerr << "Error clipping mesh: " << e.what() << std::endl;
+        return false;
     }
+    m_mesh.collect_garbage();
+    if (m_mesh.property_map<Mesh::Vertex_index, Vector>("v:normal")) computeMeshNormals(); // new vertices on the cut
 
+    msg << "Mesh clip: " << facesBefore << " -> " << m_mesh.number_of_faces() << " faces (" << removed << " of "
+        << vertices.size() << " vertices on the removed side).";
+    m_messages.push_back(msg.str());
     return true;
 }
+
+bool CGALPointCloudProcessor::decimateMesh(const BaseInputParameter* params) {
+    if (m_mesh.is_empty()) { std::cerr << "Error: Mesh is empty." << std::endl; return false; }
+    const auto* options = params ? dynamic_cast<const MeshDecimationParameter*>(params) : nullptr;
+    if (!options) { std::cerr << "Error: MeshDecimationParameter expected." << std::endl; return false; }
+    if (!CGAL::is_triangle_mesh(m_mesh)) { std::cerr << "Error: Decimation requires a triangle mesh." << std::endl; return false; }
+
+    const std::size_t facesBefore = m_mesh.number_of_faces();
+    std::size_t target = options->target_face_count > 0 ? static_cast<std::size_t>(options->target_face_count)
+                                                        : static_cast<std::size_t>(std::ceil(std::clamp(options->target_ratio, 0.0, 1.0) * double(facesBefore)));
+    target = std::max<std::size_t>(target, 4);
+    if (target >= facesBefore) {
+        m_messages.push_back("Mesh decimation: " + std::to_string(facesBefore) + " faces already within the target of " +
+                             std::to_string(target) + "; mesh unchanged.");
+        return true;
+    }
+
+    using Clock = std::chrono::steady_clock;
+    const bool hadNormals = static_cast<bool>(m_mesh.property_map<Mesh::Vertex_index, Vector>("v:normal"));
+    std::ostringstream msg;
+    msg << "Mesh decimation: " << facesBefore << " -> ";
+
+    // Coarse parallel pre-pass for very large meshes: vertex clustering down to about twice the target,
+    // with cells sized so that a surface of the mesh's area touches about that many cells
+    const std::size_t prepassFaces = static_cast<std::size_t>(std::max(0, options->cluster_prepass_faces));
+    if (prepassFaces > 0 && facesBefore > prepassFaces && 2 * target < facesBefore) {
+        const auto start = Clock::now();
+        m_mesh.collect_garbage();
+        std::vector<Point> points(m_mesh.number_of_vertices());
+        std::vector<char> locked(options->preserve_borders ? points.size() : 0, 0);
+        for (Mesh::Vertex_index v : m_mesh.vertices()) {
+            points[v.idx()] = m_mesh.point(v);
+            if (!locked.empty()) locked[v.idx()] = m_mesh.is_border(v);
+        }
+        const std::vector<Mesh::Face_index> faces(m_mesh.faces().begin(), m_mesh.faces().end());
+        std::vector<MeshClustering::Triangle> triangles(faces.size());
+        std::vector<double> areas(Parallel::chunkCount(faces.size()), 0.0);
+        Parallel::forChunks(faces.size(), [&](std::size_t c, std::size_t b, std::size_t e) {
+            for (std::size_t i = b; i < e; ++i) {
+                std::size_t k = 0;
+                for (Mesh::Vertex_index v : CGAL::vertices_around_face(m_mesh.halfedge(faces[i]), m_mesh)) triangles[i][k++] = v.idx();
+                areas[c] += PMP::face_area(faces[i], m_mesh);
+            }
+        });
+        double area = 0.0;
+        for (double a : areas) area += a;
+
+        // Surface meshes have about half as many vertices as faces: 2 * target faces ~ target cells
+        const double cellSize = std::sqrt(area / static_cast<double>(target));
+        MeshClustering::Stats stats;
+        if (cellSize > 0.0 && MeshClustering::cluster(points, triangles, cellSize, locked, &stats)) {
+            // Assemble aside so a failed pre-pass leaves the mesh as it was
+            Mesh clustered;
+            if (meshFromSoup(points, triangles, clustered)) {
+                std::swap(m_mesh, clustered);
+                msg << m_mesh.number_of_faces() << " (clustering, " << millisecondsSince(start) << " ms) -> ";
+            } else {
+                m_messages.push_back("Mesh decimation: clustering pre-pass produced no valid mesh; decimating the original.");
+            }
+        } else {
+            m_messages.push_back("Mesh decimation: clustering pre-pass skipped (grid too fine for the mesh extent).");
+        }
+    }
+
+    if (m_mesh.number_of_faces() > target) {
+        namespace SMS = CGAL::Surface_mesh_simplification;
+        using Policies = SMS::GarlandHeckbert_plane_policies<Mesh, K>;
+        const auto start = Clock::now();
+        Policies policies(m_mesh);
+        SMS::Face_count_stop_predicate<Mesh> stop(target);
+        try {
+            if (options->preserve_borders) {
+                const BorderEdgeMap borders {&m_mesh};
+                const SMS::Constrained_placement<Policies::Get_placement, BorderEdgeMap> placement(borders, policies.get_placement());
+                SMS::edge_collapse(m_mesh, stop, CGAL::parameters::get_cost(policies.get_cost())
+                                                     .get_placement(placement)
+                                                     .edge_is_constrained_map(borders));
+            } else {
+                SMS::edge_collapse(m_mesh, stop, CGAL::parameters::get_cost(policies.get_cost())
+                                                     .get_placement(policies.get_placement()));
+            }
+        } catch (const std::exception& e) {
+            std::cerr << "Error decimating mesh: " << e.what() << std::endl;
+            return false;
+        }
+        m_mesh.collect_garbage();
+        msg << m_mesh.number_of_faces() << " (quadric collapse, " << millisecondsSince(start) << " ms)";
+    } else {
+        msg << m_mesh.number_of_faces();
+    }
+    if (hadNormals) computeMeshNormals();
+
+    msg << " faces, target " << target << ".";
+    m_messages.push_back(msg.str());
+    return !m_mesh.is_empty();
+}
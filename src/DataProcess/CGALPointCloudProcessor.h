@@ -2,6 +2,9 @@
 #define POINTTOMESH_CGALPOINTCLOUDPROCESSOR_H
 
 #include "PointCloudProcessor.h"
+#include <array>
+#include <cstdint>
+#include <memory>
 
 /**
  * @class CGALPointCloudProcessor
@@ -16,7 +19,8 @@ public:
     ~CGALPointCloudProcessor() override;
 
     bool loadPointCloud(const std::string& filePath) override;
-    bool estimateNormals(NormalEstimationMethod normalMethod) override;
+    bool estimateNormals(NormalEstimationMethod normalMethod, const BaseInputParameter* params) override;
+    bool orientNormals(const BaseInputParameter* params) override;
 
     bool processToMesh(MeshGenerationMethod meshMethod, const BaseInputParameter* params) override;
     bool exportMesh(const std::string& filePath, bool withNormals) override;
@@ -25,32 +29,78 @@ public:
     [[nodiscard]] const PointCloud& getPointCloud() const override;
     [[nodiscard]] const Mesh& getMesh() const override;
     [[nodiscard]] bool hasNormals() const override;
+    [[nodiscard]] std::size_t missingNormalCount() const override;
 
     // New point cloud utilities
     bool downsampleVoxel(const BaseInputParameter* params) override; // matches interface
+    bool resamplePointSet(PointSetResamplingMethod method, const BaseInputParameter* params) override;
     bool filterAABB(const BaseInputParameter* params) override;
     bool filterSphere(const BaseInputParameter* params) override;
+    bool filterOrientedBox(const BaseInputParameter* params) override;
+    bool filterHalfSpace(const BaseInputParameter* params) override;
+    bool filterByMask(const BaseInputParameter* params) override;
     bool filterSurfaceFromUniformVolume(const BaseInputParameter* params) override;
+    bool removeOutliers(const BaseInputParameter* params) override;
 
     // New mesh post-processing utilities
     bool postProcessMesh(const BaseInputParameter* params) override;
+    bool clipMesh(const BaseInputParameter* params) override;
+    bool decimateMesh(const BaseInputParameter* params) override;
+
+    std::vector<std::string> takeMessages() override;
 
 private:
     // Processing helpers (mesh)
     bool processPoissonWithParams(const PoissonReconstructionParameter* poisson);
+    bool processPoissonTiled(const PoissonReconstructionParameter& poisson);
     bool processScaleSpaceWithParams(const ScaleSpaceReconstructionParameter* ss);
     bool processAdvancingFrontWithParams(const AdvancingFrontReconstructionParameter* af);
+    bool processAdvancingFrontTiled(const AdvancingFrontReconstructionParameter& af);
+    bool processScreenedPoissonWithParams(const ScreenedPoissonReconstructionParameter* sp);
+    bool processVoxelWithParams(const VoxelReconstructionParameter* vx);
+
+    // Normal estimation helpers. With a subset only those points are estimated (only_missing mode);
+    // their neighborhoods still come from the whole cloud.
+    struct NormalSubset;
+    bool estimateNormalsJet(const NormalEstimationParameter& p, const NormalSubset* subset = nullptr);
+    bool estimateNormalsUniformVolumeCentroid(const NormalEstimationParameter& p, const NormalSubset* subset = nullptr);
+    bool estimateNormalsVCM(const NormalEstimationParameter& p, const NormalSubset* subset = nullptr);
+    bool estimateNormalsPCA(const NormalEstimationParameter& p, const NormalSubset* subset = nullptr);
+    bool estimateMissingNormals(NormalEstimationMethod normalMethod, const NormalEstimationParameter& p);
+    bool orientNormals(NormalOrientationMethod method, int k_neighbors);
+
+    // Normal validity mask: recomputed from the normals in one parallel pass (load, full estimation,
+    // reordering filters), or carried along by filters that compact the cloud by index
+    void rebuildNormalMask();
+    void recountMissingNormals();
+    // Stable parallel compaction of the cloud and its normal mask to the flagged points; returns the kept count
+    std::size_t keepPoints(const std::vector<char>& keep);
+
+    // Helper overload for voxel downsampling with raw values (representative as in VoxelDownsampleParameter)
+    bool downsampleVoxel(double cell_size, int representative, std::uint64_t seed);
+
+    // Point set resampling helpers (CGAL point set processing)
+    bool simplifyHierarchy(const HierarchySimplifyParameter& p);
+    bool simplifyWLOP(const WLOPSimplifyParameter& p);
+    bool smoothBilateral(const BilateralSmoothingParameter& p);
 
-    // Normal estimation helpers
-    bool estimateNormalsJet();
-    bool estimateNormalsUniformVolumeCentroid();
-    bool estimateNormalsVCM();
+    // Build m_mesh from a triangle soup through MeshAssembly; the assembly report goes to m_messages
+    bool meshFromSoup(std::vector<Point>& points, std::vector<std::array<std::size_t,3>>& triangles);
+    // Same, assembling into `mesh` instead of m_mesh (which stays untouched, e.g. if assembly fails)
+    bool meshFromSoup(std::vector<Point>& points, std::vector<std::array<std::size_t,3>>& triangles, Mesh& mesh);
 
-    // Helper overload for voxel downsampling with raw value
-    bool downsampleVoxel(double cell_size);
+    // Any change to the point positions/count invalidates caches built from them
+    void markPointCloudChanged() { ++m_cloudRevision; }
 
     PointCloud m_pointCloud;
+    std::uint64_t m_cloudRevision {0};
+    std::vector<std::uint8_t> m_normalValid; // one flag per point: its normal is finite and non-zero
+    std::size_t m_missingNormals {0};        // count of zero flags
     Mesh m_mesh;
+    // Scale-space reconstruction kept across calls so raising the iteration count only runs the extra scales
+    struct ScaleSpaceCache;
+    std::unique_ptr<ScaleSpaceCache> m_scaleSpaceCache;
+    std::vector<std::string> m_messages; // informational output for takeMessages()
 };
 
 #endif //POINTTOMESH_CGALPOINTCLOUDPROCESSOR_H
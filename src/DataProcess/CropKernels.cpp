@@ -0,0 +1,194 @@
+#include "CropKernels.h"
+#include "Parallel.h"
+
+#include <algorithm>
+#include <limits>
+
+#if defined(__AVX__)
+#include <immintrin.h>
+#define POINTTOMESH_CROP_AVX 1
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define POINTTOMESH_CROP_SSE2 1
+#endif
+
+namespace CropKernels {
+
+namespace {
+constexpr std::size_t kBlock = 512; // points per SoA block (3 x 4 KiB, stays in L1)
+constexpr std::size_t kGrain = 1 << 15;
+
+struct Block {
+    alignas(32) double x[kBlock];
+    alignas(32) double y[kBlock];
+    alignas(32) double z[kBlock];
+};
+
+void load(const PointCloud& pc, std::size_t b, std::size_t m, Block& block) {
+    for (std::size_t j = 0; j < m; ++j) {
+        const Point& p = pc[b + j].first;
+        block.x[j] = p.x();
+        block.y[j] = p.y();
+        block.z[j] = p.z();
+    }
+}
+
+// Writes (inside == keepInside) for m points of the block
+void slabKernel(const Block& block, std::size_t m, const Slab* slabs, std::size_t count, bool keepInside, char* out) {
+    const char flip = keepInside ? 0 : 1;
+    std::size_t j = 0;
+#if defined(POINTTOMESH_CROP_AVX)
+    const int mask = keepInside ? 0 : 0xf;
+    for (; j + 4 <= m; j += 4) {
+        const __m256d px = _mm256_load_pd(block.x + j), py = _mm256_load_pd(block.y + j), pz = _mm256_load_pd(block.z + j);
+        __m256d in = _mm256_castsi256_pd(_mm256_set1_epi64x(-1));
+        for (std::size_t s = 0; s < count; ++s) {
+            const __m256d d = _mm256_add_pd(_mm256_add_pd(_mm256_mul_pd(px, _mm256_set1_pd(slabs[s].normal[0])),
+                                                          _mm256_mul_pd(py, _mm256_set1_pd(slabs[s].normal[1]))),
+                                            _mm256_mul_pd(pz, _mm256_set1_pd(slabs[s].normal[2])));
+            in = _mm256_and_pd(in, _mm256_and_pd(_mm256_cmp_pd(d, _mm256_set1_pd(slabs[s].lo), _CMP_GE_OQ),
+                                                 _mm256_cmp_pd(d, _mm256_set1_pd(slabs[s].hi), _CMP_LE_OQ)));
+        }
+        const int bits = _mm256_movemask_pd(in) ^ mask;
+        for (int k = 0; k < 4; ++k) out[j + k] = static_cast<char>((bits >> k) & 1);
+    }
+#elif defined(POINTTOMESH_CROP_SSE2)
+    const int mask = keepInside ? 0 : 0x3;
+    for (; j + 2 <= m; j += 2) {
+        const __m128d px = _mm_load_pd(block.x + j), py = _mm_load_pd(block.y + j), pz = _mm_load_pd(block.z + j);
+        __m128d in = _mm_castsi128_pd(_mm_set1_epi32(-1));
+        for (std::size_t s = 0; s < count; ++s) {
+            const __m128d d = _mm_add_pd(_mm_add_pd(_mm_mul_pd(px, _mm_set1_pd(slabs[s].normal[0])),
+                                                    _mm_mul_pd(py, _mm_set1_pd(slabs[s].normal[1]))),
+                                         _mm_mul_pd(pz, _mm_set1_pd(slabs[s].normal[2])));
+            in = _mm_and_pd(in, _mm_and_pd(_mm_cmpge_pd(d, _mm_set1_pd(slabs[s].lo)), _mm_cmple_pd(d, _mm_set1_pd(slabs[s].hi))));
+        }
+        const int bits = _mm_movemask_pd(in) ^ mask;
+        out[j] = static_cast<char>(bits & 1);
+        out[j + 1] = static_cast<char>((bits >> 1) & 1);
+    }
+#endif
+    // Scalar tail (or the whole block without SIMD); same products and comparisons as the vector path
+    for (; j < m; ++j) {
+        bool in = true;
+        for (std::size_t s = 0; s < count; ++s) {
+            const double d = block.x[j] * slabs[s].normal[0] + block.y[j] * slabs[s].normal[1] + block.z[j] * slabs[s].normal[2];
+            in = in && d >= slabs[s].lo && d <= slabs[s].hi;
+        }
+        out[j] = static_cast<char>(in ? 1 - flip : flip);
+    }
+}
+
+void sphereKernel(const Block& block, std::size_t m, const std::array<double, 3>& c, double r2, bool keepInside, char* out) {
+    const char flip = keepInside ? 0 : 1;
+    std::size_t j = 0;
+#if defined(POINTTOMESH_CROP_AVX)
+    const int mask = keepInside ? 0 : 0xf;
+    const __m256d cx = _mm256_set1_pd(c[0]), cy = _mm256_set1_pd(c[1]), cz = _mm256_set1_pd(c[2]), vr2 = _mm256_set1_pd(r2);
+    for (; j + 4 <= m; j += 4) {
+        const __m256d dx = _mm256_sub_pd(_mm256_load_pd(block.x + j), cx);
+        const __m256d dy = _mm256_sub_pd(_mm256_load_pd(block.y + j), cy);
+        const __m256d dz = _mm256_sub_pd(_mm256_load_pd(block.z + j), cz);
+        const __m256d d2 = _mm256_add_pd(_mm256_add_pd(_mm256_mul_pd(dx, dx), _mm256_mul_pd(dy, dy)), _mm256_mul_pd(dz, dz));
+        const int bits = _mm256_movemask_pd(_mm256_cmp_pd(d2, vr2, _CMP_LE_OQ)) ^ mask;
+        for (int k = 0; k < 4; ++k) out[j + k] = static_cast<char>((bits >> k) & 1);
+    }
+#elif defined(POINTTOMESH_CROP_SSE2)
+    const int mask = keepInside ? 0 : 0x3;
+    const __m128d cx = _mm_set1_pd(c[0]), cy = _mm_set1_pd(c[1]), cz = _mm_set1_pd(c[2]), vr2 = _mm_set1_pd(r2);
+    for (; j + 2 <= m; j += 2) {
+        const __m128d dx = _mm_sub_pd(_mm_load_pd(block.x + j), cx);
+        const __m128d dy = _mm_sub_pd(_mm_load_pd(block.y + j), cy);
+        const __m128d dz = _mm_sub_pd(_mm_load_pd(block.z + j), cz);
+        const __m128d d2 = _mm_add_pd(_mm_add_pd(_mm_mul_pd(dx, dx), _mm_mul_pd(dy, dy)), _mm_mul_pd(dz, dz));
+        const int bits = _mm_movemask_pd(_mm_cmple_pd(d2, vr2)) ^ mask;
+        out[j] = static_cast<char>(bits & 1);
+        out[j + 1] = static_cast<char>((bits >> 1) & 1);
+    }
+#endif
+    for (; j < m; ++j) {
+        const double dx = block.x[j] - c[0], dy = block.y[j] - c[1], dz = block.z[j] - c[2];
+        const bool in = dx * dx + dy * dy + dz * dz <= r2;
+        out[j] = static_cast<char>(in ? 1 - flip : flip);
+    }
+}
+
+template <typename Kernel>
+void classifyBlocks(const PointCloud& pc, std::vector<char>& keep, Kernel&& kernel) {
+    const std::size_t n = pc.size();
+    keep.resize(n);
+    Parallel::forChunks(n, [&](std::size_t, std::size_t b, std::size_t e) {
+        Block block;
+        for (std::size_t i = b; i < e; i += kBlock) {
+            const std::size_t m = std::min(kBlock, e - i);
+            load(pc, i, m, block);
+            kernel(block, m, keep.data() + i);
+        }
+    }, kGrain);
+}
+}
+
+std::array<Slab, 3> boxSlabs(const std::array<double, 3>& min, const std::array<double, 3>& max) {
+    return {Slab {{1.0, 0.0, 0.0}, min[0], max[0]}, Slab {{0.0, 1.0, 0.0}, min[1], max[1]},
+            Slab {{0.0, 0.0, 1.0}, min[2], max[2]}};
+}
+
+std::array<Slab, 3> orientedBoxSlabs(const std::array<double, 3>& center, const std::array<std::array<double, 3>, 3>& axes,
+                                     const std::array<double, 3>& halfExtents) {
+    std::array<Slab, 3> slabs;
+    for (int a = 0; a < 3; ++a) {
+        const double c = axes[a][0] * center[0] + axes[a][1] * center[1] + axes[a][2] * center[2];
+        slabs[a] = Slab {axes[a], c - halfExtents[a], c + halfExtents[a]};
+    }
+    return slabs;
+}
+
+Slab halfSpace(const std::array<double, 3>& normal, double offset) {
+    return Slab {normal, -offset, std::numeric_limits<double>::infinity()};
+}
+
+void classify(const PointCloud& pc, const Slab* slabs, std::size_t slabCount, bool keepInside, std::vector<char>& keep) {
+    classifyBlocks(pc, keep, [&](const Block& block, std::size_t m, char* out) {
+        slabKernel(block, m, slabs, slabCount, keepInside, out);
+    });
+}
+
+void classifySphere(const PointCloud& pc, const std::array<double, 3>& center, double radius, bool keepInside,
+                    std::vector<char>& keep) {
+    const double r2 = radius * radius;
+    classifyBlocks(pc, keep, [&](const Block& block, std::size_t m, char* out) {
+        sphereKernel(block, m, center, r2, keepInside, out);
+    });
+}
+
+std::size_t compact(PointCloud& pc, std::vector<std::uint8_t>& attribute, const std::vector<char>& keep) {
+    const std::size_t n = pc.size();
+    const bool withAttribute = attribute.size() == n;
+
+    std::vector<std::size_t> offsets(Parallel::chunkCount(n, kGrain) + 1, 0);
+    Parallel::forChunks(n, [&](std::size_t c, std::size_t b, std::size_t e) {
+        std::size_t count = 0;
+        for (std::size_t i = b; i < e; ++i) count += keep[i] != 0;
+        offsets[c + 1] = count;
+    }, kGrain);
+    for (std::size_t c = 1; c < offsets.size(); ++c) offsets[c] += offsets[c - 1];
+    const std::size_t kept = offsets.back();
+    if (kept == n) return n;
+
+    PointCloud out(kept);
+    std::vector<std::uint8_t> outAttribute(withAttribute ? kept : 0);
+    Parallel::forChunks(n, [&](std::size_t c, std::size_t b, std::size_t e) {
+        std::size_t w = offsets[c];
+        for (std::size_t i = b; i < e; ++i) {
+            if (!keep[i]) continue;
+            out[w] = pc[i];
+            if (withAttribute) outAttribute[w] = attribute[i];
+            ++w;
+        }
+    }, kGrain);
+    pc.swap(out);
+    if (withAttribute) attribute.swap(outAttribute);
+    return kept;
+}
+
+} // namespace CropKernels
@@ -0,0 +1,43 @@
+#ifndef POINTTOMESH_CROPKERNELS_H
+#define POINTTOMESH_CROPKERNELS_H
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "PointCloudProcessor.h"
+
+// Geometric crop predicates for the point cloud filters. Chunks of the cloud are copied block by block
+// into structure-of-arrays buffers and tested with explicit SIMD (AVX when the compiler targets it, else
+// SSE2, else scalar), writing one keep flag per point. Boxes, oriented boxes and half-spaces are all
+// intersections of slabs; spheres have their own kernel. NaN coordinates are never inside.
+namespace CropKernels {
+
+// lo <= normal · p <= hi (either bound may be infinite)
+struct Slab {
+    std::array<double, 3> normal {0.0, 0.0, 1.0};
+    double lo {0.0};
+    double hi {0.0};
+};
+
+std::array<Slab, 3> boxSlabs(const std::array<double, 3>& min, const std::array<double, 3>& max);
+// axes must be orthonormal; |axes[i] · (p - center)| <= halfExtents[i]
+std::array<Slab, 3> orientedBoxSlabs(const std::array<double, 3>& center, const std::array<std::array<double, 3>, 3>& axes,
+                                     const std::array<double, 3>& halfExtents);
+// normal · p + offset >= 0
+Slab halfSpace(const std::array<double, 3>& normal, double offset);
+
+// keep[i] = (p_i inside every slab) == keepInside; keep is resized to pc.size()
+void classify(const PointCloud& pc, const Slab* slabs, std::size_t slabCount, bool keepInside, std::vector<char>& keep);
+// keep[i] = (|p_i - center| <= radius) == keepInside
+void classifySphere(const PointCloud& pc, const std::array<double, 3>& center, double radius, bool keepInside,
+                    std::vector<char>& keep);
+
+// Stable compaction of pc and a parallel per-point attribute to the flagged points: chunk counts, a
+// prefix sum, then a parallel scatter into new arrays. Returns the kept count.
+std::size_t compact(PointCloud& pc, std::vector<std::uint8_t>& attribute, const std::vector<char>& keep);
+
+} // namespace CropKernels
+
+#endif //POINTTOMESH_CROPKERNELS_H
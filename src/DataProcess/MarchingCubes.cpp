@@ -0,0 +1,219 @@
+#include "MarchingCubes.h"
+#include "Parallel.h"
+
+#include <algorithm>
+
+namespace MarchingCubes {
+
+namespace {
+// Cube corner c sits at (c & 1, (c >> 1) & 1, (c >> 2) & 1)
+int cornerBit(int c, int axis) { return (c >> axis) & 1; }
+
+struct CubeEdge {
+    int a {0}, b {0}; // corners, a is the one with the smaller coordinate
+    int axis {0};
+};
+
+struct CaseTable {
+    std::array<CubeEdge, 12> edges {};
+    std::array<std::uint8_t, 256> count {};
+    std::array<std::array<std::array<std::uint8_t, 3>, 12>, 256> tris {};
+};
+
+// Builds the 256 cases from the cube faces. On every face the corner cycle is walked counter-clockwise
+// as seen from outside the cube, and each edge entering the inside region is joined to the next edge
+// leaving it. This keeps the inside corners of an ambiguous face apart and depends only on that face,
+// so the two cells sharing it always produce the same segments. The segments of all six faces chain
+// into closed loops around the cube, which are fan-triangulated.
+CaseTable buildTable() {
+    CaseTable t;
+    int edgeOf[8][8];
+    int ne = 0;
+    for (int axis = 0; axis < 3; ++axis) {
+        for (int c = 0; c < 8; ++c) {
+            if (cornerBit(c, axis)) continue;
+            const int d = c | (1 << axis);
+            t.edges[ne] = CubeEdge {c, d, axis};
+            edgeOf[c][d] = edgeOf[d][c] = ne;
+            ++ne;
+        }
+    }
+
+    // Faces: corners counter-clockwise seen from outside
+    std::array<std::array<int, 4>, 6> faces {};
+    for (int axis = 0; axis < 3; ++axis) {
+        const int u = (axis + 1) % 3, v = (axis + 2) % 3;
+        for (int side = 0; side < 2; ++side) {
+            static const int uv[4][2] = {{0, 0}, {1, 0}, {1, 1}, {0, 1}};
+            auto& f = faces[axis * 2 + side];
+            for (int k = 0; k < 4; ++k) f[k] = (side << axis) | (uv[k][0] << u) | (uv[k][1] << v);
+            if (side == 0) std::swap(f[1], f[3]); // the -axis face is seen from the other side
+        }
+    }
+
+    // Faces touching each edge, as a 6-bit mask
+    int edgeFaces[12] = {};
+    for (int fi = 0; fi < 6; ++fi)
+        for (int k = 0; k < 4; ++k) edgeFaces[edgeOf[faces[fi][k]][faces[fi][(k + 1) % 4]]] |= 1 << fi;
+    const auto faceEdges = [&edgeFaces](int e) { return edgeFaces[e]; };
+
+    for (int cubeCase = 0; cubeCase < 256; ++cubeCase) {
+        const auto inside = [cubeCase](int c) { return (cubeCase >> c) & 1; };
+        int next[12];
+        std::fill(std::begin(next), std::end(next), -1);
+        for (const auto& f : faces) {
+            int edge[4], entering[4], crossings = 0;
+            for (int k = 0; k < 4; ++k) {
+                const int a = f[k], b = f[(k + 1) % 4];
+                if (inside(a) == inside(b)) continue;
+                edge[crossings] = edgeOf[a][b];
+                entering[crossings] = inside(b);
+                ++crossings;
+            }
+            for (int k = 0; k < crossings; ++k) {
+                if (!entering[k]) continue;
+                for (int s = 1; s < crossings; ++s) {
+                    const int m = (k + s) % crossings;
+                    if (!entering[m]) { next[edge[k]] = edge[m]; break; }
+                }
+            }
+        }
+
+        bool visited[12] = {};
+        int count = 0;
+        for (int start = 0; start < 12; ++start) {
+            if (next[start] < 0 || visited[start]) continue;
+            int loop[12], n = 0;
+            for (int e = start; !visited[e]; e = next[e]) {
+                visited[e] = true;
+                loop[n++] = e;
+            }
+            // Fan from a vertex whose diagonals all cross the cube interior: a diagonal lying in a face
+            // could also be produced by the neighbouring cell and would make that edge non-manifold.
+            // Such an apex exists for every loop of this table.
+            int apex = 0;
+            for (int a = 0; a < n; ++a) {
+                bool ok = true;
+                for (int k = 2; k + 1 < n && ok; ++k) ok = !(faceEdges(loop[a]) & faceEdges(loop[(a + k) % n]));
+                if (ok) { apex = a; break; }
+            }
+            for (int k = 1; k + 1 < n; ++k) {
+                t.tris[cubeCase][count++] = {static_cast<std::uint8_t>(loop[apex]), static_cast<std::uint8_t>(loop[(apex + k) % n]),
+                                             static_cast<std::uint8_t>(loop[(apex + k + 1) % n])};
+            }
+        }
+        t.count[cubeCase] = static_cast<std::uint8_t>(count);
+    }
+
+    // Orientation: with only corner 0 inside the normal must point away from it, towards (1, 1, 1)
+    const auto mid = [&t](int e, int axis) {
+        return 0.5 * (cornerBit(t.edges[e].a, axis) + cornerBit(t.edges[e].b, axis));
+    };
+    const auto& tri = t.tris[1][0];
+    double p[3][3];
+    for (int k = 0; k < 3; ++k)
+        for (int axis = 0; axis < 3; ++axis) p[k][axis] = mid(tri[k], axis);
+    const double u[3] = {p[1][0] - p[0][0], p[1][1] - p[0][1], p[1][2] - p[0][2]};
+    const double w[3] = {p[2][0] - p[0][0], p[2][1] - p[0][1], p[2][2] - p[0][2]};
+    const double nrm[3] = {u[1] * w[2] - u[2] * w[1], u[2] * w[0] - u[0] * w[2], u[0] * w[1] - u[1] * w[0]};
+    if (nrm[0] + nrm[1] + nrm[2] < 0.0) {
+        for (auto& cubeTris : t.tris)
+            for (auto& tr : cubeTris) std::swap(tr[1], tr[2]);
+    }
+    return t;
+}
+
+const CaseTable& table() {
+    static const CaseTable t = buildTable();
+    return t;
+}
+}
+
+void extract(const SparseGrid::BrickLayout& layout, const std::vector<float>& values, float iso, const Frame& frame,
+             const std::vector<std::uint8_t>* cellMask, std::vector<Point>& points, std::vector<Triangle>& triangles) {
+    points.clear();
+    triangles.clear();
+    const CaseTable& t = table();
+    const int res = layout.resolution();
+    const std::uint64_t stride = static_cast<std::uint64_t>(res) + 1;
+    const std::size_t n = layout.nodeCount();
+
+    // A vertex is identified by its lattice edge: minimum node and axis
+    const auto edgeKey = [stride](int i, int j, int k, int axis) {
+        return ((static_cast<std::uint64_t>(k) * stride + static_cast<std::uint64_t>(j)) * stride +
+                static_cast<std::uint64_t>(i)) * 3 + static_cast<std::uint64_t>(axis);
+    };
+
+    using KeyTriangle = std::array<std::uint64_t, 3>;
+    constexpr std::size_t kMinChunk = 1024;
+    std::vector<std::vector<KeyTriangle>> partial(Parallel::chunkCount(n, kMinChunk));
+    Parallel::forChunks(n, [&](std::size_t chunk, std::size_t b, std::size_t e) {
+        auto& out = partial[chunk];
+        for (std::size_t idx = b; idx < e; ++idx) {
+            if (cellMask && !(*cellMask)[idx]) continue;
+            const auto node = layout.nodeOf(idx);
+            if (node[0] >= res || node[1] >= res || node[2] >= res) continue;
+
+            int cubeCase = 0;
+            bool complete = true;
+            for (int c = 0; c < 8 && complete; ++c) {
+                const auto ci = layout.index(node[0] + cornerBit(c, 0), node[1] + cornerBit(c, 1), node[2] + cornerBit(c, 2));
+                if (ci == SparseGrid::BrickLayout::kNone) { complete = false; break; }
+                if (values[static_cast<std::size_t>(ci)] > iso) cubeCase |= 1 << c;
+            }
+            if (!complete || cubeCase == 0 || cubeCase == 255) continue;
+
+            for (int k = 0; k < t.count[cubeCase]; ++k) {
+                KeyTriangle kt {};
+                for (int v = 0; v < 3; ++v) {
+                    const CubeEdge& ce = t.edges[t.tris[cubeCase][k][v]];
+                    kt[v] = edgeKey(node[0] + cornerBit(ce.a, 0), node[1] + cornerBit(ce.a, 1), node[2] + cornerBit(ce.a, 2), ce.axis);
+                }
+                out.push_back(kt);
+            }
+        }
+    }, kMinChunk);
+
+    std::vector<KeyTriangle> keyed;
+    std::size_t total = 0;
+    for (const auto& p : partial) total += p.size();
+    if (total == 0) return;
+    keyed.reserve(total);
+    for (auto& p : partial) {
+        keyed.insert(keyed.end(), p.begin(), p.end());
+        std::vector<KeyTriangle>().swap(p);
+    }
+
+    std::vector<std::uint64_t> keys;
+    keys.reserve(3 * total);
+    for (const auto& kt : keyed) keys.insert(keys.end(), kt.begin(), kt.end());
+    std::sort(keys.begin(), keys.end());
+    keys.erase(std::unique(keys.begin(), keys.end()), keys.end());
+
+    // One vertex per crossed lattice edge, placed by linear interpolation
+    points.resize(keys.size());
+    Parallel::forEach(keys.size(), [&](std::size_t v) {
+        const std::uint64_t key = keys[v];
+        const int axis = static_cast<int>(key % 3);
+        const std::uint64_t node = key / 3;
+        int ijk[3] = {static_cast<int>(node % stride), static_cast<int>((node / stride) % stride), static_cast<int>(node / (stride * stride))};
+        const float v0 = values[static_cast<std::size_t>(layout.index(ijk[0], ijk[1], ijk[2]))];
+        ijk[axis] += 1;
+        const float v1 = values[static_cast<std::size_t>(layout.index(ijk[0], ijk[1], ijk[2]))];
+        ijk[axis] -= 1;
+        // Keep vertices off the lattice nodes so neighbouring edges never produce coincident points
+        const double s = v1 != v0 ? std::clamp(static_cast<double>(iso - v0) / static_cast<double>(v1 - v0), 0.01, 0.99) : 0.5;
+        double pos[3];
+        for (int a = 0; a < 3; ++a) pos[a] = frame.origin[a] + frame.h * (ijk[a] + (a == axis ? s : 0.0));
+        points[v] = Point(pos[0], pos[1], pos[2]);
+    });
+
+    triangles.resize(keyed.size());
+    Parallel::forEach(keyed.size(), [&](std::size_t f) {
+        for (int k = 0; k < 3; ++k) {
+            triangles[f][k] = static_cast<std::size_t>(std::lower_bound(keys.begin(), keys.end(), keyed[f][k]) - keys.begin());
+        }
+    });
+}
+
+} // namespace MarchingCubes
@@ -0,0 +1,35 @@
+#ifndef POINTTOMESH_MARCHINGCUBES_H
+#define POINTTOMESH_MARCHINGCUBES_H
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "PointCloudProcessor.h"
+#include "SparseGrid.h"
+
+// Iso-surface extraction from a node field stored on a SparseGrid::BrickLayout.
+// The case table is generated from the cube faces (inside corners of an ambiguous face are kept
+// apart), so neighbouring cells always agree on their shared face and the output is watertight
+// wherever all cells around the surface are present. Cells are processed in parallel; vertices are
+// shared between cells through their lattice edge.
+namespace MarchingCubes {
+
+using Triangle = std::array<std::size_t, 3>;
+
+// Node (i, j, k) sits at origin + h * (i, j, k)
+struct Frame {
+    double origin[3] {0.0, 0.0, 0.0};
+    double h {1.0};
+};
+
+// Inside is value > iso; triangles are oriented with normals pointing out of the inside region.
+// cellMask (optional, indexed like values) restricts extraction to cells whose minimum corner is flagged.
+// points/triangles are replaced; both stay empty if no cell crosses the iso value.
+void extract(const SparseGrid::BrickLayout& layout, const std::vector<float>& values, float iso, const Frame& frame,
+             const std::vector<std::uint8_t>* cellMask, std::vector<Point>& points, std::vector<Triangle>& triangles);
+
+} // namespace MarchingCubes
+
+#endif //POINTTOMESH_MARCHINGCUBES_H
@@ -0,0 +1,190 @@
+#include "MeshAssembly.h"
+#include "Parallel.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <iostream>
+#include <sstream>
+
+#include <CGAL/Polygon_mesh_processing/repair_polygon_soup.h>
+#include <CGAL/Polygon_mesh_processing/orient_polygon_soup.h>
+#include <CGAL/Polygon_mesh_processing/polygon_soup_to_polygon_mesh.h>
+
+namespace PMP = CGAL::Polygon_mesh_processing;
+
+namespace MeshAssembly {
+
+namespace {
+// One directed triangle edge; slot = 3 * face + k, running from triangle[k] to triangle[(k + 1) % 3]
+struct EdgeRef {
+    std::size_t lo, hi;
+    std::size_t slot;
+    bool forward; // source == lo
+};
+
+bool sameEdge(const EdgeRef& a, const EdgeRef& b) { return a.lo == b.lo && a.hi == b.hi; }
+
+std::vector<EdgeRef> collectEdges(const std::vector<Triangle>& tris, const std::vector<std::uint8_t>& alive) {
+    std::vector<EdgeRef> edges(3 * tris.size());
+    Parallel::forEach(tris.size(), [&](std::size_t f) {
+        for (std::size_t k = 0; k < 3; ++k) {
+            const std::size_t a = tris[f][k], b = tris[f][(k + 1) % 3];
+            // Dead faces sort to the end and are trimmed below
+            edges[3 * f + k] = alive[f] ? EdgeRef {std::min(a, b), std::max(a, b), 3 * f + k, a < b}
+                                        : EdgeRef {SIZE_MAX, SIZE_MAX, 3 * f + k, false};
+        }
+    });
+    std::sort(edges.begin(), edges.end(), [](const EdgeRef& l, const EdgeRef& r) {
+        return l.lo != r.lo ? l.lo < r.lo : (l.hi != r.hi ? l.hi < r.hi : l.slot < r.slot);
+    });
+    while (!edges.empty() && edges.back().lo == SIZE_MAX) edges.pop_back();
+    return edges;
+}
+
+// Keep at most two faces per edge, with opposite orientations; returns the number of faces dropped.
+// One pass is enough: dropping faces only ever shrinks the other edge groups.
+std::size_t dropNonManifoldFaces(const std::vector<EdgeRef>& edges, std::vector<std::uint8_t>& alive) {
+    std::size_t dropped = 0;
+    for (std::size_t b = 0; b < edges.size();) {
+        std::size_t e = b + 1;
+        while (e < edges.size() && sameEdge(edges[b], edges[e])) ++e;
+        if (e - b > 2 || (e - b == 2 && edges[b].forward == edges[b + 1].forward)) {
+            // Keep the first live face and the first live face oriented against it
+            const EdgeRef* first = nullptr;
+            const EdgeRef* partner = nullptr;
+            for (std::size_t i = b; i < e; ++i) {
+                const std::size_t f = edges[i].slot / 3;
+                if (!alive[f]) continue;
+                if (!first) { first = &edges[i]; continue; }
+                if (!partner && edges[i].forward != first->forward) { partner = &edges[i]; continue; }
+                alive[f] = 0;
+                ++dropped;
+            }
+        }
+        b = e;
+    }
+    return dropped;
+}
+
+// Writes the connectivity directly; returns false if the result is not a valid manifold mesh
+bool buildDirect(const std::vector<Point>& points, const std::vector<Triangle>& tris,
+                 const std::vector<std::uint8_t>& alive, const std::vector<EdgeRef>& edges, Mesh& mesh) {
+    using V = Mesh::Vertex_index;
+    using H = Mesh::Halfedge_index;
+
+    std::size_t edgeCount = 0, faceCount = 0;
+    for (std::size_t i = 0; i < edges.size(); ++i)
+        if (i == 0 || !sameEdge(edges[i - 1], edges[i])) ++edgeCount;
+    for (auto a : alive) faceCount += a;
+
+    mesh.clear();
+    mesh.reserve(static_cast<Mesh::size_type>(points.size()), static_cast<Mesh::size_type>(edgeCount),
+                 static_cast<Mesh::size_type>(faceCount));
+    for (const auto& p : points) mesh.add_vertex(p);
+
+    // Edges: the first directed use gets the halfedge, its partner the opposite one
+    std::vector<H> slotHalfedge(3 * tris.size());
+    for (std::size_t b = 0; b < edges.size();) {
+        std::size_t e = b + 1;
+        while (e < edges.size() && sameEdge(edges[b], edges[e])) ++e;
+        if (e - b > 2) return false; // dropNonManifoldFaces() ran on a different edge list
+        const EdgeRef& r = edges[b];
+        const std::size_t src = tris[r.slot / 3][r.slot % 3];
+        const std::size_t dst = tris[r.slot / 3][(r.slot % 3 + 1) % 3];
+        const H h = mesh.add_edge(V(static_cast<Mesh::size_type>(src)), V(static_cast<Mesh::size_type>(dst)));
+        slotHalfedge[r.slot] = h;
+        if (e - b == 2) slotHalfedge[edges[b + 1].slot] = mesh.opposite(h);
+        b = e;
+    }
+
+    // Faces: link the three halfedges of every triangle
+    for (std::size_t f = 0; f < tris.size(); ++f) {
+        if (!alive[f]) continue;
+        const Mesh::Face_index fi = mesh.add_face();
+        const H h[3] = {slotHalfedge[3 * f], slotHalfedge[3 * f + 1], slotHalfedge[3 * f + 2]};
+        mesh.set_halfedge(fi, h[0]);
+        for (int k = 0; k < 3; ++k) {
+            mesh.set_face(h[k], fi);
+            mesh.set_next(h[k], h[(k + 1) % 3]);
+        }
+    }
+
+    // Border loops: each vertex may start at most one border halfedge, otherwise it is pinched
+    std::vector<H> borderOut(points.size(), Mesh::null_halfedge());
+    for (H h : mesh.halfedges()) {
+        if (!mesh.is_border(h)) continue;
+        auto& out = borderOut[static_cast<std::size_t>(mesh.source(h))];
+        if (out != Mesh::null_halfedge()) return false;
+        out = h;
+    }
+    for (H h : mesh.halfedges()) {
+        if (mesh.is_border(h)) mesh.set_next(h, borderOut[static_cast<std::size_t>(mesh.target(h))]);
+    }
+
+    // Vertex -> incoming halfedge, preferring border halfedges as Surface_mesh expects
+    std::vector<std::size_t> incoming(points.size(), 0);
+    for (H h : mesh.halfedges()) {
+        const V v = mesh.target(h);
+        ++incoming[static_cast<std::size_t>(v)];
+        if (mesh.halfedge(v) == Mesh::null_halfedge() || mesh.is_border(h)) mesh.set_halfedge(v, h);
+    }
+
+    // A vertex whose umbrella does not reach all of its incoming halfedges joins several fans
+    for (V v : mesh.vertices()) {
+        if (mesh.halfedge(v) == Mesh::null_halfedge()) continue;
+        std::size_t around = 0;
+        for (H h : CGAL::halfedges_around_target(mesh.halfedge(v), mesh)) { (void)h; if (++around > incoming[static_cast<std::size_t>(v)]) break; }
+        if (around != incoming[static_cast<std::size_t>(v)]) return false;
+    }
+    return mesh.is_valid(false);
+}
+}
+
+std::string Report::summary() const {
+    std::ostringstream s;
+    s << "Mesh assembly: " << inputTriangles << " facets in, " << removedBySoupRepair << " removed by soup repair, "
+      << droppedNonManifold << " non-manifold facets dropped, " << duplicatedVertices << " vertices duplicated"
+      << (usedFallback ? " (fallback path)." : ".");
+    return s.str();
+}
+
+bool assemble(std::vector<Point>& points, std::vector<Triangle>& triangles, Mesh& mesh, Report* report) {
+    Report local;
+    Report& r = report ? *report : local;
+    r = Report {};
+    r.inputPoints = points.size();
+    r.inputTriangles = triangles.size();
+
+    PMP::repair_polygon_soup(points, triangles);
+    r.removedBySoupRepair = r.inputTriangles - triangles.size();
+    const std::size_t beforeOrient = points.size();
+    PMP::orient_polygon_soup(points, triangles); // duplicates vertices where the soup is not manifold
+    r.duplicatedVertices = points.size() - beforeOrient;
+    if (triangles.empty()) { mesh.clear(); return false; }
+
+    std::vector<std::uint8_t> alive(triangles.size(), 1);
+    r.droppedNonManifold = dropNonManifoldFaces(collectEdges(triangles, alive), alive);
+    const auto edges = collectEdges(triangles, alive);
+    if (buildDirect(points, triangles, alive, edges, mesh)) return !mesh.is_empty();
+
+    // Pinched vertices left after dropping faces: let CGAL split them on the filtered soup
+    r.usedFallback = true;
+    std::vector<Triangle> kept;
+    kept.reserve(triangles.size());
+    for (std::size_t f = 0; f < triangles.size(); ++f)
+        if (alive[f]) kept.push_back(triangles[f]);
+    const std::size_t beforeFallback = points.size();
+    PMP::orient_polygon_soup(points, kept);
+    r.duplicatedVertices += points.size() - beforeFallback;
+    mesh.clear();
+    try {
+        PMP::polygon_soup_to_polygon_mesh(points, kept, mesh);
+    } catch (const std::exception& e) {
+        std::cerr << "Error: Failed to build mesh from polygon soup: " << e.what() << std::endl;
+        mesh.clear();
+        return false;
+    }
+    return !mesh.is_empty();
+}
+
+} // namespace MeshAssembly
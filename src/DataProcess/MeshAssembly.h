@@ -0,0 +1,39 @@
+#ifndef POINTTOMESH_MESHASSEMBLY_H
+#define POINTTOMESH_MESHASSEMBLY_H
+
+#include <array>
+#include <cstddef>
+#include <string>
+#include <vector>
+
+#include "PointCloudProcessor.h"
+
+// Bulk conversion of triangle soups (reconstruction output) into a Surface_mesh.
+// The soup is repaired and oriented first; the mesh is then written directly through the low-level
+// Surface_mesh connectivity API with all elements reserved up front, instead of one add_face() per
+// triangle. Facets that would make the mesh non-manifold are dropped and counted.
+// Only the per-triangle edge records are filled in parallel. repair_polygon_soup, orient_polygon_soup,
+// the edge sort and the connectivity writes are serial, so the repair and orientation steps still
+// bound the time for large soups; the gain over add_face() is in the mesh construction alone.
+namespace MeshAssembly {
+
+using Triangle = std::array<std::size_t, 3>;
+
+struct Report {
+    std::size_t inputPoints {0};
+    std::size_t inputTriangles {0};
+    std::size_t removedBySoupRepair {0};   // degenerate / duplicate triangles removed by repair_polygon_soup
+    std::size_t duplicatedVertices {0};    // vertices split by orient_polygon_soup at non-manifold spots
+    std::size_t droppedNonManifold {0};    // triangles dropped because an edge had more than two faces
+    bool usedFallback {false};             // direct assembly failed; polygon_soup_to_polygon_mesh was used
+
+    [[nodiscard]] std::string summary() const;
+};
+
+// Builds `mesh` from the soup (points/triangles are modified by the repair step).
+// Returns false if no valid mesh could be built.
+bool assemble(std::vector<Point>& points, std::vector<Triangle>& triangles, Mesh& mesh, Report* report = nullptr);
+
+} // namespace MeshAssembly
+
+#endif //POINTTOMESH_MESHASSEMBLY_H
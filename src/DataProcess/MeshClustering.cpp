@@ -0,0 +1,141 @@
+#include "MeshClustering.h"
+#include "Parallel.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <utility>
+
+namespace MeshClustering {
+
+namespace {
+constexpr int kAxisBits = 21;
+constexpr std::uint64_t kLockedBit = 1ULL << 63;
+constexpr std::size_t kGrain = 1 << 15;
+
+using Entry = std::pair<std::uint64_t, std::size_t>; // (cell key, vertex)
+
+// Sorts chunks in parallel, then merges neighbouring runs pairwise (each round in parallel)
+void parallelSort(std::vector<Entry>& entries) {
+    const std::size_t n = entries.size();
+    const std::size_t chunks = Parallel::chunkCount(n, kGrain);
+    const std::size_t step = (n + chunks - 1) / chunks;
+    Parallel::forChunks(n, [&](std::size_t, std::size_t b, std::size_t e) {
+        std::sort(entries.begin() + static_cast<std::ptrdiff_t>(b), entries.begin() + static_cast<std::ptrdiff_t>(e));
+    }, kGrain);
+    for (std::size_t width = step; width < n; width *= 2) {
+        const std::size_t merges = (n + 2 * width - 1) / (2 * width);
+        Parallel::forTasks(merges, [&](std::size_t m) {
+            const std::size_t b = m * 2 * width;
+            const std::size_t mid = std::min(n, b + width);
+            const std::size_t e = std::min(n, b + 2 * width);
+            if (mid < e) {
+                std::inplace_merge(entries.begin() + static_cast<std::ptrdiff_t>(b),
+                                   entries.begin() + static_cast<std::ptrdiff_t>(mid),
+                                   entries.begin() + static_cast<std::ptrdiff_t>(e));
+            }
+        });
+    }
+}
+}
+
+bool cluster(std::vector<Point>& points, std::vector<Triangle>& triangles, double cellSize,
+             const std::vector<char>& locked, Stats* stats) {
+    const std::size_t n = points.size();
+    if (!(cellSize > 0.0)) return false;
+    if (n == 0) return true;
+    const bool withLocks = locked.size() == n;
+
+    // Bounding box (per chunk, then reduced)
+    const std::size_t chunks = Parallel::chunkCount(n, kGrain);
+    std::vector<std::array<double, 6>> boxes(chunks, {std::numeric_limits<double>::max(), std::numeric_limits<double>::max(),
+                                                      std::numeric_limits<double>::max(), std::numeric_limits<double>::lowest(),
+                                                      std::numeric_limits<double>::lowest(), std::numeric_limits<double>::lowest()});
+    Parallel::forChunks(n, [&](std::size_t c, std::size_t b, std::size_t e) {
+        auto& box = boxes[c];
+        for (std::size_t i = b; i < e; ++i) {
+            const double p[3] = {points[i].x(), points[i].y(), points[i].z()};
+            for (int a = 0; a < 3; ++a) {
+                box[a] = std::min(box[a], p[a]);
+                box[a + 3] = std::max(box[a + 3], p[a]);
+            }
+        }
+    }, kGrain);
+    std::array<double, 6> box = boxes[0];
+    for (const auto& part : boxes) {
+        for (int a = 0; a < 3; ++a) {
+            box[a] = std::min(box[a], part[a]);
+            box[a + 3] = std::max(box[a + 3], part[a + 3]);
+        }
+    }
+    for (int a = 0; a < 3; ++a) {
+        if ((box[a + 3] - box[a]) / cellSize >= double(1ULL << kAxisBits) - 1.0) return false;
+    }
+
+    // Cell key per vertex; a locked vertex gets a key of its own
+    std::vector<Entry> entries(n);
+    Parallel::forEach(n, [&](std::size_t i) {
+        if (withLocks && locked[i]) { entries[i] = {kLockedBit | i, i}; return; }
+        const auto cell = [&](double v, int a) { return static_cast<std::uint64_t>((v - box[a]) / cellSize); };
+        const std::uint64_t key = (cell(points[i].x(), 0) << (2 * kAxisBits)) | (cell(points[i].y(), 1) << kAxisBits) |
+                                  cell(points[i].z(), 2);
+        entries[i] = {key, i};
+    }, kGrain);
+    parallelSort(entries);
+
+    // Runs of equal keys are the clusters
+    std::vector<std::size_t> runStart;
+    runStart.reserve(n / 4 + 1);
+    for (std::size_t i = 0; i < n; ++i) {
+        if (i == 0 || entries[i].first != entries[i - 1].first) runStart.push_back(i);
+    }
+    const std::size_t clusters = runStart.size();
+    runStart.push_back(n);
+
+    std::vector<Point> out(clusters);
+    std::vector<std::size_t> remap(n);
+    Parallel::forEach(clusters, [&](std::size_t c) {
+        double x = 0.0, y = 0.0, z = 0.0;
+        for (std::size_t i = runStart[c]; i < runStart[c + 1]; ++i) {
+            const Point& p = points[entries[i].second];
+            x += p.x(); y += p.y(); z += p.z();
+            remap[entries[i].second] = c;
+        }
+        const double inv = 1.0 / static_cast<double>(runStart[c + 1] - runStart[c]);
+        out[c] = Point(x * inv, y * inv, z * inv);
+    }, 1024);
+
+    // Remap triangles and drop the collapsed ones (stable parallel compaction)
+    const std::size_t t = triangles.size();
+    std::vector<std::size_t> offsets(Parallel::chunkCount(t, kGrain) + 1, 0);
+    Parallel::forChunks(t, [&](std::size_t c, std::size_t b, std::size_t e) {
+        std::size_t kept = 0;
+        for (std::size_t i = b; i < e; ++i) {
+            auto& tri = triangles[i];
+            for (auto& v : tri) v = remap[v];
+            if (tri[0] == tri[1] || tri[1] == tri[2] || tri[0] == tri[2]) tri[0] = std::numeric_limits<std::size_t>::max();
+            else ++kept;
+        }
+        offsets[c + 1] = kept;
+    }, kGrain);
+    for (std::size_t c = 1; c < offsets.size(); ++c) offsets[c] += offsets[c - 1];
+    std::vector<Triangle> kept(offsets.back());
+    Parallel::forChunks(t, [&](std::size_t c, std::size_t b, std::size_t e) {
+        std::size_t w = offsets[c];
+        for (std::size_t i = b; i < e; ++i) {
+            if (triangles[i][0] != std::numeric_limits<std::size_t>::max()) kept[w++] = triangles[i];
+        }
+    }, kGrain);
+
+    if (stats) {
+        stats->inputVertices = n;
+        stats->clusters = clusters;
+        stats->collapsedTriangles = t - kept.size();
+    }
+    points.swap(out);
+    triangles.swap(kept);
+    return true;
+}
+
+} // namespace MeshClustering
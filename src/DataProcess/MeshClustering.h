@@ -0,0 +1,32 @@
+#ifndef POINTTOMESH_MESHCLUSTERING_H
+#define POINTTOMESH_MESHCLUSTERING_H
+
+#include <array>
+#include <cstddef>
+#include <vector>
+
+#include "PointCloudProcessor.h"
+
+// Vertex-clustering simplification of a triangle soup, used as a coarse pre-pass before quadric
+// decimation of very large meshes. Vertices are bucketed on a uniform grid, every occupied cell becomes
+// one vertex at the mean of its members, and triangles whose corners fall into fewer than three cells
+// are dropped. Keys, the cell sort and the remapping all run in parallel.
+namespace MeshClustering {
+
+using Triangle = std::array<std::size_t, 3>;
+
+struct Stats {
+    std::size_t inputVertices {0};
+    std::size_t clusters {0};          // output vertices
+    std::size_t collapsedTriangles {0}; // triangles dropped because two corners merged
+};
+
+// Clusters points/triangles in place. Vertices with locked[i] != 0 (e.g. border vertices) keep their
+// own cluster and exact position; locked may be empty. Returns false if the cell size is not positive
+// or the grid would need more than 2^21 cells along an axis.
+bool cluster(std::vector<Point>& points, std::vector<Triangle>& triangles, double cellSize,
+             const std::vector<char>& locked, Stats* stats = nullptr);
+
+} // namespace MeshClustering
+
+#endif //POINTTOMESH_MESHCLUSTERING_H
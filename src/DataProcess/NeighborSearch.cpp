@@ -0,0 +1,235 @@
+#include "NeighborSearch.h"
+#include "Parallel.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <utility>
+
+namespace NeighborSearch {
+
+namespace {
+struct Entry {
+    std::array<double, 3> p;
+    std::uint32_t index;
+};
+
+struct Splits {
+    std::vector<std::uint8_t>& axis;
+    std::vector<double>& value;
+};
+
+// Splits [b, e) at its middle element along the widest axis of its bounding box
+std::size_t splitRange(std::vector<Entry>& entries, Splits& splits, std::size_t b, std::size_t e) {
+    std::array<double, 3> lo {entries[b].p}, hi {entries[b].p};
+    for (std::size_t i = b + 1; i < e; ++i) {
+        for (int a = 0; a < 3; ++a) {
+            lo[a] = std::min(lo[a], entries[i].p[a]);
+            hi[a] = std::max(hi[a], entries[i].p[a]);
+        }
+    }
+    int axis = 0;
+    for (int a = 1; a < 3; ++a) if (hi[a] - lo[a] > hi[axis] - lo[axis]) axis = a;
+
+    const std::size_t mid = b + (e - b) / 2;
+    std::nth_element(entries.begin() + static_cast<std::ptrdiff_t>(b), entries.begin() + static_cast<std::ptrdiff_t>(mid),
+                     entries.begin() + static_cast<std::ptrdiff_t>(e),
+                     [axis](const Entry& l, const Entry& r) { return l.p[axis] < r.p[axis]; });
+    splits.axis[mid] = static_cast<std::uint8_t>(axis);
+    splits.value[mid] = entries[mid].p[axis];
+    return mid;
+}
+
+void buildSerial(std::vector<Entry>& entries, Splits& splits, std::size_t b, std::size_t e,
+                 std::size_t leafSize) {
+    if (e - b <= leafSize) return;
+    const std::size_t mid = splitRange(entries, splits, b, e);
+    buildSerial(entries, splits, b, mid, leafSize);
+    buildSerial(entries, splits, mid, e, leafSize);
+}
+
+// Max-heap on distance, so the current k-th neighbour is at the front
+bool fartherFirst(const Neighbor& l, const Neighbor& r) { return l.squaredDistance < r.squaredDistance; }
+}
+
+KdTree::KdTree(const PointCloud& pc) {
+    const std::size_t n = pc.size();
+    if (n == 0) return;
+
+    std::vector<Entry> entries(n);
+    Parallel::forEach(n, [&](std::size_t i) {
+        entries[i] = Entry {{pc[i].first.x(), pc[i].first.y(), pc[i].first.z()}, static_cast<std::uint32_t>(i)};
+    });
+    m_axis.assign(n, 0);
+    m_split.assign(n, 0.0);
+    Splits splits {m_axis, m_split};
+
+    // Top levels one range at a time (each split is already linear), then the subtrees as parallel tasks
+    std::vector<std::pair<std::size_t, std::size_t>> ranges {{0, n}};
+    const std::size_t wanted = 4 * static_cast<std::size_t>(Parallel::threadCount());
+    while (ranges.size() < wanted) {
+        std::vector<std::pair<std::size_t, std::size_t>> next;
+        for (const auto& [b, e] : ranges) {
+            if (e - b <= kLeafSize) { next.emplace_back(b, e); continue; }
+            const std::size_t mid = splitRange(entries, splits, b, e);
+            next.emplace_back(b, mid);
+            next.emplace_back(mid, e);
+        }
+        if (next.size() == ranges.size()) break;
+        ranges.swap(next);
+    }
+    Parallel::forTasks(ranges.size(), [&](std::size_t t) {
+        buildSerial(entries, splits, ranges[t].first, ranges[t].second, kLeafSize);
+    });
+
+    m_points.resize(n);
+    m_index.resize(n);
+    Parallel::forEach(n, [&](std::size_t i) {
+        m_points[i] = entries[i].p;
+        m_index[i] = entries[i].index;
+    });
+}
+
+void KdTree::search(std::size_t b, std::size_t e, const std::array<double, 3>& q, std::size_t k, std::size_t skip,
+                    std::array<double, 3>& offset, double cellDistance, std::vector<Neighbor>& heap) const {
+    if (e - b <= kLeafSize) {
+        for (std::size_t i = b; i < e; ++i) {
+            if (m_index[i] == skip) continue;
+            const double dx = m_points[i][0] - q[0], dy = m_points[i][1] - q[1], dz = m_points[i][2] - q[2];
+            const double d2 = dx * dx + dy * dy + dz * dz;
+            if (heap.size() < k) {
+                heap.push_back({m_index[i], d2});
+                std::push_heap(heap.begin(), heap.end(), fartherFirst);
+            } else if (d2 < heap.front().squaredDistance) {
+                std::pop_heap(heap.begin(), heap.end(), fartherFirst);
+                heap.back() = {m_index[i], d2};
+                std::push_heap(heap.begin(), heap.end(), fartherFirst);
+            }
+        }
+        return;
+    }
+
+    const std::size_t mid = b + (e - b) / 2;
+    const int axis = m_axis[mid];
+    const double diff = q[axis] - m_split[mid];
+    const bool lowFirst = diff < 0.0;
+    if (lowFirst) search(b, mid, q, k, skip, offset, cellDistance, heap);
+    else search(mid, e, q, k, skip, offset, cellDistance, heap);
+
+    // Squared distance from q to the far cell: replace this axis' share of the distance to the current
+    // cell by the distance to the splitting plane (the other axes are unchanged)
+    const double saved = offset[axis];
+    const double farDistance = cellDistance - saved * saved + diff * diff;
+    if (heap.size() < k || farDistance < heap.front().squaredDistance) {
+        offset[axis] = diff;
+        if (lowFirst) search(mid, e, q, k, skip, offset, farDistance, heap);
+        else search(b, mid, q, k, skip, offset, farDistance, heap);
+        offset[axis] = saved;
+    }
+}
+
+void KdTree::nearest(const std::array<double, 3>& q, std::size_t k, std::vector<Neighbor>& out, std::size_t skip) const {
+    out.clear();
+    if (k == 0 || m_points.empty()) return;
+    out.reserve(k);
+    std::array<double, 3> offset {0.0, 0.0, 0.0};
+    search(0, m_points.size(), q, k, skip, offset, 0.0, out);
+    std::sort_heap(out.begin(), out.end(), fartherFirst);
+}
+
+template <typename Visit>
+bool KdTree::visitWithin(std::size_t b, std::size_t e, const std::array<double, 3>& q, double r2, std::size_t skip,
+                         std::array<double, 3>& offset, double cellDistance, Visit& visit) const {
+    if (e - b <= kLeafSize) {
+        for (std::size_t i = b; i < e; ++i) {
+            if (m_index[i] == skip) continue;
+            const double dx = m_points[i][0] - q[0], dy = m_points[i][1] - q[1], dz = m_points[i][2] - q[2];
+            const double d2 = dx * dx + dy * dy + dz * dz;
+            if (d2 <= r2 && !visit(m_index[i], d2)) return false;
+        }
+        return true;
+    }
+
+    const std::size_t mid = b + (e - b) / 2;
+    const int axis = m_axis[mid];
+    const double diff = q[axis] - m_split[mid];
+    const bool lowFirst = diff < 0.0;
+    if (!(lowFirst ? visitWithin(b, mid, q, r2, skip, offset, cellDistance, visit)
+                   : visitWithin(mid, e, q, r2, skip, offset, cellDistance, visit))) {
+        return false;
+    }
+
+    const double saved = offset[axis];
+    const double farDistance = cellDistance - saved * saved + diff * diff;
+    if (farDistance > r2) return true;
+    offset[axis] = diff;
+    const bool more = lowFirst ? visitWithin(mid, e, q, r2, skip, offset, farDistance, visit)
+                               : visitWithin(b, mid, q, r2, skip, offset, farDistance, visit);
+    offset[axis] = saved;
+    return more;
+}
+
+void KdTree::withinRadius(const std::array<double, 3>& q, double r, std::vector<Neighbor>& out, std::size_t skip) const {
+    out.clear();
+    if (!(r >= 0.0) || m_points.empty()) return;
+    std::array<double, 3> offset {0.0, 0.0, 0.0};
+    auto keep = [&out](std::uint32_t index, double d2) { out.push_back({index, d2}); return true; };
+    visitWithin(0, m_points.size(), q, r * r, skip, offset, 0.0, keep);
+}
+
+std::size_t KdTree::countWithinRadius(const std::array<double, 3>& q, double r, std::size_t limit, std::size_t skip) const {
+    if (!(r >= 0.0) || m_points.empty() || limit == 0) return 0;
+    std::array<double, 3> offset {0.0, 0.0, 0.0};
+    std::size_t count = 0;
+    auto tally = [&count, limit](std::uint32_t, double) { return ++count < limit; };
+    visitWithin(0, m_points.size(), q, r * r, skip, offset, 0.0, tally);
+    return count;
+}
+
+KnnGraph buildKnnGraph(const PointCloud& pc, const KdTree& tree, std::size_t k) {
+    KnnGraph graph;
+    const std::size_t n = pc.size();
+    if (n < 2 || tree.size() != n || k == 0) return graph;
+
+    graph.degree = std::min(k, n - 1);
+    graph.targets.resize(n * graph.degree);
+    Parallel::forChunks(n, [&](std::size_t, std::size_t b, std::size_t e) {
+        std::vector<Neighbor> found;
+        for (std::size_t t = b; t < e; ++t) {
+            const std::size_t i = tree.order()[t];
+            const auto& p = pc[i].first;
+            tree.nearest({p.x(), p.y(), p.z()}, graph.degree, found, i);
+            std::uint32_t* row = graph.targets.data() + i * graph.degree;
+            std::size_t j = 0;
+            for (; j < found.size(); ++j) row[j] = found[j].index;
+            for (; j < graph.degree; ++j) row[j] = static_cast<std::uint32_t>(i);
+        }
+    }, 1024);
+    return graph;
+}
+
+double averageSpacing(const PointCloud& pc, const KdTree& tree, std::size_t k, std::size_t maxSamples) {
+    const std::size_t n = pc.size();
+    if (n == 0 || tree.size() != n || k == 0) return 0.0;
+    const std::size_t stride = maxSamples > 0 && n > maxSamples ? (n + maxSamples - 1) / maxSamples : 1;
+    const std::size_t samples = (n + stride - 1) / stride;
+
+    std::vector<double> partial(Parallel::chunkCount(samples, 1024), 0.0);
+    Parallel::forChunks(samples, [&](std::size_t c, std::size_t b, std::size_t e) {
+        std::vector<Neighbor> found;
+        for (std::size_t s = b; s < e; ++s) {
+            const std::size_t i = s * stride;
+            const auto& p = pc[i].first;
+            tree.nearest({p.x(), p.y(), p.z()}, k, found, i);
+            if (found.empty()) continue;
+            double sum = 0.0;
+            for (const auto& nb : found) sum += std::sqrt(nb.squaredDistance);
+            partial[c] += sum / static_cast<double>(found.size());
+        }
+    }, 1024);
+    double total = 0.0;
+    for (double v : partial) total += v;
+    return total / static_cast<double>(samples);
+}
+
+} // namespace NeighborSearch
@@ -0,0 +1,82 @@
+#ifndef POINTTOMESH_NEIGHBORSEARCH_H
+#define POINTTOMESH_NEIGHBORSEARCH_H
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "PointCloudProcessor.h"
+
+// Neighbour queries for the point-set passes that run per point in parallel (normal orientation, ...).
+// The kd-tree is implicit: points are reordered so every node is a contiguous range split at its middle
+// element, and only the split axis and value are stored. Building splits the top levels serially and the subtrees
+// in parallel; queries are const and safe to run from any number of threads.
+namespace NeighborSearch {
+
+struct Neighbor {
+    std::uint32_t index; // into the cloud the tree was built from
+    double squaredDistance;
+};
+
+class KdTree {
+public:
+    KdTree() = default;
+    explicit KdTree(const PointCloud& pc);
+
+    [[nodiscard]] std::size_t size() const { return m_points.size(); }
+    // Input indices in tree order; queries issued in this order touch the same nodes one after another
+    [[nodiscard]] const std::vector<std::uint32_t>& order() const { return m_index; }
+
+    // The k nearest points to q, closest first. `skip` (an input index) is left out of the result,
+    // which is how a point excludes itself from its own neighbourhood.
+    void nearest(const std::array<double, 3>& q, std::size_t k, std::vector<Neighbor>& out,
+                 std::size_t skip = static_cast<std::size_t>(-1)) const;
+
+    // All points within distance r of q, in no particular order; `skip` as for nearest()
+    void withinRadius(const std::array<double, 3>& q, double r, std::vector<Neighbor>& out,
+                      std::size_t skip = static_cast<std::size_t>(-1)) const;
+
+    // Number of points within distance r of q, `skip` excluded. Counting stops at `limit`, so callers
+    // that only compare against a threshold pay for threshold + 1 points at most.
+    [[nodiscard]] std::size_t countWithinRadius(const std::array<double, 3>& q, double r, std::size_t limit,
+                                                std::size_t skip = static_cast<std::size_t>(-1)) const;
+
+private:
+    static constexpr std::size_t kLeafSize = 16;
+
+    // offset[a]: per-axis distance from q to the current cell; cellDistance: its squared length
+    void search(std::size_t b, std::size_t e, const std::array<double, 3>& q, std::size_t k, std::size_t skip,
+                std::array<double, 3>& offset, double cellDistance, std::vector<Neighbor>& heap) const;
+    // Calls visit(index, squaredDistance) for every point within sqrt(r2) of q until it returns false;
+    // returns false once stopped
+    template <typename Visit>
+    bool visitWithin(std::size_t b, std::size_t e, const std::array<double, 3>& q, double r2, std::size_t skip,
+                     std::array<double, 3>& offset, double cellDistance, Visit& visit) const;
+
+    std::vector<std::array<double, 3>> m_points; // tree order
+    std::vector<std::uint32_t> m_index;          // tree order -> input index
+    // Split of each inner node, stored at its middle position. The value is kept separately because
+    // splitting the upper child moves other points into that position.
+    std::vector<std::uint8_t> m_axis;
+    std::vector<double> m_split;
+};
+
+// Directed k-nearest-neighbour graph: point i links to targets[i * degree, (i + 1) * degree).
+// Rows of points with fewer than `degree` neighbours (tiny clouds) are padded with i itself.
+struct KnnGraph {
+    std::size_t degree {0};
+    std::vector<std::uint32_t> targets;
+};
+
+// Queries all points in parallel; returns an empty graph if the cloud has fewer than two points
+KnnGraph buildKnnGraph(const PointCloud& pc, const KdTree& tree, std::size_t k);
+
+// Mean distance from a point to its k nearest neighbours, averaged over the cloud (what
+// CGAL::compute_average_spacing measures), queried in parallel on an existing tree. With maxSamples > 0
+// the average is taken over that many evenly strided points; a mean needs far fewer than millions.
+double averageSpacing(const PointCloud& pc, const KdTree& tree, std::size_t k, std::size_t maxSamples = 0);
+
+} // namespace NeighborSearch
+
+#endif //POINTTOMESH_NEIGHBORSEARCH_H
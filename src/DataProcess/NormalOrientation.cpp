@@ -0,0 +1,385 @@
+#include "NormalOrientation.h"
+#include "NeighborSearch.h"
+#include "Parallel.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <numeric>
+
+namespace NormalOrientation {
+
+namespace {
+constexpr std::uint64_t kNoEdge = std::numeric_limits<std::uint64_t>::max();
+// Candidate keys: quantised weight in the high bits, adjacency position in the low 40 bits
+constexpr int kPositionBits = 40;
+constexpr double kWeightLevels = double((1u << 23) - 1);
+
+using Unit = std::array<float, 3>;
+
+float weight(const Unit& a, const Unit& b) {
+    return 1.0f - std::fabs(a[0] * b[0] + a[1] * b[1] + a[2] * b[2]);
+}
+
+void flip(PointWithNormal& pn) {
+    const auto& n = pn.second;
+    pn.second = Vector(-n.x(), -n.y(), -n.z());
+}
+
+double dot(const Vector& n, const double r[3]) { return n.x() * r[0] + n.y() * r[1] + n.z() * r[2]; }
+
+// Union-find with union by size; find() never writes, so labels can be flattened from many threads
+struct Forest {
+    std::vector<std::uint32_t> parent;
+    std::vector<std::uint32_t> size;
+
+    explicit Forest(std::size_t n) : parent(n), size(n, 1) {
+        std::iota(parent.begin(), parent.end(), 0u);
+    }
+    [[nodiscard]] std::uint32_t find(std::uint32_t v) const {
+        while (parent[v] != v) v = parent[v];
+        return v;
+    }
+    bool unite(std::uint32_t a, std::uint32_t b) {
+        a = find(a);
+        b = find(b);
+        if (a == b) return false;
+        if (size[a] < size[b]) std::swap(a, b);
+        parent[b] = a;
+        size[a] += size[b];
+        return true;
+    }
+};
+
+// Indices in [0, count) that satisfy keep, ascending; evaluated in parallel chunks
+template <typename Keep>
+std::vector<std::uint32_t> selectIndices(std::size_t count, Keep keep) {
+    std::vector<std::vector<std::uint32_t>> parts(Parallel::chunkCount(count, 1024));
+    Parallel::forChunks(count, [&](std::size_t c, std::size_t b, std::size_t e) {
+        for (std::size_t x = b; x < e; ++x) if (keep(x)) parts[c].push_back(static_cast<std::uint32_t>(x));
+    }, 1024);
+    std::vector<std::uint32_t> out;
+    for (const auto& part : parts) out.insert(out.end(), part.begin(), part.end());
+    return out;
+}
+}
+
+bool orientParallelMst(PointCloud& pc, std::size_t k, Stats* stats) {
+    const std::size_t n = pc.size();
+    if (n < 2 || k == 0) return false;
+
+    const NeighborSearch::KdTree tree(pc);
+    const auto knn = NeighborSearch::buildKnnGraph(pc, tree, k);
+    if (knn.degree == 0) return false;
+    const std::size_t d = knn.degree;
+
+    std::vector<Unit> unit(n);
+    Parallel::forEach(n, [&](std::size_t i) {
+        const auto& v = pc[i].second;
+        const double len = std::sqrt(v.squared_length());
+        unit[i] = len > 0.0 ? Unit {float(v.x() / len), float(v.y() / len), float(v.z() / len)} : Unit {0.0f, 0.0f, 0.0f};
+    });
+
+    // Symmetrise: adjacency of i = its own k-NN row followed by the points that list i in theirs
+    std::vector<std::atomic<std::uint32_t>> incoming(n);
+    Parallel::forEach(n, [&](std::size_t i) { incoming[i].store(0, std::memory_order_relaxed); });
+    Parallel::forEach(n, [&](std::size_t i) {
+        for (std::size_t j = 0; j < d; ++j) {
+            const std::uint32_t t = knn.targets[i * d + j];
+            if (t != i) incoming[t].fetch_add(1, std::memory_order_relaxed);
+        }
+    }, 1024);
+    std::vector<std::size_t> offsets(n + 1, 0);
+    for (std::size_t i = 0; i < n; ++i) offsets[i + 1] = offsets[i] + d + incoming[i].load(std::memory_order_relaxed);
+    if (offsets[n] >= (std::uint64_t(1) << kPositionBits)) return false;
+
+    std::vector<std::uint32_t> adjacency(offsets[n]);
+    Parallel::forEach(n, [&](std::size_t i) {
+        std::copy_n(knn.targets.begin() + static_cast<std::ptrdiff_t>(i * d), d, adjacency.begin() + static_cast<std::ptrdiff_t>(offsets[i]));
+        incoming[i].store(0, std::memory_order_relaxed);
+    });
+    Parallel::forEach(n, [&](std::size_t i) {
+        for (std::size_t j = 0; j < d; ++j) {
+            const std::uint32_t t = knn.targets[i * d + j];
+            if (t == i) continue;
+            const std::size_t slot = offsets[t] + d + incoming[t].fetch_add(1, std::memory_order_relaxed);
+            adjacency[slot] = static_cast<std::uint32_t>(i);
+        }
+    }, 1024);
+
+    // Sort every adjacency list by weight once; each vertex then only moves a cursor past neighbours that
+    // joined its component, so all Borůvka rounds together scan every edge about once.
+    // Mutual neighbours appear twice in a list (own row and reverse link); after sorting the copies are
+    // adjacent, so distinct entries summed over all lists count every undirected edge exactly twice.
+    std::vector<std::size_t> distinctPerChunk(Parallel::chunkCount(n, 1024), 0);
+    Parallel::forChunks(n, [&](std::size_t chunk, std::size_t b, std::size_t e) {
+        std::vector<std::pair<float, std::uint32_t>> scratch;
+        std::size_t distinct = 0;
+        for (std::size_t i = b; i < e; ++i) {
+            scratch.clear();
+            for (std::size_t p = offsets[i]; p < offsets[i + 1]; ++p) {
+                if (adjacency[p] != i) scratch.emplace_back(weight(unit[i], unit[adjacency[p]]), adjacency[p]);
+            }
+            std::sort(scratch.begin(), scratch.end());
+            for (std::size_t s = 0; s < scratch.size(); ++s) distinct += s == 0 || scratch[s] != scratch[s - 1];
+            std::size_t p = offsets[i];
+            for (const auto& s : scratch) adjacency[p++] = s.second;
+            for (; p < offsets[i + 1]; ++p) adjacency[p] = static_cast<std::uint32_t>(i); // self entries last
+        }
+        distinctPerChunk[chunk] = distinct;
+    }, 1024);
+    std::size_t undirectedEdges = 0;
+    for (std::size_t c : distinctPerChunk) undirectedEdges += c;
+    undirectedEdges /= 2;
+    std::vector<std::atomic<std::uint32_t>>().swap(incoming);
+
+    Forest forest(n);
+    std::vector<std::uint32_t> label(n);
+    std::iota(label.begin(), label.end(), 0u);
+    std::vector<std::size_t> cursor(offsets.begin(), offsets.end() - 1);
+    std::vector<std::atomic<std::uint64_t>> best(n);
+    std::vector<std::pair<std::uint32_t, std::uint32_t>> treeEdges;
+    treeEdges.reserve(n);
+
+    std::size_t rounds = 0;
+    for (;;) {
+        ++rounds;
+        Parallel::forEach(n, [&](std::size_t i) { best[i].store(kNoEdge, std::memory_order_relaxed); });
+
+        // Every vertex proposes its cheapest edge leaving its component
+        Parallel::forEach(n, [&](std::size_t i) {
+            const std::uint32_t c = label[i];
+            std::size_t p = cursor[i];
+            const std::size_t end = offsets[i + 1];
+            while (p < end && label[adjacency[p]] == c) ++p;
+            cursor[i] = p;
+            if (p == end) return;
+            const auto q = static_cast<std::uint64_t>(weight(unit[i], unit[adjacency[p]]) * kWeightLevels);
+            const std::uint64_t key = (q << kPositionBits) | p;
+            auto& slot = best[c];
+            std::uint64_t current = slot.load(std::memory_order_relaxed);
+            while (key < current && !slot.compare_exchange_weak(current, key, std::memory_order_relaxed)) {}
+        }, 1024);
+
+        // Merge the proposals; two components may propose the same edge, the union-find drops the repeat
+        std::size_t merged = 0;
+        for (std::size_t c = 0; c < n; ++c) {
+            const std::uint64_t key = best[c].load(std::memory_order_relaxed);
+            if (key == kNoEdge) continue;
+            const std::size_t p = key & ((std::uint64_t(1) << kPositionBits) - 1);
+            const auto u = static_cast<std::uint32_t>(std::upper_bound(offsets.begin(), offsets.end(), p) - offsets.begin() - 1);
+            const std::uint32_t v = adjacency[p];
+            if (forest.unite(u, v)) {
+                treeEdges.emplace_back(u, v);
+                ++merged;
+            }
+        }
+        if (merged == 0) break;
+
+        Parallel::forEach(n, [&](std::size_t i) { label[i] = forest.find(static_cast<std::uint32_t>(i)); });
+        Parallel::forEach(n, [&](std::size_t i) { forest.parent[i] = label[i]; });
+    }
+    std::vector<std::uint32_t>().swap(adjacency);
+    std::vector<std::atomic<std::uint64_t>>().swap(best);
+
+    // Spanning forest as adjacency lists
+    std::vector<std::size_t> treeOffsets(n + 1, 0);
+    for (const auto& [u, v] : treeEdges) { ++treeOffsets[u + 1]; ++treeOffsets[v + 1]; }
+    for (std::size_t i = 0; i < n; ++i) treeOffsets[i + 1] += treeOffsets[i];
+    std::vector<std::uint32_t> treeAdjacency(treeOffsets[n]);
+    {
+        std::vector<std::size_t> fill(treeOffsets.begin(), treeOffsets.end() - 1);
+        for (const auto& [u, v] : treeEdges) { treeAdjacency[fill[u]++] = v; treeAdjacency[fill[v]++] = u; }
+    }
+
+    // Seed of every tree: its highest point that has a normal, turned towards +z
+    const auto hasNormal = [&](std::size_t i) { return unit[i][0] != 0.0f || unit[i][1] != 0.0f || unit[i][2] != 0.0f; };
+    std::vector<std::uint32_t> seedOf(n, std::numeric_limits<std::uint32_t>::max());
+    for (std::size_t i = 0; i < n; ++i) {
+        auto& s = seedOf[label[i]];
+        if (s == std::numeric_limits<std::uint32_t>::max() || hasNormal(i) > hasNormal(s) ||
+            (hasNormal(i) == hasNormal(s) && pc[i].first.z() > pc[s].first.z())) {
+            s = static_cast<std::uint32_t>(i);
+        }
+    }
+    std::vector<std::uint32_t> seeds;
+    for (std::size_t c = 0; c < n; ++c) if (seedOf[c] != std::numeric_limits<std::uint32_t>::max()) seeds.push_back(seedOf[c]);
+    std::vector<std::uint32_t>().swap(seedOf);
+
+    // Propagate along each tree; trees are independent, so they are walked as parallel tasks.
+    // A point without a normal passes its parent's reference on to its children.
+    std::atomic<std::size_t> flipped {0};
+    Parallel::forTasks(seeds.size(), [&](std::size_t t) {
+        struct Visit { std::uint32_t vertex, parent; Unit reference; };
+        std::vector<Visit> stack;
+        std::size_t localFlips = 0;
+        const std::uint32_t seed = seeds[t];
+        if (unit[seed][2] < 0.0f) {
+            flip(pc[seed]);
+            for (auto& x : unit[seed]) x = -x;
+            ++localFlips;
+        }
+        stack.push_back({seed, seed, unit[seed]});
+        while (!stack.empty()) {
+            const Visit at = stack.back();
+            stack.pop_back();
+            for (std::size_t p = treeOffsets[at.vertex]; p < treeOffsets[at.vertex + 1]; ++p) {
+                const std::uint32_t w = treeAdjacency[p];
+                if (w == at.parent) continue;
+                Unit& nw = unit[w];
+                const Unit& ref = at.reference;
+                if (ref[0] * nw[0] + ref[1] * nw[1] + ref[2] * nw[2] < 0.0f) {
+                    flip(pc[w]);
+                    for (auto& x : nw) x = -x;
+                    ++localFlips;
+                }
+                stack.push_back({w, at.vertex, hasNormal(w) ? nw : ref});
+            }
+        }
+        flipped.fetch_add(localFlips, std::memory_order_relaxed);
+    });
+
+    if (stats) {
+        stats->edges = undirectedEdges;
+        stats->rounds = rounds;
+        stats->components = seeds.size();
+        stats->flipped = flipped.load();
+    }
+    return true;
+}
+
+bool orientCentroidSign(PointCloud& pc, Stats* stats) {
+    const std::size_t n = pc.size();
+    if (n == 0) return false;
+
+    std::vector<std::array<double, 3>> partial(Parallel::chunkCount(n), {0.0, 0.0, 0.0});
+    Parallel::forChunks(n, [&](std::size_t c, std::size_t b, std::size_t e) {
+        for (std::size_t i = b; i < e; ++i) {
+            partial[c][0] += pc[i].first.x();
+            partial[c][1] += pc[i].first.y();
+            partial[c][2] += pc[i].first.z();
+        }
+    });
+    double centroid[3] = {0.0, 0.0, 0.0};
+    for (const auto& p : partial) for (int a = 0; a < 3; ++a) centroid[a] += p[a];
+    for (double& c : centroid) c /= static_cast<double>(n);
+
+    std::vector<std::size_t> flips(Parallel::chunkCount(n), 0);
+    Parallel::forChunks(n, [&](std::size_t c, std::size_t b, std::size_t e) {
+        for (std::size_t i = b; i < e; ++i) {
+            const auto& p = pc[i].first;
+            const double r[3] = {p.x() - centroid[0], p.y() - centroid[1], p.z() - centroid[2]};
+            if (dot(pc[i].second, r) < 0.0) { flip(pc[i]); ++flips[c]; }
+        }
+    });
+
+    if (stats) {
+        *stats = Stats {};
+        for (auto f : flips) stats->flipped += f;
+    }
+    return true;
+}
+
+bool orientTowardsTrusted(PointCloud& pc, const NeighborSearch::KdTree& tree, const std::vector<std::uint32_t>& targets,
+                          std::vector<std::uint8_t>& trusted, std::size_t k, Stats* stats) {
+    const std::size_t n = pc.size();
+    const std::size_t m = targets.size();
+    if (trusted.size() != n || tree.size() != n) return false;
+    if (stats) *stats = Stats {};
+    if (m == 0 || k == 0 || n < 2) return true;
+    const std::size_t d = std::min(k, n - 1);
+
+    // Neighbour rows of the targets only (padded with the target itself)
+    std::vector<std::uint32_t> rows(m * d);
+    Parallel::forChunks(m, [&](std::size_t, std::size_t b, std::size_t e) {
+        std::vector<NeighborSearch::Neighbor> found;
+        for (std::size_t a = b; a < e; ++a) {
+            const std::uint32_t i = targets[a];
+            const auto& p = pc[i].first;
+            tree.nearest({p.x(), p.y(), p.z()}, d, found, i);
+            std::uint32_t* row = rows.data() + a * d;
+            std::size_t j = 0;
+            for (; j < found.size(); ++j) row[j] = found[j].index;
+            for (; j < d; ++j) row[j] = i;
+        }
+    }, 1024);
+
+    // Reverse links between targets: dependents of target b are the targets whose rows contain b,
+    // i.e. the ones a wave may reach once b is oriented
+    std::vector<std::uint32_t> rowTarget(m * d);
+    Parallel::forEach(m * d, [&](std::size_t x) {
+        const auto it = std::lower_bound(targets.begin(), targets.end(), rows[x]);
+        rowTarget[x] = it != targets.end() && *it == rows[x] ? static_cast<std::uint32_t>(it - targets.begin())
+                                                             : static_cast<std::uint32_t>(m);
+    });
+    std::vector<std::size_t> offsets(m + 1, 0);
+    for (std::size_t x = 0; x < m * d; ++x) {
+        if (rowTarget[x] < m && rowTarget[x] != x / d) ++offsets[rowTarget[x] + 1];
+    }
+    for (std::size_t a = 0; a < m; ++a) offsets[a + 1] += offsets[a];
+    std::vector<std::uint32_t> dependents(offsets[m]);
+    {
+        std::vector<std::size_t> fill(offsets.begin(), offsets.end() - 1);
+        for (std::size_t x = 0; x < m * d; ++x) {
+            if (rowTarget[x] < m && rowTarget[x] != x / d) dependents[fill[rowTarget[x]]++] = static_cast<std::uint32_t>(x / d);
+        }
+    }
+    std::vector<std::uint32_t>().swap(rowTarget);
+
+    const auto orientable = [&](std::uint32_t i) { return !trusted[i] && pc[i].second.squared_length() > 0.0; };
+    std::vector<std::uint32_t> frontier = selectIndices(m, [&](std::size_t a) {
+        if (!orientable(targets[a])) return false;
+        return std::any_of(rows.begin() + static_cast<std::ptrdiff_t>(a * d), rows.begin() + static_cast<std::ptrdiff_t>((a + 1) * d),
+                           [&](std::uint32_t j) { return trusted[j] != 0; });
+    });
+    std::vector<std::uint8_t> queued(m, 0);
+    for (auto a : frontier) queued[a] = 1;
+
+    std::size_t rounds = 0, flipped = 0;
+    std::vector<std::uint8_t> turn;
+    std::vector<std::uint32_t> next;
+    while (!frontier.empty()) {
+        ++rounds;
+        // Decide the whole wave from the normals trusted before it, then commit
+        turn.assign(frontier.size(), 0);
+        Parallel::forEach(frontier.size(), [&](std::size_t f) {
+            const std::size_t a = frontier[f];
+            const Vector& ni = pc[targets[a]].second;
+            double agreement = 0.0;
+            for (std::size_t j = 0; j < d; ++j) {
+                const std::uint32_t t = rows[a * d + j];
+                if (!trusted[t]) continue;
+                const Vector& nt = pc[t].second;
+                const double len2 = nt.squared_length();
+                if (len2 > 0.0) agreement += (ni.x() * nt.x() + ni.y() * nt.y() + ni.z() * nt.z()) / std::sqrt(len2);
+            }
+            turn[f] = agreement < 0.0;
+        });
+        Parallel::forEach(frontier.size(), [&](std::size_t f) {
+            const std::uint32_t i = targets[frontier[f]];
+            if (turn[f]) flip(pc[i]);
+            trusted[i] = 1;
+        });
+        flipped += static_cast<std::size_t>(std::count(turn.begin(), turn.end(), std::uint8_t(1)));
+
+        next.clear();
+        for (auto a : frontier) {
+            for (std::size_t p = offsets[a]; p < offsets[a + 1]; ++p) {
+                const std::uint32_t w = dependents[p];
+                if (!queued[w] && orientable(targets[w])) { queued[w] = 1; next.push_back(w); }
+            }
+        }
+        frontier.swap(next);
+    }
+
+    if (stats) {
+        stats->rounds = rounds;
+        stats->flipped = flipped;
+        stats->unreached = static_cast<std::size_t>(std::count_if(targets.begin(), targets.end(), orientable));
+    }
+    return true;
+}
+
+} // namespace NormalOrientation
@@ -0,0 +1,46 @@
+#ifndef POINTTOMESH_NORMALORIENTATION_H
+#define POINTTOMESH_NORMALORIENTATION_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "PointCloudProcessor.h"
+
+namespace NeighborSearch { class KdTree; }
+
+// Orientation engines that replace CGAL::mst_orient_normals on large clouds.
+// - Parallel MST: the k-NN graph is queried in parallel, symmetrised, and reduced to a minimum spanning
+//   forest (weight 1 - |n_i · n_j|) with Borůvka rounds: every vertex proposes its cheapest edge leaving
+//   its component in parallel, the proposals are merged through a union-find, and labels are flattened in
+//   parallel. Orientation is then propagated along the forest from the highest point of each component,
+//   which is turned towards +z, as CGAL does.
+// - Centroid sign: every normal is flipped to point away from the cloud centroid. One parallel pass;
+//   only meaningful for closed, roughly star-shaped scans.
+// - Towards trusted: orients a subset of freshly estimated normals to agree with the normals around them
+//   that are already trusted, leaving those untouched. Work is proportional to the subset.
+namespace NormalOrientation {
+
+struct Stats {
+    std::size_t edges {0};      // undirected graph edges considered (MST only)
+    std::size_t rounds {0};     // Borůvka rounds (MST only)
+    std::size_t components {0}; // spanning trees, each oriented from its own seed (MST only)
+    std::size_t flipped {0};    // normals whose sign was changed
+    std::size_t unreached {0};  // targets with no trusted normal connected to them (towards trusted only)
+};
+
+// Returns false if the cloud is too small to build a neighbour graph
+bool orientParallelMst(PointCloud& pc, std::size_t k, Stats* stats = nullptr);
+
+bool orientCentroidSign(PointCloud& pc, Stats* stats = nullptr);
+
+// Orients the normals of `targets` (input indices, ascending) against `trusted` (one flag per point).
+// Each target takes the sign that agrees with the trusted normals among its k nearest neighbours; targets
+// with none wait for a wave of oriented neighbours to reach them, and are marked trusted once oriented.
+// `tree` must be built over pc. Returns false if pc and trusted differ in size.
+bool orientTowardsTrusted(PointCloud& pc, const NeighborSearch::KdTree& tree, const std::vector<std::uint32_t>& targets,
+                          std::vector<std::uint8_t>& trusted, std::size_t k, Stats* stats = nullptr);
+
+} // namespace NormalOrientation
+
+#endif //POINTTOMESH_NORMALORIENTATION_H
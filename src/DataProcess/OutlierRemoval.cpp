@@ -0,0 +1,68 @@
+#include "OutlierRemoval.h"
+#include "NeighborSearch.h"
+#include "Parallel.h"
+
+#include <cmath>
+
+namespace OutlierRemoval {
+
+std::vector<char> statistical(const PointCloud& pc, const NeighborSearch::KdTree& tree, std::size_t k, double stdRatio,
+                              StatisticalStats* stats) {
+    const std::size_t n = pc.size();
+    std::vector<char> keep(n, 1);
+    if (n < 2 || k == 0 || tree.size() != n) return keep;
+
+    // Mean k-NN distance per point; the first reduction gives the mean over the cloud
+    std::vector<double> meanDistance(n, 0.0);
+    std::vector<double> partial(Parallel::chunkCount(n, 1024), 0.0);
+    Parallel::forChunks(n, [&](std::size_t c, std::size_t b, std::size_t e) {
+        std::vector<NeighborSearch::Neighbor> found;
+        for (std::size_t t = b; t < e; ++t) {
+            const std::size_t i = tree.order()[t];
+            const auto& p = pc[i].first;
+            tree.nearest({p.x(), p.y(), p.z()}, k, found, i);
+            double sum = 0.0;
+            for (const auto& nb : found) sum += std::sqrt(nb.squaredDistance);
+            meanDistance[i] = found.empty() ? 0.0 : sum / static_cast<double>(found.size());
+            partial[c] += meanDistance[i];
+        }
+    }, 1024);
+    double mean = 0.0;
+    for (double v : partial) mean += v;
+    mean /= static_cast<double>(n);
+
+    // Second pass for the spread, about the mean (no cancellation between large sums)
+    std::vector<double> squares(Parallel::chunkCount(n), 0.0);
+    Parallel::forChunks(n, [&](std::size_t c, std::size_t b, std::size_t e) {
+        for (std::size_t i = b; i < e; ++i) squares[c] += (meanDistance[i] - mean) * (meanDistance[i] - mean);
+    });
+    double variance = 0.0;
+    for (double v : squares) variance += v;
+    const double sigma = std::sqrt(variance / static_cast<double>(n - 1));
+    const double threshold = mean + stdRatio * sigma;
+
+    Parallel::forEach(n, [&](std::size_t i) { keep[i] = meanDistance[i] <= threshold; });
+    if (stats) {
+        stats->meanDistance = mean;
+        stats->sigma = sigma;
+        stats->threshold = threshold;
+    }
+    return keep;
+}
+
+std::vector<char> radius(const PointCloud& pc, const NeighborSearch::KdTree& tree, double radius, std::size_t minNeighbors) {
+    const std::size_t n = pc.size();
+    std::vector<char> keep(n, 1);
+    if (minNeighbors == 0 || tree.size() != n) return keep;
+
+    Parallel::forChunks(n, [&](std::size_t, std::size_t b, std::size_t e) {
+        for (std::size_t t = b; t < e; ++t) {
+            const std::size_t i = tree.order()[t];
+            const auto& p = pc[i].first;
+            keep[i] = tree.countWithinRadius({p.x(), p.y(), p.z()}, radius, minNeighbors, i) >= minNeighbors;
+        }
+    }, 1024);
+    return keep;
+}
+
+} // namespace OutlierRemoval
@@ -0,0 +1,32 @@
+#ifndef POINTTOMESH_OUTLIERREMOVAL_H
+#define POINTTOMESH_OUTLIERREMOVAL_H
+
+#include <cstddef>
+#include <vector>
+
+#include "PointCloudProcessor.h"
+
+namespace NeighborSearch { class KdTree; }
+
+// Outlier classification for scanner noise. Both tests query a kd-tree built over the cloud from
+// parallel chunks in tree order and return one keep flag per point (input order); the caller compacts.
+// - Statistical: the mean distance of every point to its k nearest neighbours is compared with the
+//   distribution of that mean over the cloud; points beyond mean + stdRatio * sigma are outliers.
+// - Radius: points with fewer than minNeighbors other points within the radius are outliers. Counting
+//   stops at minNeighbors, so dense regions cost a few leaves per point.
+namespace OutlierRemoval {
+
+struct StatisticalStats {
+    double meanDistance {0.0}; // over all points of their mean k-NN distance
+    double sigma {0.0};
+    double threshold {0.0};    // meanDistance + stdRatio * sigma
+};
+
+std::vector<char> statistical(const PointCloud& pc, const NeighborSearch::KdTree& tree, std::size_t k, double stdRatio,
+                              StatisticalStats* stats = nullptr);
+
+std::vector<char> radius(const PointCloud& pc, const NeighborSearch::KdTree& tree, double radius, std::size_t minNeighbors);
+
+} // namespace OutlierRemoval
+
+#endif //POINTTOMESH_OUTLIERREMOVAL_H
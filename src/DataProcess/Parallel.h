@@ -0,0 +1,102 @@
+#ifndef POINTTOMESH_PARALLEL_H
+#define POINTTOMESH_PARALLEL_H
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Minimal fork/join helpers built on std::thread.
+// Work is split into contiguous index ranges so callers can keep per-chunk scratch
+// buffers and partial results without any locking; the first exception thrown by
+// a worker is rethrown on the calling thread after all workers have joined.
+namespace Parallel {
+
+inline unsigned threadCount() {
+    const unsigned hc = std::thread::hardware_concurrency();
+    return hc == 0 ? 1u : hc;
+}
+
+// Number of chunks forChunks() splits n items into (never more than threadCount()).
+inline std::size_t chunkCount(std::size_t n, std::size_t minChunk = 4096) {
+    if (n == 0) return 0;
+    const std::size_t byGrain = (n + std::max<std::size_t>(1, minChunk) - 1) / std::max<std::size_t>(1, minChunk);
+    return std::max<std::size_t>(1, std::min<std::size_t>(threadCount(), byGrain));
+}
+
+// Run fn(chunk, begin, end) for chunkCount(n, minChunk) contiguous ranges covering [0, n).
+// Chunk indices are dense in [0, chunkCount(n, minChunk)), so per-chunk results can be
+// stored in a vector sized with chunkCount() and reduced afterwards.
+template <class Fn>
+void forChunks(std::size_t n, Fn&& fn, std::size_t minChunk = 4096) {
+    const std::size_t chunks = chunkCount(n, minChunk);
+    if (chunks == 0) return;
+    const std::size_t step = (n + chunks - 1) / chunks;
+    if (chunks == 1) { fn(std::size_t(0), std::size_t(0), n); return; }
+
+    std::exception_ptr error;
+    std::mutex errorMutex;
+    auto run = [&](std::size_t c) {
+        const std::size_t b = c * step;
+        const std::size_t e = std::min(n, b + step);
+        if (b >= e) return;
+        try {
+            fn(c, b, e);
+        } catch (...) {
+            std::lock_guard<std::mutex> lock(errorMutex);
+            if (!error) error = std::current_exception();
+        }
+    };
+
+    std::vector<std::thread> threads;
+    threads.reserve(chunks - 1);
+    for (std::size_t c = 1; c < chunks; ++c) threads.emplace_back(run, c);
+    run(0);
+    for (auto& t : threads) t.join();
+    if (error) std::rethrow_exception(error);
+}
+
+// Run fn(i) for every i in [0, n).
+template <class Fn>
+void forEach(std::size_t n, Fn&& fn, std::size_t minChunk = 4096) {
+    forChunks(n, [&fn](std::size_t, std::size_t b, std::size_t e) {
+        for (std::size_t i = b; i < e; ++i) fn(i);
+    }, minChunk);
+}
+
+// Dynamic scheduling for a small number of heavy, uneven tasks (tiles, holes, ...):
+// up to maxThreads workers (0 = threadCount()) pull task indices from a shared counter.
+template <class Fn>
+void forTasks(std::size_t n, Fn&& fn, unsigned maxThreads = 0) {
+    if (n == 0) return;
+    const unsigned limit = maxThreads == 0 ? threadCount() : maxThreads;
+    const std::size_t workers = std::max<std::size_t>(1, std::min<std::size_t>(limit, n));
+
+    std::atomic<std::size_t> next {0};
+    std::exception_ptr error;
+    std::mutex errorMutex;
+    auto run = [&]() {
+        for (std::size_t i = next.fetch_add(1); i < n; i = next.fetch_add(1)) {
+            try {
+                fn(i);
+            } catch (...) {
+                std::lock_guard<std::mutex> lock(errorMutex);
+                if (!error) error = std::current_exception();
+            }
+        }
+    };
+
+    std::vector<std::thread> threads;
+    threads.reserve(workers - 1);
+    for (std::size_t w = 1; w < workers; ++w) threads.emplace_back(run);
+    run();
+    for (auto& t : threads) t.join();
+    if (error) std::rethrow_exception(error);
+}
+
+} // namespace Parallel
+
+#endif //POINTTOMESH_PARALLEL_H
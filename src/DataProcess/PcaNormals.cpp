@@ -0,0 +1,192 @@
+#include "PcaNormals.h"
+#include "NeighborSearch.h"
+#include "Parallel.h"
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define POINTTOMESH_PCA_SSE2 1
+#endif
+
+namespace PcaNormals {
+
+namespace {
+// Sums over m offsets: x, y, z, xx, xy, xz, yy, yz, zz
+using Moments = std::array<double, 9>;
+
+Moments accumulate(const double* x, const double* y, const double* z, std::size_t m) {
+    Moments s {};
+    std::size_t i = 0;
+#ifdef POINTTOMESH_PCA_SSE2
+    __m128d sx = _mm_setzero_pd(), sy = _mm_setzero_pd(), sz = _mm_setzero_pd();
+    __m128d sxx = _mm_setzero_pd(), sxy = _mm_setzero_pd(), sxz = _mm_setzero_pd();
+    __m128d syy = _mm_setzero_pd(), syz = _mm_setzero_pd(), szz = _mm_setzero_pd();
+    for (; i + 2 <= m; i += 2) {
+        const __m128d vx = _mm_loadu_pd(x + i), vy = _mm_loadu_pd(y + i), vz = _mm_loadu_pd(z + i);
+        sx = _mm_add_pd(sx, vx);
+        sy = _mm_add_pd(sy, vy);
+        sz = _mm_add_pd(sz, vz);
+        sxx = _mm_add_pd(sxx, _mm_mul_pd(vx, vx));
+        sxy = _mm_add_pd(sxy, _mm_mul_pd(vx, vy));
+        sxz = _mm_add_pd(sxz, _mm_mul_pd(vx, vz));
+        syy = _mm_add_pd(syy, _mm_mul_pd(vy, vy));
+        syz = _mm_add_pd(syz, _mm_mul_pd(vy, vz));
+        szz = _mm_add_pd(szz, _mm_mul_pd(vz, vz));
+    }
+    const __m128d lanes[9] = {sx, sy, sz, sxx, sxy, sxz, syy, syz, szz};
+    for (int c = 0; c < 9; ++c) {
+        double pair[2];
+        _mm_storeu_pd(pair, lanes[c]);
+        s[c] = pair[0] + pair[1];
+    }
+#endif
+    // Scalar tail (or the whole range without SSE2; compilers vectorise this loop for other targets)
+    for (; i < m; ++i) {
+        s[0] += x[i]; s[1] += y[i]; s[2] += z[i];
+        s[3] += x[i] * x[i]; s[4] += x[i] * y[i]; s[5] += x[i] * z[i];
+        s[6] += y[i] * y[i]; s[7] += y[i] * z[i]; s[8] += z[i] * z[i];
+    }
+    return s;
+}
+
+std::array<double, 3> cross(const std::array<double, 3>& a, const std::array<double, 3>& b) {
+    return {a[1] * b[2] - a[2] * b[1], a[2] * b[0] - a[0] * b[2], a[0] * b[1] - a[1] * b[0]};
+}
+
+double squaredNorm(const std::array<double, 3>& a) { return a[0] * a[0] + a[1] * a[1] + a[2] * a[2]; }
+
+std::array<double, 3> normalized(const std::array<double, 3>& a) {
+    const double len = std::sqrt(squaredNorm(a));
+    return {a[0] / len, a[1] / len, a[2] / len};
+}
+}
+
+std::array<double, 3> smallestEigenvector(const std::array<double, 6>& c) {
+    // Scale to unit magnitude so the cubic and the cross products stay well inside double range
+    double scale = 0.0;
+    for (double v : c) scale = std::max(scale, std::fabs(v));
+    if (!(scale > 0.0)) return {0.0, 0.0, 1.0};
+    const double a00 = c[0] / scale, a01 = c[1] / scale, a02 = c[2] / scale;
+    const double a11 = c[3] / scale, a12 = c[4] / scale, a22 = c[5] / scale;
+
+    // Smallest eigenvalue, trigonometric solution of the characteristic cubic
+    double lambda;
+    const double off = a01 * a01 + a02 * a02 + a12 * a12;
+    if (off <= 1e-30) {
+        lambda = std::min({a00, a11, a22});
+    } else {
+        const double q = (a00 + a11 + a22) / 3.0;
+        const double b00 = a00 - q, b11 = a11 - q, b22 = a22 - q;
+        const double p = std::sqrt((b00 * b00 + b11 * b11 + b22 * b22 + 2.0 * off) / 6.0);
+        const double det = b00 * (b11 * b22 - a12 * a12) - a01 * (a01 * b22 - a12 * a02) + a02 * (a01 * a12 - b11 * a02);
+        const double r = std::clamp(det / (2.0 * p * p * p), -1.0, 1.0);
+        const double phi = std::acos(r) / 3.0;
+        constexpr double kTwoThirdsPi = 2.0943951023931957;
+        lambda = q + 2.0 * p * std::cos(phi + kTwoThirdsPi);
+    }
+
+    // The eigenvector is orthogonal to the rows of A - λI: take the best-conditioned cross product
+    const std::array<double, 3> r0 {a00 - lambda, a01, a02};
+    const std::array<double, 3> r1 {a01, a11 - lambda, a12};
+    const std::array<double, 3> r2 {a02, a12, a22 - lambda};
+    std::array<double, 3> best = cross(r0, r1);
+    double bestNorm = squaredNorm(best);
+    for (const auto& v : {cross(r0, r2), cross(r1, r2)}) {
+        const double n = squaredNorm(v);
+        if (n > bestNorm) { best = v; bestNorm = n; }
+    }
+    if (bestNorm > 1e-20) return normalized(best);
+
+    // Rank <= 1 (the smallest eigenvalue is repeated): any direction orthogonal to the remaining row
+    std::array<double, 3> row = r0;
+    for (const auto& v : {r1, r2}) if (squaredNorm(v) > squaredNorm(row)) row = v;
+    if (squaredNorm(row) <= 1e-20) return {0.0, 0.0, 1.0};
+    const std::array<double, 3> axis = std::fabs(row[0]) < 0.9 * std::sqrt(squaredNorm(row)) ? std::array<double, 3> {1.0, 0.0, 0.0}
+                                                                                            : std::array<double, 3> {0.0, 1.0, 0.0};
+    return normalized(cross(row, axis));
+}
+
+namespace {
+bool validOptions(const Options& options) {
+    return options.radius > 0.0 || options.neighbors >= 1;
+}
+
+// Estimates the normals of the points indexAt(0) ... indexAt(count - 1) against the whole tree
+template <typename IndexAt>
+void estimatePoints(PointCloud& pc, const NeighborSearch::KdTree& tree, std::size_t count, IndexAt indexAt,
+                    const Options& options, Stats* stats) {
+    const bool byRadius = options.radius > 0.0;
+    const std::size_t chunks = Parallel::chunkCount(count, 1024);
+    std::vector<std::size_t> neighborTotals(chunks, 0), degenerate(chunks, 0);
+
+    Parallel::forChunks(count, [&](std::size_t chunk, std::size_t b, std::size_t e) {
+        std::vector<NeighborSearch::Neighbor> found;
+        std::vector<double> xs, ys, zs;
+        for (std::size_t t = b; t < e; ++t) {
+            const std::size_t i = indexAt(t);
+            const auto& p = pc[i].first;
+            const std::array<double, 3> q {p.x(), p.y(), p.z()};
+
+            // The neighbourhood includes the point itself
+            if (!byRadius) {
+                tree.nearest(q, static_cast<std::size_t>(options.neighbors), found);
+            } else if (options.maxNeighbors > 0) {
+                tree.nearest(q, static_cast<std::size_t>(options.maxNeighbors), found);
+                const double r2 = options.radius * options.radius;
+                found.erase(std::find_if(found.begin(), found.end(), [r2](const auto& nb) { return nb.squaredDistance > r2; }), found.end());
+            } else {
+                tree.withinRadius(q, options.radius, found);
+            }
+            neighborTotals[chunk] += found.size();
+            if (found.size() < 3) {
+                pc[i].second = Vector(0.0, 0.0, 0.0);
+                ++degenerate[chunk];
+                continue;
+            }
+
+            // Offsets from the query point, so the one-pass moments do not lose precision far from the origin
+            const std::size_t m = found.size();
+            xs.resize(m); ys.resize(m); zs.resize(m);
+            for (std::size_t j = 0; j < m; ++j) {
+                const auto& nb = pc[found[j].index].first;
+                xs[j] = nb.x() - q[0];
+                ys[j] = nb.y() - q[1];
+                zs[j] = nb.z() - q[2];
+            }
+            const Moments s = accumulate(xs.data(), ys.data(), zs.data(), m);
+            const double inv = 1.0 / static_cast<double>(m);
+            const double mx = s[0] * inv, my = s[1] * inv, mz = s[2] * inv;
+            const std::array<double, 6> cov {s[3] * inv - mx * mx, s[4] * inv - mx * my, s[5] * inv - mx * mz,
+                                             s[6] * inv - my * my, s[7] * inv - my * mz, s[8] * inv - mz * mz};
+            const auto normal = smallestEigenvector(cov);
+            pc[i].second = Vector(normal[0], normal[1], normal[2]);
+        }
+    }, 1024);
+
+    if (stats) {
+        std::size_t total = 0;
+        stats->degenerate = 0;
+        for (std::size_t c = 0; c < chunks; ++c) { total += neighborTotals[c]; stats->degenerate += degenerate[c]; }
+        stats->meanNeighbors = count > 0 ? static_cast<double>(total) / static_cast<double>(count) : 0.0;
+    }
+}
+}
+
+bool estimate(PointCloud& pc, const Options& options, Stats* stats) {
+    if (pc.empty() || !validOptions(options)) return false;
+    const NeighborSearch::KdTree tree(pc);
+    estimatePoints(pc, tree, pc.size(), [&](std::size_t t) { return tree.order()[t]; }, options, stats);
+    return true;
+}
+
+bool estimate(PointCloud& pc, const NeighborSearch::KdTree& tree, const std::vector<std::uint32_t>& subset,
+              const Options& options, Stats* stats) {
+    if (pc.empty() || tree.size() != pc.size() || !validOptions(options)) return false;
+    estimatePoints(pc, tree, subset.size(), [&](std::size_t t) { return subset[t]; }, options, stats);
+    return true;
+}
+
+} // namespace PcaNormals
@@ -31,9 +31,20 @@ enum class NormalEstimationMethod {
     JET_ESTIMATION, // Default method using jet fitting for near-surface point sets
     UNIFORM_VOLUME_CENTROID, // New: for uniformly distributed points inside a region (centroid gradient)
     VCM_ESTIMATION, // New: Voronoi Covariance Measure-based normal estimation
+    PCA_ESTIMATION, // New: plane fit (smallest covariance eigenvector), parallel; for dense low-noise scans
     // Future methods like MLS can be added here
 };
 
+/**
+ * @enum NormalOrientationMethod
+ * @brief Defines how estimated normals are given a consistent sign.
+ */
+enum class NormalOrientationMethod {
+    MST_CGAL, // CGAL::mst_orient_normals (single-threaded Riemannian graph + Boost MST)
+    PARALLEL_MST, // New: parallel k-NN graph + Borůvka spanning forest, propagated from the highest point
+    CENTROID_SIGN, // New: point away from the cloud centroid (closed scans only)
+};
+
 /**
  * @enum MeshGenerationMethod
  * @brief Defines the available algorithms for mesh generation from point clouds.
@@ -42,11 +53,25 @@ enum class MeshGenerationMethod {
     POISSON_RECONSTRUCTION, // Default method using Poisson reconstruction
     SCALE_SPACE_RECONSTRUCTION, // CGAL Scale-Space Surface Reconstruction 3
     ADVANCING_FRONT_RECONSTRUCTION, // CGAL Advancing Front Surface Reconstruction
+    SCREENED_POISSON_RECONSTRUCTION, // New: sparse-lattice screened Poisson with cascadic CG and marching cubes
+    VOXEL_RECONSTRUCTION, // New: occupancy voxels + marching cubes for volume-filling point sets (no normals)
+};
+
+/**
+ * @enum PointSetResamplingMethod
+ * @brief Point set simplification / smoothing run before reconstruction, each with its own parameter class.
+ */
+enum class PointSetResamplingMethod {
+    HIERARCHY_SIMPLIFY, // CGAL hierarchy clustering: keeps more points where the surface varies (HierarchySimplifyParameter)
+    WLOP_SIMPLIFY, // CGAL weighted locally optimal projection: denoised, evenly spread subset (WLOPSimplifyParameter)
+    BILATERAL_SMOOTHING, // CGAL bilateral smoothing: denoises along normals, keeps sharp edges (BilateralSmoothingParameter)
 };
 
 // Make enums available to Qt meta-object system for queued connections
 Q_DECLARE_METATYPE(MeshGenerationMethod)
 Q_DECLARE_METATYPE(NormalEstimationMethod)
+Q_DECLARE_METATYPE(NormalOrientationMethod)
+Q_DECLARE_METATYPE(PointSetResamplingMethod)
 
 /**
  * @class PointCloudProcessor
@@ -70,9 +95,10 @@ public:
     /**
      * @brief Estimates normals for the loaded point cloud.
      * @param normalMethod The algorithm to use for normal estimation.
+     * @param params Optional NormalEstimationParameter (may be null for defaults). Ownership is not taken here.
      * @return True if normal estimation was successful, false otherwise.
      */
-    virtual bool estimateNormals(NormalEstimationMethod normalMethod) = 0;
+    virtual bool estimateNormals(NormalEstimationMethod normalMethod, const BaseInputParameter* params) = 0;
 
     /**
      * @brief Processes the loaded point cloud into a mesh with the given parameters.
@@ -97,11 +123,16 @@ public:
     [[nodiscard]] virtual const PointCloud& getPointCloud() const = 0;
 
     /**
-     * @brief Checks if the point cloud has associated normals.
-     * @return True if normals are present, false otherwise.
+     * @brief Checks if every point of the cloud has a valid (finite, non-zero) normal.
+     * @return True if no normal is missing, false otherwise (including an empty cloud).
      */
     [[nodiscard]] virtual bool hasNormals() const = 0;
 
+    /**
+     * @brief Number of points without a valid normal; these are what an only_missing estimation repairs.
+     */
+    [[nodiscard]] virtual std::size_t missingNormalCount() const = 0;
+
     /**
      * @brief Provides access to the internal mesh data.
      * @return A const reference to the mesh.
@@ -115,15 +146,28 @@ public:
      */
     virtual bool computeMeshNormals() = 0;
 
+    /**
+     * @brief Re-orient the current normals so their signs are consistent.
+     *        Parameters are provided via NormalOrientationParameter cast from BaseInputParameter.
+     */
+    virtual bool orientNormals(const BaseInputParameter* params) = 0;
+
     // --- New: Point cloud utilities ---
 
     /**
-     * @brief Downsample the point cloud using a voxel grid (CGAL grid simplification).
+     * @brief Downsample the point cloud to one point per occupied voxel (centroid, first, random or closest to center).
      *        Parameters are provided via VoxelDownsampleParameter cast from BaseInputParameter.
      * @return True if downsampling succeeded and the point cloud was modified.
      */
     virtual bool downsampleVoxel(const BaseInputParameter* params) = 0;
 
+    /**
+     * @brief Simplify or smooth the point set while keeping features (hierarchy clustering, WLOP, bilateral).
+     * @param method The resampling algorithm; params must be the matching parameter class.
+     * @return True if the point cloud was modified.
+     */
+    virtual bool resamplePointSet(PointSetResamplingMethod method, const BaseInputParameter* params) = 0;
+
     /**
      * @brief Keep or remove points based on an axis-aligned bounding box.
      *        Parameters are provided via AABBFilterParameter cast from BaseInputParameter.
@@ -136,6 +180,25 @@ public:
      */
     virtual bool filterSphere(const BaseInputParameter* params) = 0;
 
+    /**
+     * @brief Keep or remove points based on an oriented box (center, Euler rotation, half extents).
+     *        Parameters are provided via OrientedBoxFilterParameter cast from BaseInputParameter.
+     */
+    virtual bool filterOrientedBox(const BaseInputParameter* params) = 0;
+
+    /**
+     * @brief Keep the points on one side of a plane n·p + d = 0 (e.g. the render view's clip plane).
+     *        Parameters are provided via HalfSpaceFilterParameter cast from BaseInputParameter.
+     */
+    virtual bool filterHalfSpace(const BaseInputParameter* params) = 0;
+
+    /**
+     * @brief Keep or remove points flagged in a per-point selection mask.
+     *        Parameters are provided via SelectionMaskFilterParameter cast from BaseInputParameter.
+     *        Fails if the mask size does not match the current point cloud.
+     */
+    virtual bool filterByMask(const BaseInputParameter* params) = 0;
+
     /**
      * @brief Classify and keep surface points from a uniformly distributed volume point set.
      *        Parameters are provided via UniformVolumeSurfaceFilterParameter cast from BaseInputParameter.
@@ -143,6 +206,13 @@ public:
      */
     virtual bool filterSurfaceFromUniformVolume(const BaseInputParameter* params) = 0;
 
+    /**
+     * @brief Remove isolated points: statistical (mean k-NN distance against the cloud-wide mean + std_ratio × sigma)
+     *        or radius count (fewer than min_neighbors within the radius).
+     *        Parameters are provided via OutlierRemovalParameter cast from BaseInputParameter.
+     */
+    virtual bool removeOutliers(const BaseInputParameter* params) = 0;
+
     // --- New: Mesh post-processing ---
 
     /**
@@ -150,6 +220,24 @@ public:
      *        Parameters are provided via MeshPostprocessParameter cast from BaseInputParameter.
      */
     virtual bool postProcessMesh(const BaseInputParameter* params) = 0;
+
+    /**
+     * @brief Cut the mesh along a plane and keep one side (faces crossing the plane are split).
+     *        Parameters are provided via HalfSpaceFilterParameter cast from BaseInputParameter.
+     */
+    virtual bool clipMesh(const BaseInputParameter* params) = 0;
+
+    /**
+     * @brief Simplify the mesh by quadric-error (Garland-Heckbert) edge collapse down to a face budget.
+     *        Parameters are provided via MeshDecimationParameter cast from BaseInputParameter.
+     */
+    virtual bool decimateMesh(const BaseInputParameter* params) = 0;
+
+    /**
+     * @brief Drain informational messages (progress, statistics) produced by the last operations.
+     *        Errors are still reported through the boolean results and std::cerr.
+     */
+    virtual std::vector<std::string> takeMessages() = 0;
 };
 
 #endif //POINTTOMESH_POINTCLOUDPROCESSOR_H
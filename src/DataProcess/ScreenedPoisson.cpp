@@ -0,0 +1,358 @@
+#include "ScreenedPoisson.h"
+#include "MarchingCubes.h"
+#include "Parallel.h"
+#include "SparseGrid.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+
+namespace ScreenedPoisson {
+
+namespace {
+using SparseGrid::BrickLayout;
+
+// Margin around the cloud, relative to its largest extent, so the band never touches the domain border
+constexpr double kPadding = 0.1;
+// Marching cubes only visits cells within this many nodes of a sample; farther iso-crossings are
+// artefacts of the band boundary, not data
+constexpr int kTrimRings = 2;
+// Minimum work per chunk for the node loops
+constexpr std::size_t kMinChunk = 2048;
+
+struct Samples {
+    std::vector<double> p[3];
+    std::vector<double> n[3];
+    [[nodiscard]] std::size_t size() const { return p[0].size(); }
+};
+
+struct Domain {
+    double origin[3] {0.0, 0.0, 0.0};
+    double side {0.0};
+};
+
+struct Level {
+    int res {0};
+    double h {0.0};
+    BrickLayout layout;
+    std::vector<float> weight; // splatted sample weight per node
+    std::vector<float> rhs;
+    std::vector<float> diag;
+    std::vector<float> x;
+};
+
+// Cell containing a sample and its trilinear coordinates inside that cell
+struct Footprint {
+    int base[3] {0, 0, 0};
+    double t[3] {0.0, 0.0, 0.0};
+
+    [[nodiscard]] double weight(int corner) const {
+        double w = 1.0;
+        for (int a = 0; a < 3; ++a) w *= ((corner >> a) & 1) ? t[a] : 1.0 - t[a];
+        return w;
+    }
+};
+
+Footprint footprint(const Samples& s, std::size_t i, const Domain& d, const Level& lv) {
+    Footprint f;
+    for (int a = 0; a < 3; ++a) {
+        const double u = (s.p[a][i] - d.origin[a]) / lv.h;
+        f.base[a] = std::clamp(static_cast<int>(std::floor(u)), 0, lv.res - 1);
+        f.t[a] = std::clamp(u - f.base[a], 0.0, 1.0);
+    }
+    return f;
+}
+
+std::int64_t cornerIndex(const BrickLayout& layout, const Footprint& f, int corner) {
+    return layout.index(f.base[0] + (corner & 1), f.base[1] + ((corner >> 1) & 1), f.base[2] + ((corner >> 2) & 1));
+}
+
+double dot(const std::vector<float>& a, const std::vector<float>& b) {
+    std::vector<double> partial(Parallel::chunkCount(a.size(), kMinChunk), 0.0);
+    Parallel::forChunks(a.size(), [&](std::size_t c, std::size_t lo, std::size_t hi) {
+        double s = 0.0;
+        for (std::size_t i = lo; i < hi; ++i) s += static_cast<double>(a[i]) * b[i];
+        partial[c] = s;
+    }, kMinChunk);
+    double s = 0.0;
+    for (double p : partial) s += p;
+    return s;
+}
+
+// Splat samples, then assemble the right-hand side and the diagonal of one level
+void buildLevel(const Samples& s, const Domain& d, const Options& o, Level& lv) {
+    lv.layout = BrickLayout(lv.res);
+    std::vector<std::int32_t> brickOf(s.size());
+    for (std::size_t i = 0; i < s.size(); ++i) {
+        const Footprint f = footprint(s, i, d, lv);
+        lv.layout.markNode(f.base[0], f.base[1], f.base[2]);
+    }
+    lv.layout.dilate(1); // the cell's upper corners and a margin for the indicator to settle
+    lv.layout.build();
+    const std::size_t n = lv.layout.nodeCount();
+
+    // Bucket samples by the brick holding their cell's minimum corner
+    Parallel::forEach(s.size(), [&](std::size_t i) {
+        const Footprint f = footprint(s, i, d, lv);
+        constexpr int bits = BrickLayout::kBits;
+        brickOf[i] = lv.layout.slotOf(f.base[0] >> bits, f.base[1] >> bits, f.base[2] >> bits);
+    });
+    std::vector<std::size_t> offsets(lv.layout.brickCount() + 1, 0);
+    for (auto b : brickOf) ++offsets[static_cast<std::size_t>(b) + 1];
+    for (std::size_t b = 1; b < offsets.size(); ++b) offsets[b] += offsets[b - 1];
+    std::vector<std::size_t> order(s.size());
+    {
+        std::vector<std::size_t> fill(offsets.begin(), offsets.end() - 1);
+        for (std::size_t i = 0; i < s.size(); ++i) order[fill[static_cast<std::size_t>(brickOf[i])]++] = i;
+    }
+
+    // A sample writes to its brick and the +1 neighbours only, so bricks with the same coordinate
+    // parities never touch the same node and each parity class can be splatted in parallel
+    lv.weight.assign(n, 0.0f);
+    std::vector<float> normal[3];
+    for (auto& v : normal) v.assign(n, 0.0f);
+    const auto& bricks = lv.layout.bricks();
+    for (int parity = 0; parity < 8; ++parity) {
+        std::vector<std::size_t> slots;
+        for (std::size_t b = 0; b < bricks.size(); ++b) {
+            const auto& c = bricks[b];
+            if (((c[0] & 1) | ((c[1] & 1) << 1) | ((c[2] & 1) << 2)) == parity) slots.push_back(b);
+        }
+        Parallel::forEach(slots.size(), [&](std::size_t q) {
+            const std::size_t b = slots[q];
+            for (std::size_t k = offsets[b]; k < offsets[b + 1]; ++k) {
+                const std::size_t i = order[k];
+                const Footprint f = footprint(s, i, d, lv);
+                for (int corner = 0; corner < 8; ++corner) {
+                    const auto ni = cornerIndex(lv.layout, f, corner);
+                    if (ni == BrickLayout::kNone) continue;
+                    const auto w = static_cast<float>(f.weight(corner));
+                    lv.weight[static_cast<std::size_t>(ni)] += w;
+                    for (int a = 0; a < 3; ++a) normal[a][static_cast<std::size_t>(ni)] += w * static_cast<float>(s.n[a][i]);
+                }
+            }
+        }, 16);
+    }
+
+    // Mean weight of the nodes that received samples: normalises the field to a unit jump across the
+    // surface and makes the screening weight independent of the sampling density
+    std::vector<double> sumW(Parallel::chunkCount(n, kMinChunk), 0.0);
+    std::vector<std::size_t> used(sumW.size(), 0);
+    Parallel::forChunks(n, [&](std::size_t c, std::size_t lo, std::size_t hi) {
+        for (std::size_t i = lo; i < hi; ++i) {
+            if (lv.weight[i] > 0.0f) { sumW[c] += lv.weight[i]; ++used[c]; }
+        }
+    }, kMinChunk);
+    double totalW = 0.0;
+    std::size_t totalUsed = 0;
+    for (std::size_t c = 0; c < sumW.size(); ++c) { totalW += sumW[c]; totalUsed += used[c]; }
+    const double meanWeight = totalUsed ? totalW / static_cast<double>(totalUsed) : 1.0;
+
+    // Scaled by h²: rhs = h²·∇·V with V = normal / (meanWeight·h), central differences
+    lv.rhs.assign(n, 0.0f);
+    lv.diag.assign(n, 1.0f);
+    const double alpha = std::max(0.0, o.pointWeight) / meanWeight;
+    Parallel::forChunks(n, [&](std::size_t, std::size_t lo, std::size_t hi) {
+        for (std::size_t i = lo; i < hi; ++i) {
+            const auto node = lv.layout.nodeOf(i);
+            if (!lv.layout.inLattice(node)) continue; // ghost node: identity row
+            double div = 0.0;
+            int neighbors = 0;
+            lv.layout.forEachNeighbor(node, i, [&](int a, int dir, std::size_t nb) {
+                div += dir * static_cast<double>(normal[a][nb]);
+                ++neighbors;
+            });
+            lv.rhs[i] = static_cast<float>(0.5 * div / meanWeight);
+            const double diag = neighbors + alpha * lv.weight[i];
+            lv.diag[i] = diag > 0.0 ? static_cast<float>(diag) : 1.0f;
+        }
+    }, kMinChunk);
+}
+
+// y = A·x with A = -Δ (no-flux at missing neighbours) + screening
+void apply(const Level& lv, const std::vector<float>& x, std::vector<float>& y) {
+    Parallel::forChunks(x.size(), [&](std::size_t, std::size_t lo, std::size_t hi) {
+        for (std::size_t i = lo; i < hi; ++i) {
+            const auto node = lv.layout.nodeOf(i);
+            if (!lv.layout.inLattice(node)) { y[i] = x[i]; continue; }
+            double sum = static_cast<double>(lv.diag[i]) * x[i];
+            lv.layout.forEachNeighbor(node, i, [&](int, int, std::size_t nb) { sum -= x[nb]; });
+            y[i] = static_cast<float>(sum);
+        }
+    }, kMinChunk);
+}
+
+// Jacobi-preconditioned conjugate gradients, starting from lv.x
+std::pair<int, double> solve(Level& lv, const Options& o) {
+    const std::size_t n = lv.x.size();
+    const double bnorm = std::sqrt(dot(lv.rhs, lv.rhs));
+    if (!(bnorm > 0.0)) return {0, 0.0};
+
+    std::vector<float> r(n), z(n), p(n), ap(n);
+    apply(lv, lv.x, ap);
+    Parallel::forEach(n, [&](std::size_t i) {
+        r[i] = lv.rhs[i] - ap[i];
+        z[i] = r[i] / lv.diag[i];
+        p[i] = z[i];
+    }, kMinChunk);
+    double rz = dot(r, z);
+    double residual = std::sqrt(dot(r, r)) / bnorm;
+
+    int it = 0;
+    while (it < o.maxIterations && residual > o.tolerance) {
+        apply(lv, p, ap);
+        const double pap = dot(p, ap);
+        if (!(pap > 0.0)) break;
+        const auto step = static_cast<float>(rz / pap);
+        Parallel::forEach(n, [&](std::size_t i) {
+            lv.x[i] += step * p[i];
+            r[i] -= step * ap[i];
+            z[i] = r[i] / lv.diag[i];
+        }, kMinChunk);
+        ++it;
+        residual = std::sqrt(dot(r, r)) / bnorm;
+        const double rzNext = dot(r, z);
+        const auto beta = static_cast<float>(rzNext / rz);
+        rz = rzNext;
+        Parallel::forEach(n, [&](std::size_t i) { p[i] = z[i] + beta * p[i]; }, kMinChunk);
+    }
+    return {it, residual};
+}
+
+// Trilinear interpolation of the coarse solution at the fine nodes (coarse node c sits at fine node 2c)
+void prolong(const Level& coarse, Level& fine) {
+    fine.x.assign(fine.layout.nodeCount(), 0.0f);
+    Parallel::forEach(fine.x.size(), [&](std::size_t i) {
+        const auto node = fine.layout.nodeOf(i);
+        if (!fine.layout.inLattice(node)) return;
+        double sum = 0.0, wsum = 0.0;
+        for (int corner = 0; corner < 8; ++corner) {
+            double w = 1.0;
+            int c[3];
+            for (int a = 0; a < 3; ++a) {
+                const int bit = (corner >> a) & 1;
+                if ((node[a] & 1) == 0 && bit) { w = 0.0; break; } // even node: coincides with a coarse node
+                c[a] = (node[a] >> 1) + bit;
+                w *= (node[a] & 1) ? 0.5 : 1.0;
+            }
+            if (w == 0.0) continue;
+            const auto ci = coarse.layout.index(c[0], c[1], c[2]);
+            if (ci == BrickLayout::kNone) continue;
+            sum += w * coarse.x[static_cast<std::size_t>(ci)];
+            wsum += w;
+        }
+        fine.x[i] = wsum > 0.0 ? static_cast<float>(sum / wsum) : 0.0f;
+    }, kMinChunk);
+}
+
+// Mean of χ at the samples: the iso-value of the reconstructed surface
+double meanAtSamples(const Samples& s, const Domain& d, const Level& lv) {
+    std::vector<double> partial(Parallel::chunkCount(s.size()), 0.0);
+    std::vector<std::size_t> counted(partial.size(), 0);
+    Parallel::forChunks(s.size(), [&](std::size_t c, std::size_t lo, std::size_t hi) {
+        for (std::size_t i = lo; i < hi; ++i) {
+            const Footprint f = footprint(s, i, d, lv);
+            double v = 0.0, w = 0.0;
+            for (int corner = 0; corner < 8; ++corner) {
+                const auto ni = cornerIndex(lv.layout, f, corner);
+                if (ni == BrickLayout::kNone) continue;
+                v += f.weight(corner) * lv.x[static_cast<std::size_t>(ni)];
+                w += f.weight(corner);
+            }
+            if (w > 0.0) { partial[c] += v / w; ++counted[c]; }
+        }
+    });
+    double sum = 0.0;
+    std::size_t count = 0;
+    for (std::size_t c = 0; c < partial.size(); ++c) { sum += partial[c]; count += counted[c]; }
+    return count ? sum / static_cast<double>(count) : 0.0;
+}
+
+// Nodes within kTrimRings steps of a node that received samples
+std::vector<std::uint8_t> nearSamples(const Level& lv) {
+    const std::size_t n = lv.weight.size();
+    std::vector<std::uint8_t> near(n), grown(n);
+    Parallel::forEach(n, [&](std::size_t i) { near[i] = lv.weight[i] > 0.0f; }, kMinChunk);
+    for (int ring = 0; ring < kTrimRings; ++ring) {
+        Parallel::forEach(n, [&](std::size_t i) {
+            std::uint8_t v = near[i];
+            if (!v) {
+                const auto node = lv.layout.nodeOf(i);
+                if (lv.layout.inLattice(node))
+                    lv.layout.forEachNeighbor(node, i, [&](int, int, std::size_t nb) { v |= near[nb]; });
+            }
+            grown[i] = v;
+        }, kMinChunk);
+        near.swap(grown);
+    }
+    return near;
+}
+}
+
+bool reconstruct(const PointCloud& pc, const Options& options, std::vector<Point>& points,
+                 std::vector<Triangle>& triangles, Stats* stats) {
+    points.clear();
+    triangles.clear();
+
+    // Samples with a usable normal, unit length
+    Samples s;
+    for (int a = 0; a < 3; ++a) { s.p[a].reserve(pc.size()); s.n[a].reserve(pc.size()); }
+    double lo[3] = {std::numeric_limits<double>::max(), std::numeric_limits<double>::max(), std::numeric_limits<double>::max()};
+    double hi[3] = {std::numeric_limits<double>::lowest(), std::numeric_limits<double>::lowest(), std::numeric_limits<double>::lowest()};
+    for (const auto& pn : pc) {
+        const double len2 = pn.second.squared_length();
+        if (!(len2 > 0.0)) continue;
+        const double inv = 1.0 / std::sqrt(len2);
+        const double p[3] = {pn.first.x(), pn.first.y(), pn.first.z()};
+        const double nv[3] = {pn.second.x() * inv, pn.second.y() * inv, pn.second.z() * inv};
+        for (int a = 0; a < 3; ++a) {
+            s.p[a].push_back(p[a]);
+            s.n[a].push_back(nv[a]);
+            lo[a] = std::min(lo[a], p[a]);
+            hi[a] = std::max(hi[a], p[a]);
+        }
+    }
+    if (s.size() < 4) return false;
+
+    Domain d;
+    const double extent = std::max({hi[0] - lo[0], hi[1] - lo[1], hi[2] - lo[2]});
+    if (!(extent > 0.0)) return false;
+    d.side = extent * (1.0 + 2.0 * kPadding);
+    for (int a = 0; a < 3; ++a) d.origin[a] = 0.5 * (lo[a] + hi[a]) - 0.5 * d.side;
+
+    const int depth = std::clamp(options.depth, 2, 11);
+    const int coarseDepth = std::clamp(options.coarseDepth, 2, depth);
+    Stats local;
+    Level prev;
+    Level cur;
+    for (int level = coarseDepth; level <= depth; ++level) {
+        cur = Level {};
+        cur.res = 1 << level;
+        cur.h = d.side / cur.res;
+        buildLevel(s, d, options, cur);
+        if (level == coarseDepth) cur.x.assign(cur.layout.nodeCount(), 0.0f);
+        else prolong(prev, cur);
+        const auto [iterations, residual] = solve(cur, options);
+        local.iterations += iterations;
+        local.residual = residual;
+        ++local.levels;
+        // Only the solution is needed for the next prolongation
+        std::vector<float>().swap(cur.rhs);
+        std::vector<float>().swap(cur.diag);
+        if (level < depth) prev = std::move(cur);
+    }
+    prev = Level {};
+    local.nodes = cur.layout.nodeCount();
+    local.iso = meanAtSamples(s, d, cur);
+
+    const auto near = nearSamples(cur);
+    MarchingCubes::Frame frame;
+    for (int a = 0; a < 3; ++a) frame.origin[a] = d.origin[a];
+    frame.h = cur.h;
+    MarchingCubes::extract(cur.layout, cur.x, static_cast<float>(local.iso), frame, &near, points, triangles);
+    if (stats) *stats = local;
+    return !triangles.empty();
+}
+
+} // namespace ScreenedPoisson
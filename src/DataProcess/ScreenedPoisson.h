@@ -0,0 +1,45 @@
+#ifndef POINTTOMESH_SCREENEDPOISSON_H
+#define POINTTOMESH_SCREENEDPOISSON_H
+
+#include <array>
+#include <cstddef>
+#include <vector>
+
+#include "PointCloudProcessor.h"
+
+// Screened Poisson surface reconstruction on a sparse narrow-band lattice.
+// The cube around the cloud is sampled at 2^depth cells per axis, but only the 8³ bricks around the
+// samples (plus one ring) are stored, so memory follows the surface area instead of the volume.
+// Oriented normals are splatted to the lattice nodes, the indicator function solves
+//     -Δχ + α·w·χ = ∇·V
+// (7-point Laplacian, no-flux at the band boundary, screening α·w pulling χ to 0 at the samples), and
+// the system is solved cascadically: Jacobi-preconditioned CG on each depth from coarseDepth up, each
+// level starting from the prolonged solution of the previous one. The surface is the iso-level at the
+// samples' mean χ, extracted with parallel marching cubes close to the data.
+namespace ScreenedPoisson {
+
+using Triangle = std::array<std::size_t, 3>;
+
+struct Options {
+    int depth {8};           // finest level: 2^depth cells along the longest axis
+    int coarseDepth {5};     // first level of the cascade
+    double pointWeight {4.0}; // screening weight α
+    int maxIterations {100}; // CG iterations per level
+    double tolerance {1e-4}; // relative residual per level
+};
+
+struct Stats {
+    int levels {0};
+    std::size_t nodes {0}; // stored nodes on the finest level
+    int iterations {0};    // CG iterations over all levels
+    double residual {0.0}; // relative residual on the finest level
+    double iso {0.0};
+};
+
+// Needs oriented normals; points without a normal are ignored. Returns false if nothing could be extracted.
+bool reconstruct(const PointCloud& pc, const Options& options, std::vector<Point>& points,
+                 std::vector<Triangle>& triangles, Stats* stats = nullptr);
+
+} // namespace ScreenedPoisson
+
+#endif //POINTTOMESH_SCREENEDPOISSON_H
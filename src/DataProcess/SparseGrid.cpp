@@ -0,0 +1,47 @@
+#include "SparseGrid.h"
+
+#include <algorithm>
+
+namespace SparseGrid {
+
+BrickLayout::BrickLayout(int res)
+    : m_res(std::max(1, res)), m_b(m_res / kSize + 1),
+      m_slot(static_cast<std::size_t>(m_b) * m_b * m_b, -1) {}
+
+void BrickLayout::markBrick(int bi, int bj, int bk) {
+    if (bi < 0 || bj < 0 || bk < 0 || bi >= m_b || bj >= m_b || bk >= m_b) return;
+    auto& s = m_slot[(static_cast<std::size_t>(bk) * m_b + bj) * m_b + bi];
+    if (s < 0) s = 0;
+}
+
+void BrickLayout::dilate(int rings) {
+    for (int r = 0; r < rings; ++r) {
+        const std::vector<std::int32_t> marked = m_slot;
+        for (int bk = 0; bk < m_b; ++bk) {
+            for (int bj = 0; bj < m_b; ++bj) {
+                for (int bi = 0; bi < m_b; ++bi) {
+                    if (marked[(static_cast<std::size_t>(bk) * m_b + bj) * m_b + bi] < 0) continue;
+                    for (int dk = -1; dk <= 1; ++dk)
+                        for (int dj = -1; dj <= 1; ++dj)
+                            for (int di = -1; di <= 1; ++di) markBrick(bi + di, bj + dj, bk + dk);
+                }
+            }
+        }
+    }
+}
+
+void BrickLayout::build() {
+    m_bricks.clear();
+    for (int bk = 0; bk < m_b; ++bk) {
+        for (int bj = 0; bj < m_b; ++bj) {
+            for (int bi = 0; bi < m_b; ++bi) {
+                auto& s = m_slot[(static_cast<std::size_t>(bk) * m_b + bj) * m_b + bi];
+                if (s < 0) continue;
+                s = static_cast<std::int32_t>(m_bricks.size());
+                m_bricks.push_back({bi, bj, bk});
+            }
+        }
+    }
+}
+
+} // namespace SparseGrid
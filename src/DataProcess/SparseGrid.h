@@ -0,0 +1,95 @@
+#ifndef POINTTOMESH_SPARSEGRID_H
+#define POINTTOMESH_SPARSEGRID_H
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Sparse storage for narrow-band volumetric methods (screened Poisson, voxel reconstruction).
+// The node lattice [0, res]³ is cut into 8³ bricks and only marked bricks own storage. Field values
+// live in flat arrays owned by the caller (brick slot * 512 + local offset), so one layout can back
+// several fields; a node lookup is a shift and a table read, with no hashing.
+namespace SparseGrid {
+
+class BrickLayout {
+public:
+    static constexpr int kBits = 3;
+    static constexpr int kSize = 1 << kBits;
+    static constexpr std::size_t kNodes = std::size_t(kSize) * kSize * kSize;
+    static constexpr std::int64_t kNone = -1;
+
+    BrickLayout() = default;
+    explicit BrickLayout(int res); // res cells per axis, res + 1 nodes
+
+    [[nodiscard]] int resolution() const { return m_res; }
+    [[nodiscard]] int bricksPerAxis() const { return m_b; }
+
+    // Building: mark bricks, optionally grow the marked set, then build() assigns storage slots
+    void markBrick(int bi, int bj, int bk);
+    void markNode(int i, int j, int k) { markBrick(i >> kBits, j >> kBits, k >> kBits); }
+    void dilate(int rings); // grow the marked set by `rings` bricks (26-neighbourhood)
+    void build();           // slots in z-y-x scan order, for locality between neighbouring bricks
+
+    [[nodiscard]] std::size_t brickCount() const { return m_bricks.size(); }
+    [[nodiscard]] std::size_t nodeCount() const { return m_bricks.size() * kNodes; }
+    [[nodiscard]] const std::vector<std::array<int, 3>>& bricks() const { return m_bricks; }
+
+    // Slot of brick (bi, bj, bk), or -1 if not allocated
+    [[nodiscard]] std::int32_t slotOf(int bi, int bj, int bk) const {
+        if (bi < 0 || bj < 0 || bk < 0 || bi >= m_b || bj >= m_b || bk >= m_b) return -1;
+        return m_slot[(static_cast<std::size_t>(bk) * m_b + bj) * m_b + bi];
+    }
+
+    // Flat index of node (i, j, k), or kNone if outside the lattice or not allocated
+    [[nodiscard]] std::int64_t index(int i, int j, int k) const {
+        if (i < 0 || j < 0 || k < 0 || i > m_res || j > m_res || k > m_res) return kNone;
+        const std::int32_t slot = m_slot[(static_cast<std::size_t>(k >> kBits) * m_b + (j >> kBits)) * m_b + (i >> kBits)];
+        if (slot < 0) return kNone;
+        constexpr int mask = kSize - 1;
+        return static_cast<std::int64_t>(slot) * static_cast<std::int64_t>(kNodes) +
+               ((k & mask) << (2 * kBits)) + ((j & mask) << kBits) + (i & mask);
+    }
+
+    // Lattice coordinates of a flat index. Border bricks also hold ghost nodes beyond res; check inLattice().
+    [[nodiscard]] std::array<int, 3> nodeOf(std::size_t idx) const {
+        const auto& b = m_bricks[idx / kNodes];
+        const auto local = static_cast<int>(idx % kNodes);
+        constexpr int mask = kSize - 1;
+        return {b[0] * kSize + (local & mask), b[1] * kSize + ((local >> kBits) & mask), b[2] * kSize + (local >> (2 * kBits))};
+    }
+    [[nodiscard]] bool inLattice(const std::array<int, 3>& n) const { return n[0] <= m_res && n[1] <= m_res && n[2] <= m_res; }
+
+    // Calls fn(axis, direction, index) for the stored face neighbours of lattice node `node` (flat index idx).
+    // Neighbours inside the same brick are found by offset, the others through the brick table.
+    template <class Fn>
+    void forEachNeighbor(const std::array<int, 3>& node, std::size_t idx, Fn&& fn) const {
+        constexpr int mask = kSize - 1;
+        constexpr std::int64_t stride[3] = {1, kSize, kSize * kSize};
+        const auto at = static_cast<std::int64_t>(idx);
+        for (int a = 0; a < 3; ++a) {
+            if (node[a] > 0) {
+                std::array<int, 3> m = node;
+                --m[a];
+                const std::int64_t nb = (node[a] & mask) ? at - stride[a] : index(m[0], m[1], m[2]);
+                if (nb != kNone) fn(a, -1, static_cast<std::size_t>(nb));
+            }
+            if (node[a] < m_res) {
+                std::array<int, 3> m = node;
+                ++m[a];
+                const std::int64_t nb = ((node[a] & mask) != mask) ? at + stride[a] : index(m[0], m[1], m[2]);
+                if (nb != kNone) fn(a, +1, static_cast<std::size_t>(nb));
+            }
+        }
+    }
+
+private:
+    int m_res {0};
+    int m_b {0};
+    std::vector<std::int32_t> m_slot;        // dense brick table: -1 = empty, 0 = marked (before build), slot after
+    std::vector<std::array<int, 3>> m_bricks; // slot -> brick coordinates
+};
+
+} // namespace SparseGrid
+
+#endif //POINTTOMESH_SPARSEGRID_H
@@ -0,0 +1,280 @@
+#include "TiledReconstruction.h"
+#include "Parallel.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <unordered_map>
+#include <utility>
+
+namespace Tiling {
+
+namespace {
+int axisIndex(double v, double lo, double size, int n) {
+    if (!(size > 0.0)) return 0;
+    const int i = static_cast<int>(std::floor((v - lo) / size));
+    return std::clamp(i, 0, n - 1);
+}
+
+std::uint64_t cellKey(long long x, long long y, long long z) {
+    // 21 bits per axis, wrapping is harmless (only a hash key; candidates are distance-checked)
+    const auto m = (std::uint64_t(1) << 21) - 1;
+    return (std::uint64_t(x) & m) | ((std::uint64_t(y) & m) << 21) | ((std::uint64_t(z) & m) << 42);
+}
+}
+
+std::size_t Grid::coreIndexOf(const Point& p) const {
+    const int ix = axisIndex(p.x(), bounds.xmin(), size[0], tilesPerAxis);
+    const int iy = axisIndex(p.y(), bounds.ymin(), size[1], tilesPerAxis);
+    const int iz = axisIndex(p.z(), bounds.zmin(), size[2], tilesPerAxis);
+    return (static_cast<std::size_t>(iz) * tilesPerAxis + iy) * tilesPerAxis + ix;
+}
+
+bool Grid::nearSeam(const Point& p, double distance) const {
+    const double lo[3] = {bounds.xmin(), bounds.ymin(), bounds.zmin()};
+    const double v[3] = {p.x(), p.y(), p.z()};
+    for (int a = 0; a < 3; ++a) {
+        if (!(size[a] > 0.0)) continue;
+        // Nearest interior plane lo + i*size, i in [1, n-1]
+        const int i = std::clamp(static_cast<int>(std::lround((v[a] - lo[a]) / size[a])), 1, tilesPerAxis - 1);
+        if (tilesPerAxis > 1 && std::abs(v[a] - (lo[a] + i * size[a])) <= distance) return true;
+    }
+    return false;
+}
+
+CGAL::Bbox_3 boundsOf(const PointCloud& pc) {
+    std::vector<CGAL::Bbox_3> partial(Parallel::chunkCount(pc.size()));
+    Parallel::forChunks(pc.size(), [&](std::size_t chunk, std::size_t b, std::size_t e) {
+        CGAL::Bbox_3 box;
+        for (std::size_t i = b; i < e; ++i) box += pc[i].first.bbox();
+        partial[chunk] = box;
+    });
+    CGAL::Bbox_3 box;
+    for (const auto& b : partial) box += b;
+    return box;
+}
+
+Grid makeGrid(const CGAL::Bbox_3& bounds, int tilesPerAxis, double overlapRatio) {
+    Grid g;
+    g.bounds = bounds;
+    g.tilesPerAxis = std::max(1, tilesPerAxis);
+    const int n = g.tilesPerAxis;
+    g.size[0] = (bounds.xmax() - bounds.xmin()) / n;
+    g.size[1] = (bounds.ymax() - bounds.ymin()) / n;
+    g.size[2] = (bounds.zmax() - bounds.zmin()) / n;
+    g.margin = std::max(0.0, overlapRatio) * std::max({g.size[0], g.size[1], g.size[2]});
+
+    g.tiles.reserve(static_cast<std::size_t>(n) * n * n);
+    for (int iz = 0; iz < n; ++iz) {
+        for (int iy = 0; iy < n; ++iy) {
+            for (int ix = 0; ix < n; ++ix) {
+                Tile t;
+                t.ix = ix; t.iy = iy; t.iz = iz;
+                const double x0 = bounds.xmin() + ix * g.size[0], y0 = bounds.ymin() + iy * g.size[1], z0 = bounds.zmin() + iz * g.size[2];
+                t.core = CGAL::Bbox_3(x0, y0, z0, x0 + g.size[0], y0 + g.size[1], z0 + g.size[2]);
+                t.expanded = CGAL::Bbox_3(x0 - g.margin, y0 - g.margin, z0 - g.margin,
+                                          x0 + g.size[0] + g.margin, y0 + g.size[1] + g.margin, z0 + g.size[2] + g.margin);
+                g.tiles.push_back(t);
+            }
+        }
+    }
+    return g;
+}
+
+std::vector<std::vector<std::size_t>> bucketPoints(const PointCloud& pc, const Grid& grid) {
+    const std::size_t tileCount = grid.tiles.size();
+    const int n = grid.tilesPerAxis;
+    const std::size_t chunks = Parallel::chunkCount(pc.size());
+
+    // Per-chunk buckets, concatenated in chunk order so every list keeps the input order
+    std::vector<std::vector<std::vector<std::size_t>>> local(chunks, std::vector<std::vector<std::size_t>>(tileCount));
+    Parallel::forChunks(pc.size(), [&](std::size_t chunk, std::size_t b, std::size_t e) {
+        auto& buckets = local[chunk];
+        for (std::size_t i = b; i < e; ++i) {
+            const Point& p = pc[i].first;
+            // Range of tiles whose expanded box contains p along each axis
+            const int x0 = axisIndex(p.x() - grid.margin, grid.bounds.xmin(), grid.size[0], n);
+            const int x1 = axisIndex(p.x() + grid.margin, grid.bounds.xmin(), grid.size[0], n);
+            const int y0 = axisIndex(p.y() - grid.margin, grid.bounds.ymin(), grid.size[1], n);
+            const int y1 = axisIndex(p.y() + grid.margin, grid.bounds.ymin(), grid.size[1], n);
+            const int z0 = axisIndex(p.z() - grid.margin, grid.bounds.zmin(), grid.size[2], n);
+            const int z1 = axisIndex(p.z() + grid.margin, grid.bounds.zmin(), grid.size[2], n);
+            for (int iz = z0; iz <= z1; ++iz)
+                for (int iy = y0; iy <= y1; ++iy)
+                    for (int ix = x0; ix <= x1; ++ix)
+                        buckets[(static_cast<std::size_t>(iz) * n + iy) * n + ix].push_back(i);
+        }
+    });
+
+    std::vector<std::vector<std::size_t>> out(tileCount);
+    Parallel::forEach(tileCount, [&](std::size_t t) {
+        std::size_t total = 0;
+        for (const auto& l : local) total += l[t].size();
+        out[t].reserve(total);
+        for (auto& l : local) {
+            out[t].insert(out[t].end(), l[t].begin(), l[t].end());
+            std::vector<std::size_t>().swap(l[t]);
+        }
+    }, 1);
+    return out;
+}
+
+unsigned parallelTilesWithin(const std::vector<std::vector<std::size_t>>& buckets, std::size_t bytesPerPoint,
+                             std::size_t budgetBytes, unsigned maxParallel) {
+    const unsigned limit = maxParallel == 0 ? Parallel::threadCount() : maxParallel;
+    if (budgetBytes == 0) return limit;
+    // Worst case: the largest tiles happen to run together
+    std::vector<std::size_t> sizes;
+    sizes.reserve(buckets.size());
+    for (const auto& b : buckets) sizes.push_back(b.size());
+    std::sort(sizes.begin(), sizes.end(), std::greater<>());
+    unsigned fit = 0;
+    std::size_t used = 0;
+    for (std::size_t s : sizes) {
+        if (fit >= limit) break;
+        used += s * bytesPerPoint;
+        if (used > budgetBytes) break;
+        ++fit;
+    }
+    return std::max(1u, fit);
+}
+
+Soup soupFromMesh(const Mesh& mesh) {
+    Soup soup;
+    soup.points.reserve(mesh.number_of_vertices());
+    soup.triangles.reserve(mesh.number_of_faces());
+    std::vector<std::size_t> index(mesh.number_of_vertices() + mesh.number_of_removed_vertices(),
+                                   std::numeric_limits<std::size_t>::max());
+    for (auto v : mesh.vertices()) {
+        index[static_cast<std::size_t>(v)] = soup.points.size();
+        soup.points.push_back(mesh.point(v));
+    }
+    for (auto f : mesh.faces()) {
+        std::array<std::size_t, 3> tri {};
+        int k = 0;
+        for (auto v : CGAL::vertices_around_face(mesh.halfedge(f), mesh)) {
+            if (k < 3) tri[k] = index[static_cast<std::size_t>(v)];
+            ++k;
+        }
+        if (k == 3) soup.triangles.push_back(tri);
+    }
+    return soup;
+}
+
+void clipToCore(Soup& soup, const Grid& grid, std::size_t tile) {
+    std::vector<std::size_t> remap(soup.points.size(), std::numeric_limits<std::size_t>::max());
+    std::vector<Point> points;
+    std::vector<std::array<std::size_t, 3>> triangles;
+    triangles.reserve(soup.triangles.size());
+    for (const auto& t : soup.triangles) {
+        const Point& a = soup.points[t[0]];
+        const Point& b = soup.points[t[1]];
+        const Point& c = soup.points[t[2]];
+        const Point centroid((a.x() + b.x() + c.x()) / 3.0, (a.y() + b.y() + c.y()) / 3.0, (a.z() + b.z() + c.z()) / 3.0);
+        if (!grid.inCore(tile, centroid)) continue;
+        std::array<std::size_t, 3> kept {};
+        for (int k = 0; k < 3; ++k) {
+            auto& r = remap[t[k]];
+            if (r == std::numeric_limits<std::size_t>::max()) { r = points.size(); points.push_back(soup.points[t[k]]); }
+            kept[k] = r;
+        }
+        triangles.push_back(kept);
+    }
+    soup.points = std::move(points);
+    soup.triangles = std::move(triangles);
+}
+
+std::size_t mergeSoups(const std::vector<Soup>& tiles, double weldTolerance, Soup& out) {
+    out.points.clear();
+    out.triangles.clear();
+
+    std::vector<std::size_t> offset(tiles.size() + 1, 0);
+    for (std::size_t t = 0; t < tiles.size(); ++t) offset[t + 1] = offset[t] + tiles[t].points.size();
+    const std::size_t total = offset.back();
+
+    // Border vertices of each tile: endpoints of edges used by exactly one triangle
+    std::vector<std::vector<std::size_t>> border(tiles.size());
+    Parallel::forTasks(tiles.size(), [&](std::size_t t) {
+        std::unordered_map<std::uint64_t, int> edgeUse;
+        edgeUse.reserve(tiles[t].triangles.size() * 3);
+        auto key = [](std::size_t a, std::size_t b) {
+            if (a > b) std::swap(a, b);
+            return (std::uint64_t(a) << 32) | std::uint64_t(b);
+        };
+        for (const auto& tri : tiles[t].triangles)
+            for (int k = 0; k < 3; ++k) ++edgeUse[key(tri[k], tri[(k + 1) % 3])];
+        std::vector<std::uint8_t> onBorder(tiles[t].points.size(), 0);
+        for (const auto& [e, count] : edgeUse) {
+            if (count != 1) continue;
+            onBorder[e >> 32] = 1;
+            onBorder[e & 0xffffffffu] = 1;
+        }
+        for (std::size_t v = 0; v < onBorder.size(); ++v)
+            if (onBorder[v]) border[t].push_back(v);
+    });
+
+    // Weld: each border vertex snaps to the closest representative of another tile within tolerance
+    std::vector<std::size_t> rep(total);
+    for (std::size_t i = 0; i < total; ++i) rep[i] = i;
+    std::size_t welded = 0;
+    if (weldTolerance > 0.0) {
+        const double tol2 = weldTolerance * weldTolerance;
+        std::unordered_map<std::uint64_t, std::vector<std::pair<std::size_t, std::size_t>>> grid; // cell -> (global id, tile)
+        auto cellOf = [&](const Point& p) {
+            return std::array<long long, 3> {static_cast<long long>(std::floor(p.x() / weldTolerance)),
+                                             static_cast<long long>(std::floor(p.y() / weldTolerance)),
+                                             static_cast<long long>(std::floor(p.z() / weldTolerance))};
+        };
+        for (std::size_t t = 0; t < tiles.size(); ++t) {
+            for (std::size_t v : border[t]) {
+                const Point& p = tiles[t].points[v];
+                const auto c = cellOf(p);
+                std::size_t best = total;
+                double bestD2 = tol2;
+                for (long long dz = -1; dz <= 1; ++dz)
+                    for (long long dy = -1; dy <= 1; ++dy)
+                        for (long long dx = -1; dx <= 1; ++dx) {
+                            auto it = grid.find(cellKey(c[0] + dx, c[1] + dy, c[2] + dz));
+                            if (it == grid.end()) continue;
+                            for (const auto& [gid, owner] : it->second) {
+                                if (owner == t) continue;
+                                const auto tOwner = static_cast<std::size_t>(std::upper_bound(offset.begin(), offset.end(), gid) - offset.begin()) - 1;
+                                const double d2 = CGAL::to_double(CGAL::squared_distance(p, tiles[tOwner].points[gid - offset[tOwner]]));
+                                if (d2 <= bestD2) { bestD2 = d2; best = gid; }
+                            }
+                        }
+                const std::size_t gid = offset[t] + v;
+                if (best != total) { rep[gid] = best; ++welded; }
+                else grid[cellKey(c[0], c[1], c[2])].emplace_back(gid, t);
+            }
+        }
+    }
+
+    // Compact representatives into the output point list
+    std::vector<std::size_t> newIndex(total, std::numeric_limits<std::size_t>::max());
+    out.points.reserve(total - welded);
+    for (std::size_t t = 0; t < tiles.size(); ++t) {
+        for (std::size_t v = 0; v < tiles[t].points.size(); ++v) {
+            const std::size_t gid = offset[t] + v;
+            if (rep[gid] != gid) continue;
+            newIndex[gid] = out.points.size();
+            out.points.push_back(tiles[t].points[v]);
+        }
+    }
+    std::size_t triCount = 0;
+    for (const auto& s : tiles) triCount += s.triangles.size();
+    out.triangles.reserve(triCount);
+    for (std::size_t t = 0; t < tiles.size(); ++t) {
+        for (const auto& tri : tiles[t].triangles) {
+            std::array<std::size_t, 3> m {};
+            for (int k = 0; k < 3; ++k) m[k] = newIndex[rep[offset[t] + tri[k]]];
+            if (m[0] == m[1] || m[1] == m[2] || m[2] == m[0]) continue;
+            out.triangles.push_back(m);
+        }
+    }
+    return welded;
+}
+
+} // namespace Tiling
@@ -0,0 +1,72 @@
+#ifndef POINTTOMESH_TILEDRECONSTRUCTION_H
+#define POINTTOMESH_TILEDRECONSTRUCTION_H
+
+#include <array>
+#include <cstddef>
+#include <vector>
+
+#include <CGAL/Bbox_3.h>
+#include "PointCloudProcessor.h"
+
+// Spatial tiling shared by the tiled reconstruction modes.
+// The bounding box of the cloud is cut into tilesPerAxis³ core boxes that partition space exactly;
+// each tile is reconstructed from the points of its core box grown by an overlap margin, and only
+// the triangles whose centroid lies in the core are kept, so neighbouring tiles meet at the core
+// boundaries. mergeSoups() then welds the tile borders back into a single triangle soup.
+namespace Tiling {
+
+struct Tile {
+    int ix {0}, iy {0}, iz {0};
+    CGAL::Bbox_3 core;     // faces whose centroid falls in here belong to this tile
+    CGAL::Bbox_3 expanded; // core grown by the overlap margin; points in here feed the tile
+};
+
+struct Grid {
+    CGAL::Bbox_3 bounds;
+    int tilesPerAxis {1};
+    double size[3] {0.0, 0.0, 0.0}; // core edge length per axis
+    double margin {0.0};            // overlap added on every side of a core box
+    std::vector<Tile> tiles;        // x fastest, then y, then z
+
+    // Index of the tile whose core contains p (points outside the bounds are clamped)
+    [[nodiscard]] std::size_t coreIndexOf(const Point& p) const;
+    [[nodiscard]] bool inCore(std::size_t tile, const Point& p) const { return coreIndexOf(p) == tile; }
+    // True if p lies within `distance` of an interior tile boundary plane
+    [[nodiscard]] bool nearSeam(const Point& p, double distance) const;
+};
+
+// Triangle soup of one tile (or of the merged result)
+struct Soup {
+    std::vector<Point> points;
+    std::vector<std::array<std::size_t, 3>> triangles;
+};
+
+// Bounding box of the cloud, computed in parallel
+CGAL::Bbox_3 boundsOf(const PointCloud& pc);
+
+// Cubic-ish tiling of `bounds`; overlapRatio is the margin relative to the largest core edge
+Grid makeGrid(const CGAL::Bbox_3& bounds, int tilesPerAxis, double overlapRatio);
+
+// Indices of the points inside each tile's expanded box (a point near a seam belongs to several
+// tiles). Lists keep the input order.
+std::vector<std::vector<std::size_t>> bucketPoints(const PointCloud& pc, const Grid& grid);
+
+// How many tiles may run at once so that the largest tiles running together stay within budgetBytes,
+// assuming a tile needs about bytesPerPoint per point of its bucket. Never more than maxParallel
+// (0 = hardware concurrency) and never less than one; a budget of 0 disables the memory cap.
+unsigned parallelTilesWithin(const std::vector<std::vector<std::size_t>>& buckets, std::size_t bytesPerPoint,
+                             std::size_t budgetBytes, unsigned maxParallel);
+
+// Soup of a surface mesh (live vertices/faces only; faces must be triangles)
+Soup soupFromMesh(const Mesh& mesh);
+
+// Keep only the triangles whose centroid lies in the tile's core; drops unreferenced points
+void clipToCore(Soup& soup, const Grid& grid, std::size_t tile);
+
+// Concatenate tile soups, welding border vertices of different tiles that are closer than
+// weldTolerance. Triangles that collapse after welding are dropped. Returns the number of welded vertices.
+std::size_t mergeSoups(const std::vector<Soup>& tiles, double weldTolerance, Soup& out);
+
+} // namespace Tiling
+
+#endif //POINTTOMESH_TILEDRECONSTRUCTION_H
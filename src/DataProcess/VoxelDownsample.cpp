@@ -0,0 +1,199 @@
+#include "VoxelDownsample.h"
+#include "Parallel.h"
+
+#include <array>
+#include <cmath>
+#include <limits>
+#include <vector>
+
+namespace VoxelDownsample {
+
+namespace {
+constexpr int kAxisBits = 21;
+constexpr std::size_t kSortGrain = 1 << 16;
+
+// Spreads the low 21 bits of v so that two zero bits follow each one
+std::uint64_t spreadBits(std::uint64_t v) {
+    v &= 0x1fffffULL;
+    v = (v | (v << 32)) & 0x1f00000000ffffULL;
+    v = (v | (v << 16)) & 0x1f0000ff0000ffULL;
+    v = (v | (v << 8)) & 0x100f00f00f00f00fULL;
+    v = (v | (v << 4)) & 0x10c30c30c30c30c3ULL;
+    v = (v | (v << 2)) & 0x1249249249249249ULL;
+    return v;
+}
+
+std::uint64_t mortonKey(std::uint64_t x, std::uint64_t y, std::uint64_t z) {
+    return spreadBits(x) | (spreadBits(y) << 1) | (spreadBits(z) << 2);
+}
+
+std::uint64_t mix(std::uint64_t v) { // splitmix64 finaliser
+    v += 0x9e3779b97f4a7c15ULL;
+    v = (v ^ (v >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    v = (v ^ (v >> 27)) * 0x94d049bb133111ebULL;
+    return v ^ (v >> 31);
+}
+
+// Stable LSD radix sort of (keys, index) on the low `bits` bits of the keys. Each pass histograms the
+// digit per chunk, turns the counts into per-chunk offsets (digit-major, chunk-minor, which keeps equal
+// digits in input order) and scatters in parallel with the same chunking.
+int radixSort(std::vector<std::uint64_t>& keys, std::vector<std::uint32_t>& index, int bits) {
+    const std::size_t n = keys.size();
+    std::vector<std::uint64_t> keysOut(n);
+    std::vector<std::uint32_t> indexOut(n);
+    std::vector<std::array<std::size_t, 256>> offsets(Parallel::chunkCount(n, kSortGrain));
+    int passes = 0;
+    for (int shift = 0; shift < bits; shift += 8, ++passes) {
+        Parallel::forChunks(n, [&](std::size_t c, std::size_t b, std::size_t e) {
+            auto& count = offsets[c];
+            count.fill(0);
+            for (std::size_t i = b; i < e; ++i) ++count[(keys[i] >> shift) & 0xff];
+        }, kSortGrain);
+        std::size_t sum = 0;
+        for (std::size_t d = 0; d < 256; ++d) {
+            for (auto& count : offsets) {
+                const std::size_t c = count[d];
+                count[d] = sum;
+                sum += c;
+            }
+        }
+        Parallel::forChunks(n, [&](std::size_t c, std::size_t b, std::size_t e) {
+            auto& next = offsets[c];
+            for (std::size_t i = b; i < e; ++i) {
+                const std::size_t pos = next[(keys[i] >> shift) & 0xff]++;
+                keysOut[pos] = keys[i];
+                indexOut[pos] = index[i];
+            }
+        }, kSortGrain);
+        keys.swap(keysOut);
+        index.swap(indexOut);
+    }
+    return passes;
+}
+}
+
+bool downsample(PointCloud& pc, const Options& options, Stats* stats) {
+    const std::size_t n = pc.size();
+    if (!(options.cellSize > 0.0)) return false;
+    if (n == 0 || n > std::numeric_limits<std::uint32_t>::max()) return n == 0;
+
+    // Bounding box
+    const std::size_t chunks = Parallel::chunkCount(n);
+    std::vector<std::array<double, 6>> boxes(chunks);
+    Parallel::forChunks(n, [&](std::size_t c, std::size_t b, std::size_t e) {
+        std::array<double, 6> box {pc[b].first.x(), pc[b].first.y(), pc[b].first.z(),
+                                   pc[b].first.x(), pc[b].first.y(), pc[b].first.z()};
+        for (std::size_t i = b + 1; i < e; ++i) {
+            const double p[3] = {pc[i].first.x(), pc[i].first.y(), pc[i].first.z()};
+            for (int a = 0; a < 3; ++a) {
+                box[a] = std::min(box[a], p[a]);
+                box[3 + a] = std::max(box[3 + a], p[a]);
+            }
+        }
+        boxes[c] = box;
+    });
+    std::array<double, 6> box = boxes[0];
+    for (const auto& other : boxes) {
+        for (int a = 0; a < 3; ++a) {
+            box[a] = std::min(box[a], other[a]);
+            box[3 + a] = std::max(box[3 + a], other[3 + a]);
+        }
+    }
+
+    const double inv = 1.0 / options.cellSize;
+    std::array<std::uint64_t, 3> dims {};
+    for (int a = 0; a < 3; ++a) {
+        const double cells = std::floor((box[3 + a] - box[a]) * inv) + 1.0;
+        if (!(cells <= double(1ULL << kAxisBits))) return false;
+        dims[a] = static_cast<std::uint64_t>(cells);
+    }
+    const auto cellOf = [&](double v, int a) {
+        const double c = std::floor((v - box[a]) * inv);
+        return std::min<std::uint64_t>(dims[a] - 1, c > 0.0 ? static_cast<std::uint64_t>(c) : 0);
+    };
+
+    // Keys, then sort only over the bits the largest key uses (Morton order is monotone per axis)
+    std::vector<std::uint64_t> keys(n);
+    std::vector<std::uint32_t> index(n);
+    Parallel::forEach(n, [&](std::size_t i) {
+        const auto& p = pc[i].first;
+        keys[i] = mortonKey(cellOf(p.x(), 0), cellOf(p.y(), 1), cellOf(p.z(), 2));
+        index[i] = static_cast<std::uint32_t>(i);
+    });
+    std::uint64_t maxKey = mortonKey(dims[0] - 1, dims[1] - 1, dims[2] - 1);
+    int bits = 0;
+    while (maxKey > 0) { ++bits; maxKey >>= 1; }
+    const int passes = radixSort(keys, index, bits);
+
+    // Start of every run of equal keys
+    std::vector<std::vector<std::uint32_t>> partStarts(Parallel::chunkCount(n, kSortGrain));
+    Parallel::forChunks(n, [&](std::size_t c, std::size_t b, std::size_t e) {
+        for (std::size_t i = b; i < e; ++i) {
+            if (i == 0 || keys[i] != keys[i - 1]) partStarts[c].push_back(static_cast<std::uint32_t>(i));
+        }
+    }, kSortGrain);
+    std::vector<std::uint32_t> starts;
+    for (const auto& part : partStarts) starts.insert(starts.end(), part.begin(), part.end());
+    std::vector<std::vector<std::uint32_t>>().swap(partStarts);
+    const std::size_t cells = starts.size();
+    starts.push_back(static_cast<std::uint32_t>(n));
+
+    PointCloud out(cells);
+    Parallel::forChunks(cells, [&](std::size_t, std::size_t b, std::size_t e) {
+        for (std::size_t c = b; c < e; ++c) {
+            const std::size_t first = starts[c], last = starts[c + 1];
+            switch (options.representative) {
+                case Representative::First:
+                    out[c] = pc[index[first]];
+                    break;
+                case Representative::Random:
+                    out[c] = pc[index[first + mix(options.seed ^ keys[first]) % (last - first)]];
+                    break;
+                case Representative::ClosestToCenter: {
+                    const auto& p0 = pc[index[first]].first;
+                    const double center[3] = {box[0] + (double(cellOf(p0.x(), 0)) + 0.5) * options.cellSize,
+                                              box[1] + (double(cellOf(p0.y(), 1)) + 0.5) * options.cellSize,
+                                              box[2] + (double(cellOf(p0.z(), 2)) + 0.5) * options.cellSize};
+                    std::size_t best = first;
+                    double bestDistance = std::numeric_limits<double>::max();
+                    for (std::size_t s = first; s < last; ++s) {
+                        const auto& p = pc[index[s]].first;
+                        const double dx = p.x() - center[0], dy = p.y() - center[1], dz = p.z() - center[2];
+                        const double d2 = dx * dx + dy * dy + dz * dz;
+                        if (d2 < bestDistance) { bestDistance = d2; best = s; }
+                    }
+                    out[c] = pc[index[best]];
+                    break;
+                }
+                case Representative::Centroid:
+                default: {
+                    double sum[3] = {0.0, 0.0, 0.0}, normal[3] = {0.0, 0.0, 0.0};
+                    const Vector* reference = nullptr;
+                    for (std::size_t s = first; s < last; ++s) {
+                        const auto& [p, nv] = pc[index[s]];
+                        sum[0] += p.x(); sum[1] += p.y(); sum[2] += p.z();
+                        if (nv.squared_length() == 0.0) continue;
+                        // Unoriented normals would cancel out; align each with the cell's first normal
+                        if (!reference) reference = &nv;
+                        const double sign = nv.x() * reference->x() + nv.y() * reference->y() + nv.z() * reference->z() < 0.0 ? -1.0 : 1.0;
+                        normal[0] += sign * nv.x(); normal[1] += sign * nv.y(); normal[2] += sign * nv.z();
+                    }
+                    const double count = static_cast<double>(last - first);
+                    const double len = std::sqrt(normal[0] * normal[0] + normal[1] * normal[1] + normal[2] * normal[2]);
+                    out[c].first = Point(sum[0] / count, sum[1] / count, sum[2] / count);
+                    out[c].second = len > 0.0 ? Vector(normal[0] / len, normal[1] / len, normal[2] / len) : Vector(0.0, 0.0, 0.0);
+                    break;
+                }
+            }
+        }
+    }, 1024);
+    pc.swap(out);
+
+    if (stats) {
+        stats->cells = cells;
+        stats->sortPasses = passes;
+    }
+    return true;
+}
+
+} // namespace VoxelDownsample
@@ -0,0 +1,40 @@
+#ifndef POINTTOMESH_VOXELDOWNSAMPLE_H
+#define POINTTOMESH_VOXELDOWNSAMPLE_H
+
+#include <cstddef>
+#include <cstdint>
+
+#include "PointCloudProcessor.h"
+
+// Voxel-grid downsampling that replaces CGAL::grid_simplify_point_set on large clouds.
+// Every point gets the Morton key of its cell (21 bits per axis, relative to the bounding box), the
+// (key, index) pairs are radix-sorted in parallel (stable LSD passes of 8 bits, only as many as the
+// occupied key bits need), and every run of equal keys becomes one output point. The output is in
+// Morton order, which keeps later neighbour queries local.
+namespace VoxelDownsample {
+
+enum class Representative {
+    Centroid,        // mean position; normal = mean of the cell's normals after aligning their signs
+    First,           // the point that came first in the input
+    Random,          // a point picked by a hash of the seed and the cell, so reruns agree
+    ClosestToCenter  // the point nearest the cell center
+};
+
+struct Options {
+    double cellSize {0.0};
+    Representative representative {Representative::Centroid};
+    std::uint64_t seed {0}; // Random only
+};
+
+struct Stats {
+    std::size_t cells {0};  // occupied cells = output points
+    int sortPasses {0};     // radix passes needed for the key range
+};
+
+// Replaces pc by one point per occupied cell. Zero normals count as missing (they do not enter a centroid).
+// Returns false if the cell size is not positive or the grid would need more than 2^21 cells along an axis.
+bool downsample(PointCloud& pc, const Options& options, Stats* stats = nullptr);
+
+} // namespace VoxelDownsample
+
+#endif //POINTTOMESH_VOXELDOWNSAMPLE_H
@@ -0,0 +1,173 @@
+#include "VoxelReconstruction.h"
+#include "MarchingCubes.h"
+#include "Parallel.h"
+#include "SparseGrid.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+
+namespace VoxelReconstruction {
+
+namespace {
+using SparseGrid::BrickLayout;
+
+// Upper bound on voxels along the longest axis; the brick table alone is (res / 8)³ entries
+constexpr int kMaxResolution = 2048;
+// Minimum work per chunk for the node loops
+constexpr std::size_t kMinChunk = 2048;
+
+// One morphology or blur step over all stored nodes; missing neighbours read as empty
+template <class Op>
+void sweep(const BrickLayout& layout, std::vector<float>& field, Op&& op) {
+    std::vector<float> out(field.size(), 0.0f);
+    Parallel::forEach(field.size(), [&](std::size_t i) {
+        const auto node = layout.nodeOf(i);
+        if (layout.inLattice(node)) out[i] = op(node, i);
+    }, kMinChunk);
+    field.swap(out);
+}
+}
+
+bool reconstruct(const PointCloud& pc, const Options& options, std::vector<Point>& points,
+                 std::vector<Triangle>& triangles, Stats* stats) {
+    points.clear();
+    triangles.clear();
+    if (pc.empty()) return false;
+
+    // Bounds, per chunk then merged
+    struct Box { double lo[3], hi[3]; };
+    std::vector<Box> partial(Parallel::chunkCount(pc.size()));
+    Parallel::forChunks(pc.size(), [&](std::size_t c, std::size_t b, std::size_t e) {
+        Box box {{std::numeric_limits<double>::max(), std::numeric_limits<double>::max(), std::numeric_limits<double>::max()},
+                 {std::numeric_limits<double>::lowest(), std::numeric_limits<double>::lowest(), std::numeric_limits<double>::lowest()}};
+        for (std::size_t i = b; i < e; ++i) {
+            const double p[3] = {pc[i].first.x(), pc[i].first.y(), pc[i].first.z()};
+            for (int a = 0; a < 3; ++a) { box.lo[a] = std::min(box.lo[a], p[a]); box.hi[a] = std::max(box.hi[a], p[a]); }
+        }
+        partial[c] = box;
+    });
+    Box box = partial.front();
+    for (const auto& p : partial)
+        for (int a = 0; a < 3; ++a) { box.lo[a] = std::min(box.lo[a], p.lo[a]); box.hi[a] = std::max(box.hi[a], p.hi[a]); }
+    const double ext[3] = {box.hi[0] - box.lo[0], box.hi[1] - box.lo[1], box.hi[2] - box.lo[2]};
+    const double extent = std::max({ext[0], ext[1], ext[2]});
+    if (!(extent > 0.0)) return false;
+
+    // Voxel size: the spacing of the cloud if it filled its bounding box uniformly, scaled
+    double h = options.voxelSize;
+    if (!(h > 0.0)) {
+        double volume = 1.0;
+        for (double e : ext) volume *= std::max(e, extent * 1e-3);
+        h = std::max(0.0, options.spacingScale) * std::cbrt(volume / static_cast<double>(pc.size()));
+    }
+    if (!(h > 0.0)) return false;
+
+    // Empty voxels around the data so the close/blur never reach the lattice border
+    const int close = std::max(0, options.closeIterations);
+    const int smooth = std::max(0, options.smoothingPasses);
+    const int pad = close + smooth + 2;
+    int res = static_cast<int>(std::ceil(extent / h)) + 2 * pad;
+    if (res > kMaxResolution) {
+        res = kMaxResolution;
+        h = extent / (kMaxResolution - 2 * pad);
+    }
+    double origin[3];
+    for (int a = 0; a < 3; ++a) origin[a] = box.lo[a] - pad * h;
+
+    // Voxel centres are the lattice nodes
+    BrickLayout layout(res);
+    const auto nodeOfPoint = [&](const Point& p) {
+        const double v[3] = {p.x(), p.y(), p.z()};
+        std::array<int, 3> n {};
+        for (int a = 0; a < 3; ++a) n[a] = std::clamp(static_cast<int>(std::lround((v[a] - origin[a]) / h)), 0, res);
+        return n;
+    };
+    for (const auto& pn : pc) {
+        const auto n = nodeOfPoint(pn.first);
+        layout.markNode(n[0], n[1], n[2]);
+    }
+    layout.dilate(1 + (close + smooth + BrickLayout::kSize - 1) / BrickLayout::kSize);
+    layout.build();
+    const std::size_t nodes = layout.nodeCount();
+
+    // Bucket points by brick; a point only touches its own node, so bricks are binned in parallel
+    std::vector<std::int64_t> nodeIndex(pc.size());
+    Parallel::forEach(pc.size(), [&](std::size_t i) {
+        const auto n = nodeOfPoint(pc[i].first);
+        nodeIndex[i] = layout.index(n[0], n[1], n[2]);
+    });
+    std::vector<std::size_t> offsets(layout.brickCount() + 1, 0);
+    for (auto idx : nodeIndex) ++offsets[static_cast<std::size_t>(idx) / BrickLayout::kNodes + 1];
+    for (std::size_t b = 1; b < offsets.size(); ++b) offsets[b] += offsets[b - 1];
+    std::vector<std::size_t> order(pc.size());
+    {
+        std::vector<std::size_t> fill(offsets.begin(), offsets.end() - 1);
+        for (std::size_t i = 0; i < pc.size(); ++i) order[fill[static_cast<std::size_t>(nodeIndex[i]) / BrickLayout::kNodes]++] = i;
+    }
+    std::vector<std::uint32_t> counts(nodes, 0);
+    Parallel::forEach(layout.brickCount(), [&](std::size_t b) {
+        for (std::size_t k = offsets[b]; k < offsets[b + 1]; ++k) ++counts[static_cast<std::size_t>(nodeIndex[order[k]])];
+    }, 16);
+    std::vector<std::int64_t>().swap(nodeIndex);
+    std::vector<std::size_t>().swap(order);
+
+    // Occupancy as a fraction of the typical count, so voxels cut by the boundary hold partial values
+    // and the 0.5 level sits on the boundary instead of half a voxel outside it
+    const auto minPoints = static_cast<std::uint32_t>(std::max(1, options.minPointsPerVoxel));
+    std::size_t occupied = 0, inOccupied = 0;
+    for (auto c : counts) {
+        if (c >= minPoints) { ++occupied; inOccupied += c; }
+    }
+    if (occupied == 0) return false;
+    const float fullCount = static_cast<float>(inOccupied) / static_cast<float>(occupied);
+    std::vector<float> field(nodes, 0.0f);
+    Parallel::forEach(nodes, [&](std::size_t i) {
+        field[i] = counts[i] >= minPoints ? std::min(1.0f, static_cast<float>(counts[i]) / fullCount) : 0.0f;
+    }, kMinChunk);
+    std::vector<std::uint32_t>().swap(counts);
+
+    // Morphological close: fills pores and gaps narrower than about 2 × close voxels
+    for (int it = 0; it < close; ++it) {
+        sweep(layout, field, [&](const std::array<int, 3>& node, std::size_t i) {
+            float v = field[i];
+            layout.forEachNeighbor(node, i, [&](int, int, std::size_t nb) { v = std::max(v, field[nb]); });
+            return v;
+        });
+    }
+    for (int it = 0; it < close; ++it) {
+        sweep(layout, field, [&](const std::array<int, 3>& node, std::size_t i) {
+            float v = field[i];
+            int seen = 0;
+            layout.forEachNeighbor(node, i, [&](int, int, std::size_t nb) { v = std::min(v, field[nb]); ++seen; });
+            return seen == 6 ? v : 0.0f;
+        });
+    }
+
+    // Separable [1 2 1] / 4 blur, one axis at a time
+    for (int pass = 0; pass < smooth; ++pass) {
+        for (int axis = 0; axis < 3; ++axis) {
+            sweep(layout, field, [&](const std::array<int, 3>& node, std::size_t i) {
+                float v = 0.5f * field[i];
+                layout.forEachNeighbor(node, i, [&](int a, int, std::size_t nb) { if (a == axis) v += 0.25f * field[nb]; });
+                return v;
+            });
+        }
+    }
+
+    MarchingCubes::Frame frame;
+    for (int a = 0; a < 3; ++a) frame.origin[a] = origin[a];
+    frame.h = h;
+    MarchingCubes::extract(layout, field, 0.5f, frame, nullptr, points, triangles);
+
+    if (stats) {
+        stats->voxelSize = h;
+        stats->resolution = res;
+        stats->occupiedVoxels = occupied;
+        stats->nodes = nodes;
+    }
+    return !triangles.empty();
+}
+
+} // namespace VoxelReconstruction
@@ -0,0 +1,40 @@
+#ifndef POINTTOMESH_VOXELRECONSTRUCTION_H
+#define POINTTOMESH_VOXELRECONSTRUCTION_H
+
+#include <array>
+#include <cstddef>
+#include <vector>
+
+#include "PointCloudProcessor.h"
+
+// Normal-free reconstruction for point sets that fill a volume (uniform volumetric samples).
+// Points are binned into voxels of a sparse lattice in parallel, occupied voxels become 1, an optional
+// morphological close fills the gaps between samples, a few blur passes soften the staircase, and the
+// 0.5 iso-surface is extracted with marching cubes. Every step is linear in the number of points or
+// occupied voxels.
+namespace VoxelReconstruction {
+
+using Triangle = std::array<std::size_t, 3>;
+
+struct Options {
+    double voxelSize {0.0};      // absolute voxel edge; 0 = derived from the point density
+    double spacingScale {2.0};   // auto size: this × the mean spacing of a uniform fill of the bounding box
+    int minPointsPerVoxel {1};   // voxels with fewer points count as empty
+    int closeIterations {1};     // dilate then erode this many times (0 = off)
+    int smoothingPasses {1};     // [1 2 1] blur passes over the occupancy before extraction
+};
+
+struct Stats {
+    double voxelSize {0.0};
+    int resolution {0};             // voxels along the longest axis, padding included
+    std::size_t occupiedVoxels {0}; // after thresholding, before the close
+    std::size_t nodes {0};          // stored lattice nodes
+};
+
+// Returns false if no surface could be extracted
+bool reconstruct(const PointCloud& pc, const Options& options, std::vector<Point>& points,
+                 std::vector<Triangle>& triangles, Stats* stats = nullptr);
+
+} // namespace VoxelReconstruction
+
+#endif //POINTTOMESH_VOXELRECONSTRUCTION_H
@@ -3,16 +3,33 @@
 #include <vector>
 #include <QVector3D>
 #include <cstdint>
+#include <cstddef>
+
+// Summary statistics computed once when a model is built (in the worker thread),
+// so the GUI thread never has to walk every vertex to fit the camera.
+struct GeometryStats {
+    QVector3D minP {-1.0f, -1.0f, -1.0f};
+    QVector3D maxP { 1.0f,  1.0f,  1.0f};
+    std::size_t count {0}; // number of points / vertices contributing
+    bool valid {false};    // false for empty models; min/max then hold a unit box
+
+    [[nodiscard]] QVector3D center() const { return 0.5f * (minP + maxP); }
+    [[nodiscard]] QVector3D extent() const { return maxP - minP; }
+};
 
 struct PointCloudModel {
     std::vector<QVector3D> points;
     // Corresponding per-point normals (same size/order as points). May be zero vectors if not available.
     std::vector<QVector3D> normals;
+    GeometryStats stats;
+    // Increases with every model the worker builds; ties view-side selections to this exact cloud
+    std::uint64_t revision {0};
 };
 
 struct MeshModel {
     std::vector<QVector3D> vertices;
     std::vector<std::uint32_t> indices; // triangle list (3*i,3*i+1,3*i+2)
+    GeometryStats stats;
 };
 
 using PointCloudPtr = std::shared_ptr<const PointCloudModel>;
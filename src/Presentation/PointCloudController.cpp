@@ -14,6 +14,7 @@ PointCloudController::PointCloudController(std::unique_ptr<PointCloudProcessor>
     // Ensure enums and pointer types are known to Qt for queued connections
     qRegisterMetaType<MeshGenerationMethod>("MeshGenerationMethod");
     qRegisterMetaType<NormalEstimationMethod>("NormalEstimationMethod");
+    qRegisterMetaType<PointSetResamplingMethod>("PointSetResamplingMethod");
     qRegisterMetaType<BaseInputParameter*>("BaseInputParameter*");
 
     connect(&m_thread, &QThread::finished, m_worker, &QObject::deleteLater);
@@ -23,13 +24,20 @@ PointCloudController::PointCloudController(std::unique_ptr<PointCloudProcessor>
     connect(this, &PointCloudController::workerReconstructWithParams, m_worker, &ProcessingWorker::reconstructWithParams, Qt::QueuedConnection);
     connect(this, &PointCloudController::workerExport,      m_worker, &ProcessingWorker::exportMeshTo,      Qt::QueuedConnection);
     connect(this, &PointCloudController::workerEstimateNormals, m_worker, &ProcessingWorker::estimateNormals, Qt::QueuedConnection);
+    connect(this, &PointCloudController::workerOrientNormals, m_worker, &ProcessingWorker::orientNormalsWith, Qt::QueuedConnection);
     connect(this, &PointCloudController::workerPostProcessMesh, m_worker, &ProcessingWorker::postProcessMeshWith, Qt::QueuedConnection);
+    connect(this, &PointCloudController::workerDecimateMesh, m_worker, &ProcessingWorker::decimateMeshWith, Qt::QueuedConnection);
 
     // New: point cloud ops wiring
     connect(this, &PointCloudController::workerDownsampleVoxel, m_worker, &ProcessingWorker::downsampleVoxelWith, Qt::QueuedConnection);
+    connect(this, &PointCloudController::workerResamplePointSet, m_worker, &ProcessingWorker::resamplePointSet, Qt::QueuedConnection);
     connect(this, &PointCloudController::workerFilterAABB, m_worker, &ProcessingWorker::filterPointCloudAABB, Qt::QueuedConnection);
     connect(this, &PointCloudController::workerFilterSphere, m_worker, &ProcessingWorker::filterPointCloudSphere, Qt::QueuedConnection);
+    connect(this, &PointCloudController::workerFilterOrientedBox, m_worker, &ProcessingWorker::filterPointCloudOrientedBox, Qt::QueuedConnection);
+    connect(this, &PointCloudController::workerApplyClipPlane, m_worker, &ProcessingWorker::applyClipPlane, Qt::QueuedConnection);
+    connect(this, &PointCloudController::workerFilterSelection, m_worker, &ProcessingWorker::filterPointCloudSelection, Qt::QueuedConnection);
     connect(this, &PointCloudController::workerFilterUniformVolumeSurface, m_worker, &ProcessingWorker::filterUniformVolumeSurface, Qt::QueuedConnection);
+    connect(this, &PointCloudController::workerRemoveOutliers, m_worker, &ProcessingWorker::removeOutliersWith, Qt::QueuedConnection);
 
     // Downstream wiring: worker -> controller
     connect(m_worker, &ProcessingWorker::logMessage,      this, &PointCloudController::onWorkerLog,        Qt::QueuedConnection);
@@ -78,9 +86,16 @@ void PointCloudController::runReconstructionWith(MeshGenerationMethod method, st
     emit workerReconstructWithParams(method, raw);
 }
 
-void PointCloudController::runNormalEstimation(NormalEstimationMethod method) {
+void PointCloudController::runNormalEstimation(NormalEstimationMethod method, std::unique_ptr<BaseInputParameter> params) {
     if (!ensureIdle("runNormalEstimation")) return;
-    emit workerEstimateNormals(method);
+    BaseInputParameter* raw = params.release();
+    emit workerEstimateNormals(method, raw);
+}
+
+void PointCloudController::runOrientNormals(std::unique_ptr<BaseInputParameter> params) {
+    if (!ensureIdle("runOrientNormals")) return;
+    BaseInputParameter* raw = params.release();
+    emit workerOrientNormals(raw);
 }
 
 void PointCloudController::exportMesh(const QString& path, bool withNormals) {
@@ -94,12 +109,24 @@ void PointCloudController::runPostProcessMesh(std::unique_ptr<BaseInputParameter
     emit workerPostProcessMesh(raw);
 }
 
+void PointCloudController::runDecimateMesh(std::unique_ptr<BaseInputParameter> params) {
+    if (!ensureIdle("runDecimateMesh")) return;
+    BaseInputParameter* raw = params.release();
+    emit workerDecimateMesh(raw);
+}
+
 void PointCloudController::runDownsampleVoxel(std::unique_ptr<BaseInputParameter> params) {
     if (!ensureIdle("runDownsampleVoxel")) return;
     BaseInputParameter* raw = params.release();
     emit workerDownsampleVoxel(raw);
 }
 
+void PointCloudController::runResamplePointSet(PointSetResamplingMethod method, std::unique_ptr<BaseInputParameter> params) {
+    if (!ensureIdle("runResamplePointSet")) return;
+    BaseInputParameter* raw = params.release();
+    emit workerResamplePointSet(method, raw);
+}
+
 void PointCloudController::runFilterAABB(std::unique_ptr<BaseInputParameter> params) {
     if (!ensureIdle("runFilterAABB")) return;
     BaseInputParameter* raw = params.release();
@@ -112,8 +139,37 @@ void PointCloudController::runFilterSphere(std::unique_ptr<BaseInputParameter> p
     emit workerFilterSphere(raw);
 }
 
+void PointCloudController::runFilterOrientedBox(std::unique_ptr<BaseInputParameter> params) {
+    if (!ensureIdle("runFilterOrientedBox")) return;
+    BaseInputParameter* raw = params.release();
+    emit workerFilterOrientedBox(raw);
+}
+
+void PointCloudController::runApplyClipPlane(std::unique_ptr<BaseInputParameter> params) {
+    if (!ensureIdle("runApplyClipPlane")) return;
+    BaseInputParameter* raw = params.release();
+    emit workerApplyClipPlane(raw);
+}
+
+void PointCloudController::runFilterSelection(std::unique_ptr<BaseInputParameter> params) {
+    const auto* sel = dynamic_cast<const SelectionMaskFilterParameter*>(params.get());
+    if (!sel || sel->mask.empty()) {
+        emit logMessage(QStringLiteral("No points selected."));
+        return;
+    }
+    if (!ensureIdle("runFilterSelection")) return;
+    BaseInputParameter* raw = params.release();
+    emit workerFilterSelection(raw);
+}
+
 void PointCloudController::runFilterUniformVolumeSurface(std::unique_ptr<BaseInputParameter> params) {
     if (!ensureIdle("runFilterUniformVolumeSurface")) return;
     BaseInputParameter* raw = params.release();
     emit workerFilterUniformVolumeSurface(raw);
 }
+
+void PointCloudController::runRemoveOutliers(std::unique_ptr<BaseInputParameter> params) {
+    if (!ensureIdle("runRemoveOutliers")) return;
+    BaseInputParameter* raw = params.release();
+    emit workerRemoveOutliers(raw);
+}
@@ -17,16 +17,28 @@ public:
 
     // Overload that accepts a parameter object; ownership will be transferred to the worker thread
     void runReconstructionWith(MeshGenerationMethod method, std::unique_ptr<BaseInputParameter> params);
-    // Trigger normal estimation with a selected method
-    void runNormalEstimation(NormalEstimationMethod method);
+    // Trigger normal estimation with a selected method; params (NormalEstimationParameter) go to the worker thread
+    void runNormalEstimation(NormalEstimationMethod method, std::unique_ptr<BaseInputParameter> params);
+    // Re-orient the current normals (NormalOrientationParameter)
+    void runOrientNormals(std::unique_ptr<BaseInputParameter> params);
     // New: post-process mesh with parameters
     void runPostProcessMesh(std::unique_ptr<BaseInputParameter> params);
+    // Quadric-error decimation to a face budget (MeshDecimationParameter)
+    void runDecimateMesh(std::unique_ptr<BaseInputParameter> params);
 
     // New: point cloud ops
     void runDownsampleVoxel(std::unique_ptr<BaseInputParameter> params);
+    // Hierarchy / WLOP simplification or bilateral smoothing; params must match the method
+    void runResamplePointSet(PointSetResamplingMethod method, std::unique_ptr<BaseInputParameter> params);
     void runFilterAABB(std::unique_ptr<BaseInputParameter> params);
     void runFilterSphere(std::unique_ptr<BaseInputParameter> params);
+    void runFilterOrientedBox(std::unique_ptr<BaseInputParameter> params);
+    // Apply a clip plane (HalfSpaceFilterParameter) to the point cloud and the mesh, whichever exist
+    void runApplyClipPlane(std::unique_ptr<BaseInputParameter> params);
+    // Delete or keep the points flagged in a screen-space selection mask
+    void runFilterSelection(std::unique_ptr<BaseInputParameter> params);
     void runFilterUniformVolumeSurface(std::unique_ptr<BaseInputParameter> params);
+    void runRemoveOutliers(std::unique_ptr<BaseInputParameter> params);
 
     // Re-import the last loaded point cloud from disk. If none, emits a log message.
     void resetToOriginal();
@@ -44,14 +56,21 @@ signals:
     void workerImport(const QString& path);
     void workerReconstructWithParams(MeshGenerationMethod method, BaseInputParameter* params); // takes ownership
     void workerExport(const QString& path, bool withNormals);
-    void workerEstimateNormals(NormalEstimationMethod method);
+    void workerEstimateNormals(NormalEstimationMethod method, BaseInputParameter* params); // takes ownership
+    void workerOrientNormals(BaseInputParameter* params);
     void workerPostProcessMesh(BaseInputParameter* params);
+    void workerDecimateMesh(BaseInputParameter* params);
 
     // New: point cloud ops signals
     void workerDownsampleVoxel(BaseInputParameter* params);
+    void workerResamplePointSet(PointSetResamplingMethod method, BaseInputParameter* params);
     void workerFilterAABB(BaseInputParameter* params);
     void workerFilterSphere(BaseInputParameter* params);
+    void workerFilterOrientedBox(BaseInputParameter* params);
+    void workerApplyClipPlane(BaseInputParameter* params);
+    void workerFilterSelection(BaseInputParameter* params);
     void workerFilterUniformVolumeSurface(BaseInputParameter* params);
+    void workerRemoveOutliers(BaseInputParameter* params);
 
 private slots:
     void onWorkerLog(const QString& m) { emit logMessage(m); }
@@ -3,8 +3,10 @@
 #include <QString>
 #include <memory>
 #include <QVector3D>
+#include <algorithm>
 
 #include "../DataProcess/PointCloudProcessor.h"
+#include "../DataProcess/Parallel.h"
 #include "../Model/Geometry.h"
 
 #include <CGAL/Surface_mesh.h>
@@ -14,20 +16,57 @@ ProcessingWorker::ProcessingWorker(std::unique_ptr<PointCloudProcessor> proc, QO
 
 ProcessingWorker::~ProcessingWorker() = default;
 
+namespace {
+// Parallel AABB over model coordinates; each chunk reduces locally, then chunks are merged.
+GeometryStats computeStats(const std::vector<QVector3D>& pts) {
+    GeometryStats stats;
+    if (pts.empty()) return stats;
+
+    struct Partial { QVector3D minP, maxP; bool any {false}; };
+    std::vector<Partial> partials(Parallel::chunkCount(pts.size()));
+    Parallel::forChunks(pts.size(), [&](std::size_t c, std::size_t b, std::size_t e) {
+        Partial part;
+        part.minP = part.maxP = pts[b];
+        for (std::size_t i = b; i < e; ++i) {
+            const QVector3D& v = pts[i];
+            part.minP.setX(std::min(part.minP.x(), v.x())); part.minP.setY(std::min(part.minP.y(), v.y())); part.minP.setZ(std::min(part.minP.z(), v.z()));
+            part.maxP.setX(std::max(part.maxP.x(), v.x())); part.maxP.setY(std::max(part.maxP.y(), v.y())); part.maxP.setZ(std::max(part.maxP.z(), v.z()));
+        }
+        part.any = true;
+        partials[c] = part;
+    });
+
+    bool first = true;
+    for (const auto& part : partials) {
+        if (!part.any) continue;
+        if (first) { stats.minP = part.minP; stats.maxP = part.maxP; first = false; }
+        else {
+            stats.minP.setX(std::min(stats.minP.x(), part.minP.x())); stats.minP.setY(std::min(stats.minP.y(), part.minP.y())); stats.minP.setZ(std::min(stats.minP.z(), part.minP.z()));
+            stats.maxP.setX(std::max(stats.maxP.x(), part.maxP.x())); stats.maxP.setY(std::max(stats.maxP.y(), part.maxP.y())); stats.maxP.setZ(std::max(stats.maxP.z(), part.maxP.z()));
+        }
+    }
+    stats.count = pts.size();
+    stats.valid = true;
+    return stats;
+}
+}
+
 // Helper: convert internal point cloud to UI model
 std::shared_ptr<PointCloudModel> ProcessingWorker::toPointCloudModel(const PointCloud& pc) const {
     auto model = std::make_shared<PointCloudModel>();
-    model->points.reserve(pc.size());
-    model->normals.reserve(pc.size());
-    for (const auto& pn : pc) {
-        const auto& p = pn.first;
-        const auto& n = pn.second;
-        model->points.emplace_back(static_cast<float>(p.x()), static_cast<float>(p.y()), static_cast<float>(p.z()));
+    model->points.resize(pc.size());
+    model->normals.resize(pc.size());
+    Parallel::forEach(pc.size(), [&](std::size_t i) {
+        const auto& p = pc[i].first;
+        const auto& n = pc[i].second;
+        model->points[i] = QVector3D(static_cast<float>(p.x()), static_cast<float>(p.y()), static_cast<float>(p.z()));
         if (n != CGAL::NULL_VECTOR)
-            model->normals.emplace_back(static_cast<float>(n.x()), static_cast<float>(n.y()), static_cast<float>(n.z()));
+            model->normals[i] = QVector3D(static_cast<float>(n.x()), static_cast<float>(n.y()), static_cast<float>(n.z()));
         else
-            model->normals.emplace_back(0.0f, 0.0f, 0.0f);
-    }
+            model->normals[i] = QVector3D(0.0f, 0.0f, 0.0f);
+    });
+    model->stats = computeStats(model->points);
+    model->revision = ++m_cloudModelRevision;
     return model;
 }
 
@@ -35,25 +74,40 @@ std::shared_ptr<PointCloudModel> ProcessingWorker::toPointCloudModel(const Point
 std::shared_ptr<MeshModel> ProcessingWorker::toMeshModel(const Mesh& mesh) const {
     auto model = std::make_shared<MeshModel>();
     const auto nv = static_cast<std::size_t>(num_vertices(mesh));
-    model->vertices.reserve(nv);
 
-    std::vector<std::uint32_t> vmap(nv);
-    std::uint32_t idx = 0;
-    for (auto v : mesh.vertices()) {
-        const auto& p = mesh.point(v);
-        model->vertices.emplace_back(static_cast<float>(p.x()), static_cast<float>(p.y()), static_cast<float>(p.z()));
-        vmap[static_cast<std::size_t>(v.idx())] = idx++;
-    }
+    // Live vertices in iteration order (skips removed elements), then convert in parallel
+    std::vector<Mesh::Vertex_index> live;
+    live.reserve(nv);
+    for (auto v : mesh.vertices()) live.push_back(v);
 
-    for (auto f : mesh.faces()) {
-        std::vector<std::uint32_t> faceIdx;
-        for (auto v : CGAL::vertices_around_face(mesh.halfedge(f), mesh)) {
-            faceIdx.push_back(vmap[static_cast<std::size_t>(v.idx())]);
-        }
-        if (faceIdx.size() == 3) {
-            model->indices.insert(model->indices.end(), { faceIdx[0], faceIdx[1], faceIdx[2] });
+    std::vector<std::uint32_t> vmap(mesh.number_of_vertices() + mesh.number_of_removed_vertices());
+    model->vertices.resize(live.size());
+    Parallel::forEach(live.size(), [&](std::size_t i) {
+        const auto& p = mesh.point(live[i]);
+        model->vertices[i] = QVector3D(static_cast<float>(p.x()), static_cast<float>(p.y()), static_cast<float>(p.z()));
+        vmap[static_cast<std::size_t>(live[i].idx())] = static_cast<std::uint32_t>(i);
+    });
+
+    // Triangles only: count per chunk, turn the counts into offsets, then write the indices in parallel
+    const std::vector<Mesh::Face_index> faces(mesh.faces().begin(), mesh.faces().end());
+    std::vector<std::size_t> offsets(Parallel::chunkCount(faces.size()) + 1, 0);
+    Parallel::forChunks(faces.size(), [&](std::size_t c, std::size_t b, std::size_t e) {
+        std::size_t count = 0;
+        for (std::size_t i = b; i < e; ++i) count += mesh.degree(faces[i]) == 3;
+        offsets[c + 1] = count;
+    });
+    for (std::size_t c = 1; c < offsets.size(); ++c) offsets[c] += offsets[c - 1];
+    model->indices.resize(3 * offsets.back());
+    Parallel::forChunks(faces.size(), [&](std::size_t c, std::size_t b, std::size_t e) {
+        std::size_t w = 3 * offsets[c];
+        for (std::size_t i = b; i < e; ++i) {
+            if (mesh.degree(faces[i]) != 3) continue;
+            for (auto v : CGAL::vertices_around_face(mesh.halfedge(faces[i]), mesh)) {
+                model->indices[w++] = vmap[static_cast<std::size_t>(v.idx())];
+            }
         }
-    }
+    });
+    model->stats = computeStats(model->vertices);
     return model;
 }
 
@@ -64,11 +118,18 @@ struct TaskScope {
 };
 }
 
+void ProcessingWorker::emitProcessorMessages() {
+    if (!m_proc) return;
+    for (const auto& m : m_proc->takeMessages()) emit logMessage(QString::fromStdString(m));
+}
+
 void ProcessingWorker::importPointCloud(const QString& filePath) {
     TaskScope scope{this};
     if (!m_proc) { emit logMessage("Processor not initialized."); return; }
     const std::string path = filePath.toStdString();
-    if (!m_proc->loadPointCloud(path)) {
+    const bool loaded = m_proc->loadPointCloud(path);
+    emitProcessorMessages();
+    if (!loaded) {
         emit logMessage(QStringLiteral("Failed to load point cloud: ") + filePath);
         return;
     }
@@ -88,20 +149,35 @@ void ProcessingWorker::reconstructWithParams(MeshGenerationMethod method, BaseIn
             case MeshGenerationMethod::POISSON_RECONSTRUCTION: return QStringLiteral("Poisson Reconstruction");
             case MeshGenerationMethod::SCALE_SPACE_RECONSTRUCTION: return QStringLiteral("Scale-Space Reconstruction");
             case MeshGenerationMethod::ADVANCING_FRONT_RECONSTRUCTION: return QStringLiteral("Advancing Front Reconstruction");
+            case MeshGenerationMethod::SCREENED_POISSON_RECONSTRUCTION: return QStringLiteral("Screened Poisson Reconstruction");
+            case MeshGenerationMethod::VOXEL_RECONSTRUCTION: return QStringLiteral("Voxel Reconstruction");
             default: return QStringLiteral("Unknown Reconstruction");
         }
     }();
 
-    if (method == MeshGenerationMethod::POISSON_RECONSTRUCTION && !m_proc->hasNormals()) {
-        emit logMessage(QStringLiteral("Estimating normals (required for Poisson)..."));
-        if (!m_proc->estimateNormals(NormalEstimationMethod::JET_ESTIMATION)) {
+    const bool needsNormals = method == MeshGenerationMethod::POISSON_RECONSTRUCTION ||
+                              method == MeshGenerationMethod::SCREENED_POISSON_RECONSTRUCTION;
+    if (needsNormals && !m_proc->hasNormals()) {
+        // Only the points without a valid normal are estimated; a cloud without any gets the full pass
+        const std::size_t missing = m_proc->missingNormalCount();
+        const std::size_t total = m_proc->getPointCloud().size();
+        emit logMessage(missing < total
+                            ? QStringLiteral("Estimating %1 missing normals (required for Poisson)...").arg(missing)
+                            : QStringLiteral("Estimating normals (required for Poisson)..."));
+        NormalEstimationParameter repair;
+        repair.only_missing = true;
+        const bool estimated = m_proc->estimateNormals(NormalEstimationMethod::JET_ESTIMATION, &repair);
+        emitProcessorMessages();
+        if (!estimated) {
             emit logMessage(QStringLiteral("Normal estimation failed."));
             return;
         }
     }
 
     emit logMessage(QStringLiteral("Running ") + methodName + QStringLiteral(" with parameters..."));
-    if (!m_proc->processToMesh(method, guard.get())) {
+    const bool ok = m_proc->processToMesh(method, guard.get());
+    emitProcessorMessages();
+    if (!ok) {
         emit logMessage(methodName + QStringLiteral(" failed."));
         return;
     }
@@ -121,8 +197,9 @@ void ProcessingWorker::exportMeshTo(const QString& filePath, bool withNormals) {
     emit logMessage(QStringLiteral("Exported mesh to: ") + filePath);
 }
 
-void ProcessingWorker::estimateNormals(NormalEstimationMethod method) {
+void ProcessingWorker::estimateNormals(NormalEstimationMethod method, BaseInputParameter* params) {
     TaskScope scope{this};
+    std::unique_ptr<BaseInputParameter> guard(params);
     if (!m_proc) { emit logMessage("Processor not initialized."); return; }
 
     const auto methodName = [method]() -> QString {
@@ -130,12 +207,15 @@ void ProcessingWorker::estimateNormals(NormalEstimationMethod method) {
             case NormalEstimationMethod::JET_ESTIMATION: return QStringLiteral("Jet estimation");
             case NormalEstimationMethod::UNIFORM_VOLUME_CENTROID: return QStringLiteral("Uniform centroid estimation");
             case NormalEstimationMethod::VCM_ESTIMATION: return QStringLiteral("VCM estimation");
+            case NormalEstimationMethod::PCA_ESTIMATION: return QStringLiteral("PCA estimation");
             default: return QStringLiteral("Unknown normal estimation");
         }
     }();
 
     emit logMessage(QStringLiteral("Estimating normals using ") + methodName + QStringLiteral("..."));
-    if (!m_proc->estimateNormals(method)) {
+    const bool ok = m_proc->estimateNormals(method, guard.get());
+    emitProcessorMessages();
+    if (!ok) {
         emit logMessage(QStringLiteral("Normal estimation failed."));
         return;
     }
@@ -144,6 +224,23 @@ void ProcessingWorker::estimateNormals(NormalEstimationMethod method) {
     emit logMessage(QStringLiteral("Normals updated."));
 }
 
+void ProcessingWorker::orientNormalsWith(BaseInputParameter* params) {
+    TaskScope scope{this};
+    std::unique_ptr<BaseInputParameter> guard(params);
+    if (!m_proc) { emit logMessage("Processor not initialized."); return; }
+
+    emit logMessage(QStringLiteral("Orienting normals..."));
+    const bool ok = m_proc->orientNormals(guard.get());
+    emitProcessorMessages();
+    if (!ok) {
+        emit logMessage(QStringLiteral("Normal orientation failed."));
+        return;
+    }
+
+    emit pointCloudReady(toPointCloudModel(m_proc->getPointCloud()));
+    emit logMessage(QStringLiteral("Normal orientation finished."));
+}
+
 void ProcessingWorker::postProcessMeshWith(BaseInputParameter* params) {
     TaskScope scope{this};
     // Takes ownership
@@ -151,7 +248,9 @@ void ProcessingWorker::postProcessMeshWith(BaseInputParameter* params) {
     if (!m_proc) { emit logMessage("Processor not initialized."); return; }
 
     emit logMessage(QStringLiteral("Post-processing mesh..."));
-    if (!m_proc->postProcessMesh(guard.get())) {
+    const bool processed = m_proc->postProcessMesh(guard.get());
+    emitProcessorMessages();
+    if (!processed) {
         emit logMessage(QStringLiteral("Mesh post-process failed."));
         return;
     }
@@ -160,13 +259,32 @@ void ProcessingWorker::postProcessMeshWith(BaseInputParameter* params) {
     emit logMessage(QStringLiteral("Mesh post-process finished."));
 }
 
+void ProcessingWorker::decimateMeshWith(BaseInputParameter* params) {
+    TaskScope scope{this};
+    std::unique_ptr<BaseInputParameter> guard(params);
+    if (!m_proc) { emit logMessage("Processor not initialized."); return; }
+
+    emit logMessage(QStringLiteral("Decimating mesh..."));
+    const bool decimated = m_proc->decimateMesh(guard.get());
+    emitProcessorMessages();
+    if (!decimated) {
+        emit logMessage(QStringLiteral("Mesh decimation failed."));
+        return;
+    }
+
+    emit meshReady(toMeshModel(m_proc->getMesh()));
+    emit logMessage(QStringLiteral("Mesh decimation finished."));
+}
+
 void ProcessingWorker::downsampleVoxelWith(BaseInputParameter* params) {
     TaskScope scope{this};
     std::unique_ptr<BaseInputParameter> guard(params);
     if (!m_proc) { emit logMessage("Processor not initialized."); return; }
     const auto before = static_cast<long long>(m_proc->getPointCloud().size());
     emit logMessage(QStringLiteral("Downsampling point cloud (voxel grid)..."));
-    if (!m_proc->downsampleVoxel(guard.get())) {
+    const bool downsampled = m_proc->downsampleVoxel(guard.get());
+    emitProcessorMessages();
+    if (!downsampled) {
         emit logMessage(QStringLiteral("Voxel downsample failed."));
         return;
     }
@@ -178,6 +296,36 @@ void ProcessingWorker::downsampleVoxelWith(BaseInputParameter* params) {
     emit logMessage(QStringLiteral("Voxel downsample finished."));
 }
 
+void ProcessingWorker::resamplePointSet(PointSetResamplingMethod method, BaseInputParameter* params) {
+    TaskScope scope{this};
+    std::unique_ptr<BaseInputParameter> guard(params);
+    if (!m_proc) { emit logMessage("Processor not initialized."); return; }
+
+    const auto methodName = [method]() -> QString {
+        switch (method) {
+            case PointSetResamplingMethod::HIERARCHY_SIMPLIFY: return QStringLiteral("Hierarchy simplification");
+            case PointSetResamplingMethod::WLOP_SIMPLIFY: return QStringLiteral("WLOP simplification");
+            case PointSetResamplingMethod::BILATERAL_SMOOTHING: return QStringLiteral("Bilateral smoothing");
+            default: return QStringLiteral("Unknown resampling");
+        }
+    }();
+
+    const auto before = static_cast<long long>(m_proc->getPointCloud().size());
+    emit logMessage(methodName + QStringLiteral("..."));
+    const bool ok = m_proc->resamplePointSet(method, guard.get());
+    emitProcessorMessages();
+    if (!ok) {
+        emit logMessage(methodName + QStringLiteral(" failed."));
+        return;
+    }
+    const auto after = static_cast<long long>(m_proc->getPointCloud().size());
+    const auto delta = after - before;
+    emit logMessage(QStringLiteral("Points: ") + QString::number(before) + QStringLiteral(" -> ") + QString::number(after) +
+                    QStringLiteral(" (Δ ") + QString::number(delta) + QStringLiteral(")"));
+    emit pointCloudReady(toPointCloudModel(m_proc->getPointCloud()));
+    emit logMessage(methodName + QStringLiteral(" finished."));
+}
+
 void ProcessingWorker::filterPointCloudAABB(BaseInputParameter* params) {
     TaskScope scope{this};
     std::unique_ptr<BaseInputParameter> guard(params);
@@ -214,13 +362,92 @@ void ProcessingWorker::filterPointCloudSphere(BaseInputParameter* params) {
     emit logMessage(QStringLiteral("Sphere filter finished."));
 }
 
+void ProcessingWorker::filterPointCloudOrientedBox(BaseInputParameter* params) {
+    TaskScope scope{this};
+    std::unique_ptr<BaseInputParameter> guard(params);
+    if (!m_proc) { emit logMessage("Processor not initialized."); return; }
+    const auto before = static_cast<long long>(m_proc->getPointCloud().size());
+    emit logMessage(QStringLiteral("Filtering point cloud by oriented box..."));
+    if (!m_proc->filterOrientedBox(guard.get())) {
+        emit logMessage(QStringLiteral("Oriented box filter failed."));
+        return;
+    }
+    const auto after = static_cast<long long>(m_proc->getPointCloud().size());
+    const auto delta = after - before;
+    emit logMessage(QStringLiteral("Points: ") + QString::number(before) + QStringLiteral(" -> ") + QString::number(after) +
+                    QStringLiteral(" (Δ ") + QString::number(delta) + QStringLiteral(")"));
+    emit pointCloudReady(toPointCloudModel(m_proc->getPointCloud()));
+    emit logMessage(QStringLiteral("Oriented box filter finished."));
+}
+
+void ProcessingWorker::applyClipPlane(BaseInputParameter* params) {
+    TaskScope scope{this};
+    std::unique_ptr<BaseInputParameter> guard(params);
+    if (!m_proc) { emit logMessage("Processor not initialized."); return; }
+    const bool hasPoints = !m_proc->getPointCloud().empty();
+    const bool hasMesh = !m_proc->getMesh().is_empty();
+    if (!hasPoints && !hasMesh) { emit logMessage(QStringLiteral("Nothing to clip: no point cloud or mesh loaded.")); return; }
+
+    emit logMessage(QStringLiteral("Applying clip plane..."));
+    bool applied = false;
+    if (hasPoints) {
+        const auto before = static_cast<long long>(m_proc->getPointCloud().size());
+        if (m_proc->filterHalfSpace(guard.get())) {
+            const auto after = static_cast<long long>(m_proc->getPointCloud().size());
+            emit logMessage(QStringLiteral("Points: ") + QString::number(before) + QStringLiteral(" -> ") + QString::number(after) +
+                            QStringLiteral(" (Δ ") + QString::number(after - before) + QStringLiteral(")"));
+            emit pointCloudReady(toPointCloudModel(m_proc->getPointCloud()));
+            applied = true;
+        } else {
+            emit logMessage(QStringLiteral("Point cloud clip failed."));
+        }
+    }
+    if (hasMesh) {
+        if (m_proc->clipMesh(guard.get())) {
+            emit meshReady(toMeshModel(m_proc->getMesh()));
+            applied = true;
+        } else {
+            emit logMessage(QStringLiteral("Mesh clip failed."));
+        }
+    }
+    emitProcessorMessages();
+    emit logMessage(applied ? QStringLiteral("Clip plane applied.") : QStringLiteral("Clip plane failed."));
+}
+
+void ProcessingWorker::filterPointCloudSelection(BaseInputParameter* params) {
+    TaskScope scope{this};
+    std::unique_ptr<BaseInputParameter> guard(params);
+    if (!m_proc) { emit logMessage("Processor not initialized."); return; }
+    const auto before = static_cast<long long>(m_proc->getPointCloud().size());
+    const auto* sel = dynamic_cast<const SelectionMaskFilterParameter*>(guard.get());
+    // The mask indexes the cloud the user saw; any later model (even of the same size) invalidates it
+    if (sel && sel->cloudRevision != m_cloudModelRevision) {
+        emit logMessage(QStringLiteral("Selection is stale: the point cloud changed since it was made. Select again."));
+        return;
+    }
+    emit logMessage(sel && sel->keepSelected ? QStringLiteral("Keeping selected points...")
+                                             : QStringLiteral("Deleting selected points..."));
+    if (!m_proc->filterByMask(guard.get())) {
+        emit logMessage(QStringLiteral("Selection filter failed (selection is stale or empty cloud)."));
+        return;
+    }
+    const auto after = static_cast<long long>(m_proc->getPointCloud().size());
+    const auto delta = after - before;
+    emit logMessage(QStringLiteral("Points: ") + QString::number(before) + QStringLiteral(" -> ") + QString::number(after) +
+                    QStringLiteral(" (Δ ") + QString::number(delta) + QStringLiteral(")"));
+    emit pointCloudReady(toPointCloudModel(m_proc->getPointCloud()));
+    emit logMessage(QStringLiteral("Selection filter finished."));
+}
+
 void ProcessingWorker::filterUniformVolumeSurface(BaseInputParameter* params) {
     TaskScope scope{this};
     std::unique_ptr<BaseInputParameter> guard(params);
     if (!m_proc) { emit logMessage("Processor not initialized."); return; }
     const auto before = static_cast<long long>(m_proc->getPointCloud().size());
     emit logMessage(QStringLiteral("Filtering surface points from uniform volume..."));
-    if (!m_proc->filterSurfaceFromUniformVolume(guard.get())) {
+    const bool filtered = m_proc->filterSurfaceFromUniformVolume(guard.get());
+    emitProcessorMessages();
+    if (!filtered) {
         emit logMessage(QStringLiteral("Uniform-volume surface filter failed."));
         return;
     }
@@ -231,3 +458,23 @@ void ProcessingWorker::filterUniformVolumeSurface(BaseInputParameter* params) {
     emit pointCloudReady(toPointCloudModel(m_proc->getPointCloud()));
     emit logMessage(QStringLiteral("Uniform-volume surface filter finished."));
 }
+
+void ProcessingWorker::removeOutliersWith(BaseInputParameter* params) {
+    TaskScope scope{this};
+    std::unique_ptr<BaseInputParameter> guard(params);
+    if (!m_proc) { emit logMessage("Processor not initialized."); return; }
+    const auto before = static_cast<long long>(m_proc->getPointCloud().size());
+    emit logMessage(QStringLiteral("Removing outliers..."));
+    const bool removed = m_proc->removeOutliers(guard.get());
+    emitProcessorMessages();
+    if (!removed) {
+        emit logMessage(QStringLiteral("Outlier removal failed."));
+        return;
+    }
+    const auto after = static_cast<long long>(m_proc->getPointCloud().size());
+    const auto delta = after - before;
+    emit logMessage(QStringLiteral("Points: ") + QString::number(before) + QStringLiteral(" -> ") + QString::number(after) +
+                    QStringLiteral(" (Δ ") + QString::number(delta) + QStringLiteral(")"));
+    emit pointCloudReady(toPointCloudModel(m_proc->getPointCloud()));
+    emit logMessage(QStringLiteral("Outlier removal finished."));
+}
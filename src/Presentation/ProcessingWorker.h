@@ -17,15 +17,26 @@ public slots:
     // Parameterized reconstruction; takes ownership of params and deletes it in worker thread
     void reconstructWithParams(MeshGenerationMethod method, BaseInputParameter* params);
     void exportMeshTo(const QString& filePath, bool withNormals);
-    void estimateNormals(NormalEstimationMethod method);
+    // Normal estimation; takes ownership of params (NormalEstimationParameter, may be null for defaults)
+    void estimateNormals(NormalEstimationMethod method, BaseInputParameter* params);
+    // Re-orient existing normals; takes ownership of params
+    void orientNormalsWith(BaseInputParameter* params);
     // New: mesh post-process; takes ownership of params and deletes in worker thread
     void postProcessMeshWith(BaseInputParameter* params);
+    // Quadric-error decimation; takes ownership of params (MeshDecimationParameter)
+    void decimateMeshWith(BaseInputParameter* params);
 
     // New: point cloud operations
     void downsampleVoxelWith(BaseInputParameter* params);
+    void resamplePointSet(PointSetResamplingMethod method, BaseInputParameter* params);
     void filterPointCloudAABB(BaseInputParameter* params);
     void filterPointCloudSphere(BaseInputParameter* params);
+    void filterPointCloudOrientedBox(BaseInputParameter* params);
+    // Crop the point cloud and clip the mesh with the same plane (HalfSpaceFilterParameter)
+    void applyClipPlane(BaseInputParameter* params);
+    void filterPointCloudSelection(BaseInputParameter* params);
     void filterUniformVolumeSurface(BaseInputParameter* params);
+    void removeOutliersWith(BaseInputParameter* params);
 
 signals:
     void logMessage(const QString& message);
@@ -38,6 +49,10 @@ private:
     std::unique_ptr<PointCloudProcessor> m_proc;
 
     // Helpers to reduce duplication
+    // Forward informational messages collected by the processor to the log
+    void emitProcessorMessages();
     [[nodiscard]] std::shared_ptr<PointCloudModel> toPointCloudModel(const PointCloud& pc) const;
+    // Revision of the last point cloud model handed to the view
+    mutable std::uint64_t m_cloudModelRevision {0};
     [[nodiscard]] std::shared_ptr<MeshModel> toMeshModel(const Mesh& mesh) const;
 };
@@ -4,16 +4,67 @@
 #include <QOpenGLContext>
 #include <QSurfaceFormat>
 #include <algorithm>
+#include <cmath>
 #include <QKeyEvent>
+#include <QShowEvent>
+#include <QHideEvent>
+#include <QImage>
+#include <QPainter>
+#include "../DataProcess/Parallel.h"
+
+namespace {
+// Minimum interval between frameStatsUpdated emissions
+constexpr qint64 kStatsIntervalMs = 500;
+// Gaps longer than this between frames are idle time, not frame time
+constexpr qint64 kIdleGapMs = 250;
+// Weight of the newest sample in the moving averages
+constexpr double kStatsSmoothing = 0.1;
+// Minimum mouse travel (widget pixels) before a new lasso vertex is recorded
+constexpr int kLassoMinStepPx = 3;
+// A point still counts as visible if it lies at most this fraction of the depth behind the front surface
+// (neighbouring points on the same surface share pixels with it)
+constexpr float kSelectDepthTolerance = 0.01f;
+}
 
 RenderView::RenderView(QWidget* parent) : QOpenGLWidget(parent) {
     // Initialize from persisted settings so colors/toggles apply at startup
     m_cfg = SettingsManager::instance().loadRenderSettings();
     // Receive keyboard focus for WASD controls
     setFocusPolicy(Qt::StrongFocus);
-    // Smooth movement timer setup
-    m_moveTimer.setTimerType(Qt::PreciseTimer);
-    connect(&m_moveTimer, &QTimer::timeout, this, &RenderView::onMoveTick);
+    // Frame pacing: frameSwapped fires once per presented (vsync'd) frame
+    connect(this, &QOpenGLWidget::frameSwapped, this, &RenderView::onFrameSwapped);
+}
+
+RenderView::~RenderView() {
+    // The context outlives this object's members; don't let its aboutToBeDestroyed reach us
+    if (context()) disconnect(context(), &QOpenGLContext::aboutToBeDestroyed, this, &RenderView::cleanupGL);
+    cleanupGL();
+}
+
+void RenderView::cleanupGL() {
+    if (!context()) return;
+    makeCurrent();
+    m_renderer.cleanup();
+    doneCurrent();
+}
+
+void RenderView::requestFrame() {
+    // A hidden or empty widget gets no paintGL to clear the flag; just forward the update then
+    if (!isVisible() || width() <= 0 || height() <= 0) { update(); return; }
+    if (m_frameRequested) return;
+    m_frameRequested = true;
+    update();
+}
+
+void RenderView::showEvent(QShowEvent* e) {
+    QOpenGLWidget::showEvent(e);
+    m_frameRequested = false;
+    requestFrame();
+}
+
+void RenderView::hideEvent(QHideEvent* e) {
+    m_frameRequested = false;
+    QOpenGLWidget::hideEvent(e);
 }
 
 void RenderView::setPointCloud(PointCloudPtr cloud) {
@@ -22,8 +73,14 @@ void RenderView::setPointCloud(PointCloudPtr cloud) {
         m_cloud = std::move(cloud);
         m_pointsDirty = true;
     }
+    // Indices of the previous cloud are meaningless for the new one
+    if (!m_selMask.empty()) {
+        m_selMask.clear();
+        m_selCount = 0;
+        emit selectionChanged(0, 0);
+    }
     refitCameraToData();
-    update();
+    requestFrame();
 }
 
 void RenderView::setMesh(MeshPtr mesh) {
@@ -33,7 +90,7 @@ void RenderView::setMesh(MeshPtr mesh) {
         m_meshDirty = true;
     }
     refitCameraToData();
-    update();
+    requestFrame();
 }
 
 void RenderView::setClipPlaneFromNormalAndPoint(const QVector3D &normal, const QVector3D &point) {
@@ -41,7 +98,7 @@ void RenderView::setClipPlaneFromNormalAndPoint(const QVector3D &normal, const Q
     if (n.lengthSquared() > 0.0f) n.normalize();
     const float d = -QVector3D::dotProduct(n, point);
     m_cfg.clipPlaneParams.clipPlane = QVector4D(n, d);
-    update();
+    requestFrame();
 }
 
 static QVector3D cameraForwardFromView(const QMatrix4x4& view) {
@@ -70,7 +127,7 @@ void RenderView::alignClipPlaneNormalToCamera() {
     const QVector3D fwd = cameraForwardFromView(m_camera.viewMatrix());
     QVector4D p = m_cfg.clipPlaneParams.clipPlane;
     m_cfg.clipPlaneParams.clipPlane = QVector4D(fwd, p.w()); // keep d unchanged
-    update();
+    requestFrame();
 }
 
 void RenderView::initializeGL() {
@@ -80,6 +137,9 @@ void RenderView::initializeGL() {
         qInfo("Using OpenGL %d.%d %s profile", f.majorVersion(), f.minorVersion(), f.profile() == QSurfaceFormat::CoreProfile ? "core" : "compat");
     }
 
+    // Reparenting to another window replaces the context; free our GL objects before it goes
+    connect(context(), &QOpenGLContext::aboutToBeDestroyed, this, &RenderView::cleanupGL, Qt::UniqueConnection);
+
     QString err;
     if (!m_renderer.initialize(m_shaders, &err)) {
         qWarning("Renderer init failed: %s", qPrintable(err));
@@ -88,19 +148,22 @@ void RenderView::initializeGL() {
 
 void RenderView::resizeGL(int w, int h) {
     Q_UNUSED(w); Q_UNUSED(h);
+    m_frameRequested = false; // a resize always repaints
 }
 
 void RenderView::computeBounds(const PointCloudPtr& cloud, const MeshPtr& mesh, QVector3D& minP, QVector3D& maxP) {
+    // Merge the statistics cached on the models; never walks the vertex arrays
     bool first = true;
-    auto acc = [&](const QVector3D& v){
-        if (first) { minP = maxP = v; first = false; }
+    auto acc = [&](const GeometryStats& st){
+        if (!st.valid) return;
+        if (first) { minP = st.minP; maxP = st.maxP; first = false; }
         else {
-            minP.setX(std::min(minP.x(), v.x())); minP.setY(std::min(minP.y(), v.y())); minP.setZ(std::min(minP.z(), v.z()));
-            maxP.setX(std::max(maxP.x(), v.x())); maxP.setY(std::max(maxP.y(), v.y())); maxP.setZ(std::max(maxP.z(), v.z()));
+            minP.setX(std::min(minP.x(), st.minP.x())); minP.setY(std::min(minP.y(), st.minP.y())); minP.setZ(std::min(minP.z(), st.minP.z()));
+            maxP.setX(std::max(maxP.x(), st.maxP.x())); maxP.setY(std::max(maxP.y(), st.maxP.y())); maxP.setZ(std::max(maxP.z(), st.maxP.z()));
         }
     };
-    if (cloud) { for (const auto& p : cloud->points) acc(p); }
-    if (mesh)  { for (const auto& v : mesh->vertices) acc(v); }
+    if (cloud) acc(cloud->stats);
+    if (mesh)  acc(mesh->stats);
     if (first) { minP = QVector3D(-1,-1,-1); maxP = QVector3D(1,1,1); }
 }
 
@@ -119,8 +182,7 @@ void RenderView::refitCameraToData() {
     m_camera.setNearFar(0.01f, std::max(1000.0f, 10.0f*radius));
 }
 
-void RenderView::paintGL() {
-    // Upload on demand
+void RenderView::uploadPendingData() {
     if (m_pointsDirty) {
         PointCloudPtr c; { QMutexLocker lock(&m_mutex); c = m_cloud; m_pointsDirty = false; }
         m_renderer.updatePoints(c);
@@ -129,38 +191,291 @@ void RenderView::paintGL() {
         MeshPtr m; { QMutexLocker lock(&m_mutex); m = m_mesh; m_meshDirty = false; }
         m_renderer.updateMesh(m);
     }
+}
+
+void RenderView::paintGL() {
+    m_frameRequested = false;
+    QElapsedTimer cpu; cpu.start();
+
+    uploadPendingData();
 
     // Use framebuffer pixel size to account for high-DPI displays
     const qreal dpr = devicePixelRatioF();
     const QSize pixelSize(qRound(width() * dpr), qRound(height() * dpr));
     m_renderer.draw(m_camera, m_cfg, pixelSize);
+
+    // Selection outline (widget coordinates); QPainter resets its GL state on end()
+    if (m_selecting && m_selPath.size() > 1) {
+        QPainter painter(this);
+        painter.setRenderHint(QPainter::Antialiasing);
+        painter.setPen(QPen(QColor(255, 210, 60), 1.0, Qt::DashLine));
+        painter.setBrush(QColor(255, 210, 60, 40));
+        painter.drawPolygon(m_selPath);
+    }
+
+    const double ms = static_cast<double>(cpu.nsecsElapsed()) / 1.0e6;
+    m_stats.frameTimeMs = m_stats.frames == 0 ? ms : (1.0 - kStatsSmoothing) * m_stats.frameTimeMs + kStatsSmoothing * ms;
+}
+
+void RenderView::onFrameSwapped() {
+    // Presentation interval statistics; long gaps mean the view was idle
+    ++m_stats.frames;
+    if (m_frameClock.isValid()) {
+        const qint64 gapMs = m_frameClock.elapsed();
+        if (gapMs <= kIdleGapMs) {
+            const double interval = static_cast<double>(m_frameClock.nsecsElapsed()) / 1.0e6;
+            m_stats.intervalMs = m_stats.intervalMs <= 0.0 ? interval : (1.0 - kStatsSmoothing) * m_stats.intervalMs + kStatsSmoothing * interval;
+            m_stats.fps = m_stats.intervalMs > 0.0 ? 1000.0 / m_stats.intervalMs : 0.0;
+        }
+    }
+    m_frameClock.restart();
+    if (!m_statsClock.isValid() || m_statsClock.elapsed() >= kStatsIntervalMs) {
+        m_statsClock.restart();
+        emit frameStatsUpdated(m_stats);
+    }
+
+    // Continuous camera motion is stepped once per presented frame, so it is paced by vsync
+    if (!isMoving()) {
+        m_elapsed.invalidate();
+        return;
+    }
+    if (!m_elapsed.isValid()) {
+        m_elapsed.restart();
+        requestFrame();
+        return;
+    }
+    const float dt = static_cast<float>(m_elapsed.nsecsElapsed()) / 1.0e9f;
+    m_elapsed.restart();
+    // Clamp so a stalled frame does not teleport the camera
+    advanceCameraMotion(std::min(dt, 0.1f));
+    requestFrame();
 }
 
 void RenderView::mousePressEvent(QMouseEvent* e) {
     m_lastPos = e->pos();
+    if (e->button() == Qt::LeftButton && (e->modifiers() & Qt::ControlModifier)) {
+        // Ctrl+Left picks instead of orbiting
+        pickAt(e->pos());
+        if (!hasFocus()) setFocus(Qt::MouseFocusReason);
+        return;
+    }
+    if (e->button() == Qt::LeftButton && m_selMode != SelectionMode::None) {
+        m_selecting = true;
+        m_selPath = QPolygon();
+        m_selPath << e->pos();
+        if (!hasFocus()) setFocus(Qt::MouseFocusReason);
+        return;
+    }
     if (e->button() == Qt::LeftButton) m_leftDown = true;
     if (e->button() == Qt::RightButton || e->button() == Qt::MiddleButton) m_rightDown = true;
     // Ensure we receive subsequent key events
     if (!hasFocus()) setFocus(Qt::MouseFocusReason);
 }
 
+void RenderView::mouseReleaseEvent(QMouseEvent* e) {
+    if (e->button() == Qt::LeftButton && m_selecting) {
+        m_selecting = false;
+        applySelection(e->modifiers());
+        requestFrame();
+        return;
+    }
+    if (e->button() == Qt::LeftButton) m_leftDown = false;
+    if (e->button() == Qt::RightButton || e->button() == Qt::MiddleButton) m_rightDown = false;
+}
+
+void RenderView::pickAt(const QPoint& widgetPos) {
+    const qreal dpr = devicePixelRatioF();
+    const QSize pixelSize(qRound(width() * dpr), qRound(height() * dpr));
+    // Widget coordinates are top-left based; GL reads are bottom-left based
+    const QPoint pixel(qRound(widgetPos.x() * dpr), pixelSize.height() - 1 - qRound(widgetPos.y() * dpr));
+
+    makeCurrent();
+    uploadPendingData();
+    PickResult res = m_renderer.pick(m_camera, m_cfg, pixelSize, pixel);
+    doneCurrent();
+    if (!res.valid()) return;
+
+    // Snap to the exact point instead of the depth-buffer estimate
+    if (res.kind == PickResult::Kind::Point) {
+        QMutexLocker lock(&m_mutex);
+        if (m_cloud && res.index < m_cloud->points.size()) res.position = m_cloud->points[res.index];
+    }
+
+    if (m_picks.size() >= 2) m_picks.erase(m_picks.begin());
+    m_picks.push_back(res.position);
+
+    makeCurrent();
+    m_renderer.setOverlayPoints(m_picks);
+    doneCurrent();
+
+    emit picked(res);
+    if (m_picks.size() == 2) {
+        emit measured(m_picks[0], m_picks[1], (m_picks[1] - m_picks[0]).length());
+    }
+    requestFrame();
+}
+
+void RenderView::clearPicks() {
+    if (m_picks.empty()) return;
+    m_picks.clear();
+    makeCurrent();
+    m_renderer.setOverlayPoints(m_picks);
+    doneCurrent();
+    requestFrame();
+}
+
+void RenderView::setSelectionMode(SelectionMode mode) {
+    m_selMode = mode;
+    if (mode == SelectionMode::None && m_selecting) {
+        m_selecting = false;
+        requestFrame();
+    }
+    setCursor(mode == SelectionMode::None ? Qt::ArrowCursor : Qt::CrossCursor);
+}
+
+void RenderView::clearSelection() {
+    if (m_selMask.empty()) return;
+    m_selMask.clear();
+    m_selCount = 0;
+    uploadSelection();
+    emit selectionChanged(0, 0);
+    requestFrame();
+}
+
+void RenderView::applySelection(Qt::KeyboardModifiers mods) {
+    PointCloudPtr cloud;
+    { QMutexLocker lock(&m_mutex); cloud = m_cloud; }
+    if (!cloud || cloud->points.empty() || m_selPath.size() < 3 || width() <= 0 || height() <= 0) return;
+    const QRect bounds = m_selPath.boundingRect().intersected(rect());
+    if (bounds.isEmpty()) return;
+
+    // Rasterize the outline once; the per-point test is then a single byte lookup
+    QImage region(size(), QImage::Format_Grayscale8);
+    region.fill(0);
+    {
+        QPainter painter(&region);
+        painter.setPen(Qt::NoPen);
+        painter.setBrush(Qt::white);
+        painter.drawPolygon(m_selPath, Qt::OddEvenFill);
+    }
+
+    const auto n = cloud->points.size();
+    const bool add = mods & Qt::ShiftModifier;
+    const bool subtract = mods & Qt::AltModifier;
+    // Shift/Alt extend the existing mask only if it was made on this very cloud
+    if (m_selRevision != cloud->revision || m_selMask.size() != n || !(add || subtract)) m_selMask.assign(n, 0);
+    m_selRevision = cloud->revision;
+
+    const float aspect = float(width()) / float(height());
+    const QMatrix4x4 view = m_camera.viewMatrix();
+    const QMatrix4x4 proj = m_camera.projMatrix(aspect);
+    const QMatrix4x4 mvp = proj * view;
+    const QMatrix4x4 projInv = proj.inverted();
+    const bool clipOn = m_cfg.clipPlaneParams.clipEnabled;
+    const QVector4D plane = m_cfg.clipPlaneParams.clipPlane;
+    const float w = float(width()), h = float(height());
+    const auto& pts = cloud->points;
+
+    // Depth of what is on screen under the outline (framebuffer pixels, GL rows from the bottom)
+    const qreal dpr = devicePixelRatioF();
+    const QSize fbSize(qRound(width() * dpr), qRound(height() * dpr));
+    const int fbLeft = static_cast<int>(std::floor(bounds.left() * dpr));
+    const int fbRight = static_cast<int>(std::ceil((bounds.right() + 1) * dpr)) - 1;
+    const int fbTop = static_cast<int>(std::floor(bounds.top() * dpr));
+    const int fbBottom = static_cast<int>(std::ceil((bounds.bottom() + 1) * dpr)) - 1;
+    const QRect depthRect = QRect(QPoint(fbLeft, fbSize.height() - 1 - fbBottom), QPoint(fbRight, fbSize.height() - 1 - fbTop))
+                                .intersected(QRect(QPoint(0, 0), fbSize));
+    makeCurrent();
+    uploadPendingData();
+    const std::vector<float> depth = m_renderer.depthRegion(m_camera, m_cfg, fbSize, depthRect);
+    doneCurrent();
+
+    // Projection runs in parallel; every point writes only its own mask byte.
+    // Points hidden behind the front surface (mesh or other points) are not selected.
+    Parallel::forEach(n, [&](std::size_t i) {
+        const QVector3D& p = pts[i];
+        if (clipOn && QVector4D::dotProduct(QVector4D(p, 1.0f), plane) < 0.0f) return; // clipped away, not visible
+        const QVector4D c = mvp * QVector4D(p, 1.0f);
+        if (c.w() <= 0.0f) return;
+        const float ndcX = c.x() / c.w(), ndcY = c.y() / c.w();
+        // floor, not truncation: x in (-1, 0) must stay outside the widget
+        const int px = static_cast<int>(std::floor((ndcX * 0.5f + 0.5f) * w));
+        const int py = static_cast<int>(std::floor((0.5f - ndcY * 0.5f) * h));
+        if (px < bounds.left() || px > bounds.right() || py < bounds.top() || py > bounds.bottom()) return;
+        if (region.constScanLine(py)[px] == 0) return;
+
+        if (!depth.empty()) {
+            const int fx = static_cast<int>(std::floor((ndcX * 0.5f + 0.5f) * float(fbSize.width())));
+            const int fy = static_cast<int>(std::floor((ndcY * 0.5f + 0.5f) * float(fbSize.height())));
+            if (depthRect.contains(fx, fy)) {
+                const float d = depth[static_cast<std::size_t>(fy - depthRect.y()) * depthRect.width() + (fx - depthRect.x())];
+                if (d < 1.0f) {
+                    // Compare eye-space distances so the tolerance is the same at every depth
+                    const float front = -(projInv * QVector4D(ndcX, ndcY, 2.0f * d - 1.0f, 1.0f)).toVector3DAffine().z();
+                    const float self = -(view * QVector4D(p, 1.0f)).z();
+                    if (self > front * (1.0f + kSelectDepthTolerance)) return;
+                }
+            }
+        }
+        m_selMask[i] = subtract ? 0 : 1;
+    });
+
+    // Count per chunk, then reduce
+    std::vector<std::size_t> partial(Parallel::chunkCount(n), 0);
+    Parallel::forChunks(n, [&](std::size_t chunk, std::size_t b, std::size_t e) {
+        std::size_t c = 0;
+        for (std::size_t i = b; i < e; ++i) c += m_selMask[i];
+        partial[chunk] = c;
+    });
+    m_selCount = 0;
+    for (auto c : partial) m_selCount += c;
+    if (m_selCount == 0) m_selMask.clear();
+
+    uploadSelection();
+    emit selectionChanged(m_selCount, n);
+}
+
+void RenderView::uploadSelection() {
+    std::vector<std::uint32_t> indices;
+    indices.reserve(m_selCount);
+    for (std::size_t i = 0; i < m_selMask.size(); ++i) {
+        if (m_selMask[i]) indices.push_back(static_cast<std::uint32_t>(i));
+    }
+    makeCurrent();
+    uploadPendingData(); // make sure the highlight refers to the uploaded cloud
+    m_renderer.setSelection(indices);
+    doneCurrent();
+}
+
 void RenderView::mouseMoveEvent(QMouseEvent* e) {
     const QPoint cur = e->pos();
     const QPoint delta = cur - m_lastPos;
     m_lastPos = cur;
     if (width() == 0 || height() == 0) return;
 
+    if (m_selecting) {
+        if (m_selMode == SelectionMode::Box) {
+            const QPoint a = m_selPath.first();
+            m_selPath = QPolygon();
+            m_selPath << a << QPoint(cur.x(), a.y()) << cur << QPoint(a.x(), cur.y());
+        } else if ((cur - m_selPath.last()).manhattanLength() >= kLassoMinStepPx) {
+            m_selPath << cur;
+        }
+        requestFrame();
+        return;
+    }
+
     const float ndx = float(delta.x()) / float(width());
     const float ndy = float(delta.y()) / float(height());
 
     if (m_leftDown) {
         // Orbit
         m_camera.orbit(ndx, -ndy);
-        update();
+        requestFrame();
     } else if (m_rightDown) {
         // Pan
         m_camera.pan(ndx, ndy);
-        update();
+        requestFrame();
     }
 }
 
@@ -169,14 +484,14 @@ void RenderView::wheelEvent(QWheelEvent* e) {
     const float steps = float(e->angleDelta().y()) / 120.0f;
     if (steps != 0.0f) {
         m_camera.zoom(steps);
-        update();
+        requestFrame();
     }
     e->accept();
 }
 
 void RenderView::keyPressEvent(QKeyEvent* e) {
     if (e->isAutoRepeat()) { e->accept(); return; }
-    bool prevMoving = (m_keyW || m_keyA || m_keyS || m_keyD || m_keyQ || m_keyE);
+    const bool prevMoving = isMoving();
 
     switch (e->key()) {
         case Qt::Key_W: m_keyW = true; break;
@@ -186,13 +501,17 @@ void RenderView::keyPressEvent(QKeyEvent* e) {
         case Qt::Key_Q: m_keyQ = true; break;
         case Qt::Key_E: m_keyE = true; break;
         case Qt::Key_Shift: m_shiftDown = true; break;
+        case Qt::Key_Escape:
+            if (m_selecting) { m_selecting = false; requestFrame(); }
+            else clearPicks();
+            break;
         default: QOpenGLWidget::keyPressEvent(e); return;
     }
 
-    const bool nowMoving = (m_keyW || m_keyA || m_keyS || m_keyD || m_keyQ || m_keyE);
-    if (nowMoving && !prevMoving) {
+    if (isMoving() && !prevMoving) {
+        // Kick the frame loop; onFrameSwapped keeps it going while keys are held
         m_elapsed.restart();
-        m_moveTimer.start(0); // as fast as possible
+        requestFrame();
     }
     e->accept();
 }
@@ -211,33 +530,19 @@ void RenderView::keyReleaseEvent(QKeyEvent* e) {
         default: QOpenGLWidget::keyReleaseEvent(e); return;
     }
 
-    if (!(m_keyW || m_keyA || m_keyS || m_keyD || m_keyQ || m_keyE)) {
-        m_moveTimer.stop();
+    if (!isMoving()) {
+        // The frame loop stops by itself at the next frameSwapped
         m_elapsed.invalidate();
     }
     e->accept();
 }
 
-void RenderView::onMoveTick() {
-    // dt in seconds
-    float dt = 0.0f;
-    if (!m_elapsed.isValid()) {
-        m_elapsed.restart();
-        return; // wait for next tick to have dt
-    }
-    dt = static_cast<float>(m_elapsed.restart()) / 1000.0f;
-
+void RenderView::advanceCameraMotion(float dt) {
     // Directions
     float fwd = (m_keyW ? 1.0f : 0.0f) + (m_keyS ? -1.0f : 0.0f);
     float right = (m_keyD ? 1.0f : 0.0f) + (m_keyA ? -1.0f : 0.0f);
     float up = (m_keyQ ? 1.0f : 0.0f) + (m_keyE ? -1.0f : 0.0f);
-
-    if (fwd == 0.0f && right == 0.0f && up == 0.0f) {
-        // No movement keys held; stop timer to save CPU
-        m_moveTimer.stop();
-        m_elapsed.invalidate();
-        return;
-    }
+    if (fwd == 0.0f && right == 0.0f && up == 0.0f) return;
 
     // Normalize combined speed so diagonals are not faster
     const float lenSq = fwd*fwd + right*right + up*up;
@@ -252,5 +557,4 @@ void RenderView::onMoveTick() {
 
     m_camera.moveHorizontal(fwd * speed * dt, right * speed * dt);
     if (up != 0.0f) m_camera.moveVertical(up * speed * dt);
-    update();
 }
@@ -3,43 +3,84 @@
 #include <QMutex>
 #include <QPoint>
 #include <algorithm>
-#include <QTimer>
 #include <QElapsedTimer>
+#include <QPolygon>
+#include <vector>
+#include <cstdint>
 #include "../Model/Geometry.h"
 #include "../Settings/SettingsManager.h"
 #include "Camera.h"
 #include "ShaderLibrary.h"
 #include "Renderer.h"
 
+// Frame timing reported by RenderView's scheduler
+struct FrameStats {
+    double fps {0.0};          // presented frames per second while frames are being produced
+    double frameTimeMs {0.0};  // CPU time spent in paintGL (exponential moving average)
+    double intervalMs {0.0};   // time between presented frames (exponential moving average)
+    quint64 frames {0};        // total frames presented
+};
+
+// Screen-space selection tool driven by the left mouse button
+enum class SelectionMode { None, Box, Lasso };
+
 class RenderView : public QOpenGLWidget {
     Q_OBJECT
 public:
     explicit RenderView(QWidget* parent = nullptr);
+    ~RenderView() override;
+
+    [[nodiscard]] const FrameStats& frameStats() const { return m_stats; }
+
+    // Per-point selection of the currently displayed cloud (1 = selected); empty if nothing is selected
+    [[nodiscard]] const std::vector<std::uint8_t>& selectionMask() const { return m_selMask; }
+    // PointCloudModel::revision of the cloud the selection mask refers to
+    [[nodiscard]] std::uint64_t selectionRevision() const { return m_selRevision; }
+    [[nodiscard]] std::size_t selectedCount() const { return m_selCount; }
+    [[nodiscard]] SelectionMode selectionMode() const { return m_selMode; }
 
 public slots:
     void setPointCloud(PointCloudPtr cloud);
     void setMesh(MeshPtr mesh);
 
     // Display toggles
-    void setShowPoints(bool on) { m_cfg.showPoints = on; update(); }
-    void setShowNormals(bool on) { m_cfg.showNormals = on; update(); }
-    void setShowMesh(bool on) { m_cfg.showMesh = on; update(); }
-    void setWireframe(bool on) { m_cfg.wireframe = on; update(); }
-    void setPointSize(float s) { m_cfg.pointSize = static_cast<int>(std::clamp(s, 1.0f, 20.0f)); update(); }
-    void setMeshColor(const QVector3D& c) { m_cfg.meshColor = c; update(); }
-    void setPointColor(const QVector3D& c) { m_cfg.pointColor = c; update(); }
-    void setWireColor(const QVector3D& c) { m_cfg.wireColor = c; update(); }
+    void setShowPoints(bool on) { m_cfg.showPoints = on; requestFrame(); }
+    void setShowNormals(bool on) { m_cfg.showNormals = on; requestFrame(); }
+    void setShowMesh(bool on) { m_cfg.showMesh = on; requestFrame(); }
+    void setWireframe(bool on) { m_cfg.wireframe = on; requestFrame(); }
+    void setPointSize(float s) { m_cfg.pointSize = static_cast<int>(std::clamp(s, 1.0f, 20.0f)); requestFrame(); }
+    void setMeshColor(const QVector3D& c) { m_cfg.meshColor = c; requestFrame(); }
+    void setPointColor(const QVector3D& c) { m_cfg.pointColor = c; requestFrame(); }
+    void setWireColor(const QVector3D& c) { m_cfg.wireColor = c; requestFrame(); }
     void setCameraSpeed(float v) { m_cfg.cameraSpeed = std::clamp(v, 0.01f, 1000.0f); }
 
     // Clip plane controls
-    void setClipEnabled(bool on) {m_cfg.clipPlaneParams.clipEnabled = on; update(); }
-    void setClipPlane(const QVector4D& plane) {m_cfg.clipPlaneParams.clipPlane = plane; update(); }
+    void setClipEnabled(bool on) {m_cfg.clipPlaneParams.clipEnabled = on; requestFrame(); }
+    void setClipPlane(const QVector4D& plane) {m_cfg.clipPlaneParams.clipPlane = plane; requestFrame(); }
     QVector4D clipPlane() const { return m_cfg.clipPlaneParams.clipPlane; }
     bool clipEnabled() const { return m_cfg.clipPlaneParams.clipEnabled; }
     void setClipPlaneFromNormalAndPoint (const QVector3D& normal, const QVector3D& point);
     void alignClipPlaneToCameraThroughSceneCenter();
     void alignClipPlaneNormalToCamera();
 
+    // Drop picked positions and the measurement overlay
+    void clearPicks();
+
+    // Box/lasso selection. While a mode is active, left-drag selects instead of orbiting;
+    // Shift adds to and Alt subtracts from the current selection.
+    void setSelectionMode(SelectionMode mode);
+    void clearSelection();
+
+signals:
+    // Emitted at most every kStatsIntervalMs while frames are being presented
+    void frameStatsUpdated(const FrameStats& stats);
+    // Ctrl+Left click picked a point or triangle (only visible layers: triangles need "show mesh")
+    void picked(const PickResult& result);
+    // Emitted when a second position has been picked: distance between the last two picks
+    void measured(const QVector3D& a, const QVector3D& b, float distance);
+    // Selection changed: number of selected points out of the displayed total
+    void selectionChanged(std::size_t selected, std::size_t total);
+
 public:
     float pointSize() const { return static_cast<float>(m_cfg.pointSize); }
     void adjustPointSize(float delta) { setPointSize(pointSize() + delta); }
@@ -51,12 +92,19 @@ protected:
 
     void mousePressEvent(QMouseEvent* e) override;
     void mouseMoveEvent(QMouseEvent* e) override;
+    void mouseReleaseEvent(QMouseEvent* e) override;
     void wheelEvent(QWheelEvent* e) override;
     void keyPressEvent(QKeyEvent* e) override;
     void keyReleaseEvent(QKeyEvent* e) override;
+    // Qt skips paintGL while hidden; drop a pending request so it cannot block later ones
+    void showEvent(QShowEvent* e) override;
+    void hideEvent(QHideEvent* e) override;
 
 private slots:
-    void onMoveTick();
+    // Paced by vsync: advances camera motion and schedules the next frame only while needed
+    void onFrameSwapped();
+    // Frees the renderer's raw GL objects while the context is still current
+    void cleanupGL();
 
 private:
     // Data (copied snapshots for bounds and uploads)
@@ -77,14 +125,41 @@ private:
     bool m_leftDown {false};
     bool m_rightDown {false};
 
-    // Smooth movement state
-    QTimer m_moveTimer;
+    // Picking / measuring: the last two picked world positions
+    std::vector<QVector3D> m_picks;
+
+    // Selection: outline in widget coordinates while dragging, result as a per-point mask
+    SelectionMode m_selMode {SelectionMode::None};
+    bool m_selecting {false};
+    QPolygon m_selPath;
+    std::vector<std::uint8_t> m_selMask;
+    std::uint64_t m_selRevision {0};
+    std::size_t m_selCount {0};
+
+    // Smooth movement state (advanced once per presented frame)
     QElapsedTimer m_elapsed;
     bool m_keyW{false}, m_keyA{false}, m_keyS{false}, m_keyD{false};
     bool m_keyQ{false}, m_keyE{false};
     bool m_shiftDown{false};
 
+    // Frame scheduling: at most one pending update(); nothing runs while idle
+    bool m_frameRequested {false};
+    QElapsedTimer m_frameClock;     // time since last presented frame
+    QElapsedTimer m_statsClock;     // throttles frameStatsUpdated
+    FrameStats m_stats;
+
     // Helpers
+    // Bounds from the models' cached GeometryStats (computed in the worker thread)
     static void computeBounds(const PointCloudPtr& cloud, const MeshPtr& mesh, QVector3D& minP, QVector3D& maxP);
     void refitCameraToData();
+    // Push pending point/mesh snapshots to the GPU (requires a current context)
+    void uploadPendingData();
+    void pickAt(const QPoint& widgetPos);
+    // Project the cloud and combine the points inside m_selPath with the current mask
+    void applySelection(Qt::KeyboardModifiers mods);
+    void uploadSelection();
+    // Coalesced repaint request; safe to call many times per event
+    void requestFrame();
+    [[nodiscard]] bool isMoving() const { return m_keyW || m_keyA || m_keyS || m_keyD || m_keyQ || m_keyE; }
+    void advanceCameraMotion(float dt);
 };
@@ -4,6 +4,17 @@
 
 #include <QOpenGLShaderProgram>
 #include <QVector3D>
+#include <algorithm>
+#include <cmath>
+
+namespace {
+// Screen-space density of normal glyphs: at most one glyph per spacing² pixels
+constexpr int kNormalGlyphSpacingPx = 6;
+// Glyph length as a fraction of the point cloud's bounding-box diagonal
+constexpr float kNormalLengthFraction = 0.01f;
+// Half-size of the window read back around the cursor when picking
+constexpr int kPickRadiusPx = 4;
+}
 
 Renderer::Renderer() = default;
 Renderer::~Renderer() = default;
@@ -25,7 +36,7 @@ bool Renderer::initialize(ShaderLibrary& shaders, QString* error) {
     m_locPointSize = m_prog->uniformLocation("u_pointSize");
     m_locClipPlane = m_prog->uniformLocation("u_clipPlane");
 
-    // Normals visualization program (geometry shader based)
+    // Normals visualization program (instanced lines, positions/normals from texture buffers)
     QString nerr;
     if (!shaders.ensureProgram("normals", &nerr)) {
         if (error) *error = QStringLiteral("Normals shader failed: %1").arg(nerr);
@@ -35,10 +46,26 @@ bool Renderer::initialize(ShaderLibrary& shaders, QString* error) {
     m_locMvpN = m_progNormals->uniformLocation("u_mvp");
     m_locColorN = m_progNormals->uniformLocation("u_color");
     m_locNormalLen = m_progNormals->uniformLocation("u_normalLen");
+    m_locStrideN = m_progNormals->uniformLocation("u_stride");
+    m_locPositionsN = m_progNormals->uniformLocation("u_positions");
+    m_locNormalsN = m_progNormals->uniformLocation("u_normals");
     m_locClipPlaneN = m_progNormals->uniformLocation("u_clipPlane");
     m_locClipPlaneEnabled = m_progNormals->uniformLocation("u_clipPlaneEnabled");
 
 
+    // ID-buffer picking program
+    QString perr;
+    if (!shaders.ensureProgram("pick", &perr)) {
+        if (error) *error = QStringLiteral("Pick shader failed: %1").arg(perr);
+        return false;
+    }
+    m_progPick = shaders.get("pick");
+    m_locMvpP = m_progPick->uniformLocation("u_mvp");
+    m_locPointSizeP = m_progPick->uniformLocation("u_pointSize");
+    m_locClipPlaneP = m_progPick->uniformLocation("u_clipPlane");
+    m_locIdOffsetP = m_progPick->uniformLocation("u_idOffset");
+    m_locUsePrimitiveIdP = m_progPick->uniformLocation("u_usePrimitiveId");
+
     // Create buffers/VAOs
     if (!m_vaoPoints.isCreated()) m_vaoPoints.create();
     if (!m_vboPoints.isCreated()) m_vboPoints.create();
@@ -48,11 +75,32 @@ bool Renderer::initialize(ShaderLibrary& shaders, QString* error) {
     if (!m_vboMesh.isCreated()) m_vboMesh.create();
     if (!m_iboMesh.isCreated()) m_iboMesh.create();
 
+    if (!m_vaoSelection.isCreated()) m_vaoSelection.create();
+    if (!m_iboSelection.isCreated()) m_iboSelection.create();
+
+    if (!m_vaoOverlay.isCreated()) m_vaoOverlay.create();
+    if (!m_vboOverlay.isCreated()) m_vboOverlay.create();
+
+    if (!m_vaoNormals.isCreated()) m_vaoNormals.create();
+    if (m_tboPositions == 0) glGenTextures(1, &m_tboPositions);
+    if (m_tboNormals == 0) glGenTextures(1, &m_tboNormals);
+
     setupPointVAO();
     setupMeshVAO();
+    setupOverlayVAO();
+    setupSelectionVAO();
     return true;
 }
 
+void Renderer::cleanup() {
+    if (m_tboPositions != 0) glDeleteTextures(1, &m_tboPositions);
+    if (m_tboNormals != 0) glDeleteTextures(1, &m_tboNormals);
+    m_tboPositions = 0;
+    m_tboNormals = 0;
+    m_pickFbo.reset();
+    m_pickDirty = true;
+}
+
 void Renderer::setupPointVAO() {
     m_vaoPoints.bind();
     // Positions at location 0
@@ -68,6 +116,43 @@ void Renderer::setupPointVAO() {
     m_vaoPoints.release();
 }
 
+void Renderer::setupOverlayVAO() {
+    m_vaoOverlay.bind();
+    m_vboOverlay.bind();
+    glEnableVertexAttribArray(0);
+    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, sizeof(QVector3D), reinterpret_cast<void*>(0));
+    m_vboOverlay.release();
+    m_vaoOverlay.release();
+}
+
+void Renderer::setupSelectionVAO() {
+    // Same positions as the point VAO; the element buffer picks the selected subset
+    m_vaoSelection.bind();
+    m_vboPoints.bind();
+    glEnableVertexAttribArray(0);
+    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, sizeof(QVector3D), reinterpret_cast<void*>(0));
+    m_iboSelection.bind(); // element buffer binding is VAO state
+    m_vaoSelection.release();
+    m_vboPoints.release();
+    m_iboSelection.release();
+}
+
+void Renderer::attachPointTextureBuffers() {
+    // (Re)attach after every upload so the textures see the current buffer data stores
+    glBindTexture(GL_TEXTURE_BUFFER, m_tboPositions);
+    glTexBuffer(GL_TEXTURE_BUFFER, GL_RGB32F, m_vboPoints.bufferId());
+    glBindTexture(GL_TEXTURE_BUFFER, m_tboNormals);
+    glTexBuffer(GL_TEXTURE_BUFFER, GL_RGB32F, m_vboPointNormals.bufferId());
+    glBindTexture(GL_TEXTURE_BUFFER, 0);
+}
+
+GLsizei Renderer::normalGlyphStride(const QSize& viewport) const {
+    const long long pixels = static_cast<long long>(std::max(1, viewport.width())) * std::max(1, viewport.height());
+    const long long maxGlyphs = std::max(1LL, pixels / (kNormalGlyphSpacingPx * kNormalGlyphSpacingPx));
+    const long long stride = (static_cast<long long>(m_pointCount) + maxGlyphs - 1) / maxGlyphs;
+    return static_cast<GLsizei>(std::max(1LL, stride));
+}
+
 void Renderer::setupMeshVAO() {
     m_vaoMesh.bind();
     m_vboMesh.bind();
@@ -78,7 +163,9 @@ void Renderer::setupMeshVAO() {
 }
 
 void Renderer::updatePoints(const PointCloudPtr& cloud) {
+    m_pickDirty = true;
     m_pointCount = 0;
+    m_selectionCount = 0; // indices refer to the previous cloud
     m_hasPointNormal = false;
     // Positions
     m_vboPoints.bind();
@@ -104,9 +191,18 @@ void Renderer::updatePoints(const PointCloudPtr& cloud) {
         m_hasPointNormal = false;
     }
     m_vboPointNormals.release();
+
+    if (m_hasPointNormal) {
+        attachPointTextureBuffers();
+
+        // Scale glyphs with the data so they stay readable for any unit system
+        const float diag = cloud->stats.valid ? cloud->stats.extent().length() : 0.0f;
+        m_normalLength = diag > 0.0f ? diag * kNormalLengthFraction : 0.02f;
+    }
 }
 
 void Renderer::updateMesh(const MeshPtr& mesh) {
+    m_pickDirty = true;
     m_indexCount = 0;
     // Vertices
     m_vboMesh.bind();
@@ -192,12 +288,28 @@ void Renderer::draw(const Camera& cam, const RenderSettings& cfg, const QSize& v
         m_vaoPoints.bind();
         glDrawArrays(GL_POINTS, 0, m_pointCount);
         m_vaoPoints.release();
+
+        // Selected points: redrawn on top, larger and in a highlight color
+        if (m_selectionCount > 0) {
+            glDepthFunc(GL_LEQUAL);
+            m_prog->setUniformValue(m_locColor, QVector3D(1.0f, 0.25f, 0.25f));
+            m_prog->setUniformValue(m_locPointSize, static_cast<float>(cfg.pointSize + 2));
+            m_vaoSelection.bind();
+            glDrawElements(GL_POINTS, m_selectionCount, GL_UNSIGNED_INT, nullptr);
+            m_vaoSelection.release();
+            glDepthFunc(GL_LESS);
+        }
     }
 
     m_prog->release();
 
-    // Normals visualization for points (requires normals and program)
+    // Normals visualization for points (requires normals and program).
+    // One instanced line per glyph; only every `stride`-th point is drawn so the glyph count
+    // is bounded by the viewport size rather than by the size of the cloud.
     if (cfg.showNormals && m_hasPointNormal && m_progNormals && m_pointCount > 0) {
+        const GLsizei stride = normalGlyphStride(viewport);
+        const GLsizei instances = (m_pointCount + stride - 1) / stride;
+
         m_progNormals->bind();
         m_progNormals->setUniformValue(m_locMvpN, mvp);
         if (m_locClipPlaneN >= 0 && m_locClipPlaneEnabled >= 0) {
@@ -206,11 +318,202 @@ void Renderer::draw(const Camera& cam, const RenderSettings& cfg, const QSize& v
         }
         // A default bluish color for normals
         m_progNormals->setUniformValue(m_locColorN, QVector3D(0.2f, 0.6f, 1.0f));
-        // Fixed length in world units; could be made configurable
-        m_progNormals->setUniformValue(m_locNormalLen, 0.02f);
+        m_progNormals->setUniformValue(m_locNormalLen, m_normalLength);
+        m_progNormals->setUniformValue(m_locStrideN, static_cast<GLint>(stride));
+        m_progNormals->setUniformValue(m_locPositionsN, 0);
+        m_progNormals->setUniformValue(m_locNormalsN, 1);
+
+        glActiveTexture(GL_TEXTURE0);
+        glBindTexture(GL_TEXTURE_BUFFER, m_tboPositions);
+        glActiveTexture(GL_TEXTURE1);
+        glBindTexture(GL_TEXTURE_BUFFER, m_tboNormals);
+
+        m_vaoNormals.bind();
+        glDrawArraysInstanced(GL_LINES, 0, 2, instances);
+        m_vaoNormals.release();
+
+        glBindTexture(GL_TEXTURE_BUFFER, 0);
+        glActiveTexture(GL_TEXTURE0);
+        glBindTexture(GL_TEXTURE_BUFFER, 0);
+        m_progNormals->release();
+    }
+
+    // Pick markers and measurement segment, drawn on top of the scene
+    if (m_overlayCount > 0) {
+        glDisable(GL_DEPTH_TEST);
+        glDisable(GL_CLIP_DISTANCE0);
+        glEnable(GL_PROGRAM_POINT_SIZE);
+        m_prog->bind();
+        m_prog->setUniformValue(m_locMvp, mvp);
+        if (m_locClipPlane >= 0) m_prog->setUniformValue(m_locClipPlane, QVector4D(0.0f, 0.0f, 0.0f, 1.0f));
+        m_prog->setUniformValue(m_locColor, QVector3D(1.0f, 0.85f, 0.1f));
+        m_prog->setUniformValue(m_locPointSize, static_cast<float>(cfg.pointSize + 6));
+        m_vaoOverlay.bind();
+        if (m_overlayCount > 1) glDrawArrays(GL_LINE_STRIP, 0, m_overlayCount);
+        glDrawArrays(GL_POINTS, 0, m_overlayCount);
+        m_vaoOverlay.release();
+        m_prog->release();
+        glEnable(GL_DEPTH_TEST);
+    }
+}
+
+void Renderer::setSelection(const std::vector<std::uint32_t>& indices) {
+    m_vaoSelection.bind();
+    m_iboSelection.bind();
+    const auto bytes = static_cast<int>(indices.size() * sizeof(std::uint32_t));
+    m_iboSelection.allocate(bytes);
+    if (bytes > 0) m_iboSelection.write(0, indices.data(), bytes);
+    m_vaoSelection.release();
+    m_selectionCount = static_cast<GLsizei>(indices.size());
+}
+
+void Renderer::setOverlayPoints(const std::vector<QVector3D>& pts) {
+    m_vboOverlay.bind();
+    const auto bytes = static_cast<int>(pts.size() * sizeof(QVector3D));
+    m_vboOverlay.allocate(bytes);
+    if (bytes > 0) m_vboOverlay.write(0, pts.data(), bytes);
+    m_vboOverlay.release();
+    m_overlayCount = static_cast<GLsizei>(pts.size());
+}
+
+void Renderer::renderPickPass(const QMatrix4x4& mvp, const RenderSettings& cfg, const QSize& viewport) {
+    if (!m_pickFbo || m_pickFbo->size() != viewport) {
+        QOpenGLFramebufferObjectFormat fmt;
+        fmt.setAttachment(QOpenGLFramebufferObject::Depth);
+        fmt.setInternalTextureFormat(GL_RGBA8); // exact bytes: no multisampling, no blending
+        m_pickFbo = std::make_unique<QOpenGLFramebufferObject>(viewport, fmt);
+    }
+
+    GLfloat clearColor[4];
+    glGetFloatv(GL_COLOR_CLEAR_VALUE, clearColor);
+    m_pickFbo->bind();
+    glViewport(0, 0, viewport.width(), viewport.height());
+    glClearColor(0.0f, 0.0f, 0.0f, 0.0f); // id 0 == nothing
+    glEnable(GL_DEPTH_TEST);
+    glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+    if (cfg.clipPlaneParams.clipEnabled) glEnable(GL_CLIP_DISTANCE0);
+    else glDisable(GL_CLIP_DISTANCE0);
+
+    m_progPick->bind();
+    m_progPick->setUniformValue(m_locMvpP, mvp);
+    m_progPick->setUniformValue(m_locClipPlaneP, cfg.clipPlaneParams.clipPlane);
+
+    // Ids: points occupy [1, pointCount], triangles follow at [pointCount + 1, ...]
+    // Layers hidden in the view are left out, so picks match what is on screen
+    if (cfg.showMesh && m_indexCount > 0) {
+        glPolygonMode(GL_FRONT_AND_BACK, GL_FILL);
+        m_progPick->setUniformValue(m_locIdOffsetP, static_cast<GLuint>(m_pointCount) + 1u);
+        m_progPick->setUniformValue(m_locUsePrimitiveIdP, 1);
+        m_vaoMesh.bind();
+        m_iboMesh.bind();
+        glDrawElements(GL_TRIANGLES, m_indexCount, GL_UNSIGNED_INT, nullptr);
+        m_iboMesh.release();
+        m_vaoMesh.release();
+    }
+    if (cfg.showPoints && m_pointCount > 0) {
+        glEnable(GL_PROGRAM_POINT_SIZE);
+        m_progPick->setUniformValue(m_locIdOffsetP, 1u);
+        m_progPick->setUniformValue(m_locUsePrimitiveIdP, 0);
+        m_progPick->setUniformValue(m_locPointSizeP, static_cast<float>(cfg.pointSize));
         m_vaoPoints.bind();
         glDrawArrays(GL_POINTS, 0, m_pointCount);
         m_vaoPoints.release();
-        m_progNormals->release();
     }
+    m_progPick->release();
+
+    m_pickFbo->release();
+    glClearColor(clearColor[0], clearColor[1], clearColor[2], clearColor[3]);
+}
+
+void Renderer::ensurePickPass(const QMatrix4x4& mvp, const RenderSettings& cfg, const QSize& viewport) {
+    PickPassKey key;
+    key.mvp = mvp;
+    key.viewport = viewport;
+    key.clipPlane = cfg.clipPlaneParams.clipPlane;
+    key.clipEnabled = cfg.clipPlaneParams.clipEnabled;
+    key.showPoints = cfg.showPoints;
+    key.showMesh = cfg.showMesh;
+    key.pointSize = cfg.pointSize;
+    const bool sameKey = !m_pickDirty && m_pickFbo && key.mvp == m_pickKey.mvp && key.viewport == m_pickKey.viewport &&
+                         key.clipPlane == m_pickKey.clipPlane && key.clipEnabled == m_pickKey.clipEnabled &&
+                         key.showPoints == m_pickKey.showPoints && key.showMesh == m_pickKey.showMesh &&
+                         key.pointSize == m_pickKey.pointSize;
+    if (!sameKey) {
+        renderPickPass(mvp, cfg, viewport);
+        m_pickKey = key;
+        m_pickDirty = false;
+    }
+}
+
+PickResult Renderer::pick(const Camera& cam, const RenderSettings& cfg, const QSize& viewport, const QPoint& pixel) {
+    PickResult result;
+    if (!m_progPick || viewport.isEmpty()) return result;
+    if (pixel.x() < 0 || pixel.y() < 0 || pixel.x() >= viewport.width() || pixel.y() >= viewport.height()) return result;
+
+    const float aspect = float(viewport.width())/float(std::max(1, viewport.height()));
+    const QMatrix4x4 mvp = cam.projMatrix(aspect) * cam.viewMatrix();
+    ensurePickPass(mvp, cfg, viewport);
+
+    // Read back only the small window around the cursor
+    const int x0 = std::max(0, pixel.x() - kPickRadiusPx);
+    const int y0 = std::max(0, pixel.y() - kPickRadiusPx);
+    const int x1 = std::min(viewport.width() - 1, pixel.x() + kPickRadiusPx);
+    const int y1 = std::min(viewport.height() - 1, pixel.y() + kPickRadiusPx);
+    const int w = x1 - x0 + 1, h = y1 - y0 + 1;
+    std::vector<unsigned char> ids(static_cast<std::size_t>(w) * h * 4);
+    std::vector<float> depths(static_cast<std::size_t>(w) * h);
+
+    m_pickFbo->bind();
+    glPixelStorei(GL_PACK_ALIGNMENT, 1);
+    glReadPixels(x0, y0, w, h, GL_RGBA, GL_UNSIGNED_BYTE, ids.data());
+    glReadPixels(x0, y0, w, h, GL_DEPTH_COMPONENT, GL_FLOAT, depths.data());
+    m_pickFbo->release();
+
+    // Nearest non-empty pixel to the cursor wins
+    int best = -1, bestD2 = 0;
+    for (int y = 0; y < h; ++y) {
+        for (int x = 0; x < w; ++x) {
+            const std::size_t o = (static_cast<std::size_t>(y) * w + x) * 4;
+            const quint32 id = quint32(ids[o]) | (quint32(ids[o + 1]) << 8) | (quint32(ids[o + 2]) << 16) | (quint32(ids[o + 3]) << 24);
+            if (id == 0) continue;
+            const int dx = x0 + x - pixel.x(), dy = y0 + y - pixel.y();
+            const int d2 = dx*dx + dy*dy;
+            if (best < 0 || d2 < bestD2) { best = y * w + x; bestD2 = d2; }
+        }
+    }
+    if (best < 0) return result;
+
+    const std::size_t o = static_cast<std::size_t>(best) * 4;
+    const quint32 id = quint32(ids[o]) | (quint32(ids[o + 1]) << 8) | (quint32(ids[o + 2]) << 16) | (quint32(ids[o + 3]) << 24);
+    if (id <= static_cast<quint32>(m_pointCount)) {
+        result.kind = PickResult::Kind::Point;
+        result.index = id - 1;
+    } else {
+        result.kind = PickResult::Kind::Face;
+        result.index = id - 1 - static_cast<quint32>(m_pointCount);
+    }
+
+    // Unproject the hit pixel's depth to world space
+    const int px = x0 + best % w, py = y0 + best / w;
+    const float ndcX = 2.0f * (float(px) + 0.5f) / float(viewport.width()) - 1.0f;
+    const float ndcY = 2.0f * (float(py) + 0.5f) / float(viewport.height()) - 1.0f;
+    const float ndcZ = 2.0f * depths[static_cast<std::size_t>(best)] - 1.0f;
+    const QVector4D world = mvp.inverted() * QVector4D(ndcX, ndcY, ndcZ, 1.0f);
+    if (world.w() != 0.0f) result.position = world.toVector3DAffine();
+    return result;
+}
+
+std::vector<float> Renderer::depthRegion(const Camera& cam, const RenderSettings& cfg, const QSize& viewport, const QRect& rect) {
+    const QRect r = rect.intersected(QRect(QPoint(0, 0), viewport));
+    if (!m_progPick || r.isEmpty()) return {};
+
+    const float aspect = float(viewport.width())/float(std::max(1, viewport.height()));
+    ensurePickPass(cam.projMatrix(aspect) * cam.viewMatrix(), cfg, viewport);
+
+    std::vector<float> depths(static_cast<std::size_t>(r.width()) * r.height(), 1.0f);
+    m_pickFbo->bind();
+    glPixelStorei(GL_PACK_ALIGNMENT, 1);
+    glReadPixels(r.x(), r.y(), r.width(), r.height(), GL_DEPTH_COMPONENT, GL_FLOAT, depths.data());
+    m_pickFbo->release();
+    return depths;
 }
@@ -3,24 +3,61 @@
 #include <QOpenGLBuffer>
 #include <QOpenGLVertexArrayObject>
 #include <QOpenGLShaderProgram>
+#include <QOpenGLFramebufferObject>
+#include <QMatrix4x4>
+#include <QPoint>
+#include <QRect>
+#include <memory>
+#include <vector>
 #include "../Settings/SettingsManager.h"
 #include "../Model/Geometry.h"
 
 class ShaderLibrary;
 class Camera;
 
+// Result of an ID-buffer pick under the cursor
+struct PickResult {
+    enum class Kind { None, Point, Face };
+    Kind kind {Kind::None};
+    quint32 index {0};      // point index, or triangle index into MeshModel::indices / 3
+    QVector3D position;     // world position unprojected from the depth buffer
+    [[nodiscard]] bool valid() const { return kind != Kind::None; }
+};
+
 class Renderer : protected QOpenGLFunctions_4_1_Core {
 public:
     Renderer();
     ~Renderer();
 
     bool initialize(ShaderLibrary& shaders, QString* error = nullptr);
+    // Release the GL objects that are not owned by a Qt wrapper; the context must be current.
+    // initialize() recreates them.
+    void cleanup();
 
     void updatePoints(const PointCloudPtr& cloud);
     void updateMesh(const MeshPtr& mesh);
 
     void draw(const Camera& cam, const RenderSettings& cfg, const QSize& viewport);
 
+    // Pick the point/triangle under `pixel` (framebuffer pixels, origin bottom-left).
+    // Only what is drawn can be picked: triangles while cfg.showMesh is on, points while
+    // cfg.showPoints is on, both limited by the clip plane. A hidden mesh neither yields nor occludes picks.
+    // The ID pass is rendered offscreen only when the view or data changed since the last
+    // pick; each pick then reads back just the few pixels around the cursor.
+    PickResult pick(const Camera& cam, const RenderSettings& cfg, const QSize& viewport, const QPoint& pixel);
+
+    // Depth of the ID pass (what is on screen: visible layers, clip plane) over `rect` in framebuffer
+    // pixels, origin bottom-left; row-major from the bottom row, 1.0 where nothing is drawn.
+    // Shares the cached pass with pick().
+    std::vector<float> depthRegion(const Camera& cam, const RenderSettings& cfg, const QSize& viewport, const QRect& rect);
+
+    // Overlay markers (picked positions) connected by a line strip; empty to clear
+    void setOverlayPoints(const std::vector<QVector3D>& pts);
+
+    // Highlight a subset of the uploaded points (indices into the current cloud); empty to clear.
+    // Reset automatically by updatePoints().
+    void setSelection(const std::vector<std::uint32_t>& indices);
+
 private:
     // Shaders (basic)
     QOpenGLShaderProgram* m_prog {nullptr};
@@ -29,11 +66,14 @@ private:
     int m_locPointSize {-1};
     int m_locClipPlane {-1};
 
-    // Shaders (normals visualization)
+    // Shaders (normals visualization, instanced lines)
     QOpenGLShaderProgram* m_progNormals {nullptr};
     int m_locMvpN {-1};
     int m_locColorN {-1};
     int m_locNormalLen {-1};
+    int m_locStrideN {-1};
+    int m_locPositionsN {-1};
+    int m_locNormalsN {-1};
     int m_locClipPlaneN {-1};
     int m_locClipPlaneEnabled{-1};
 
@@ -44,12 +84,57 @@ private:
     GLsizei m_pointCount {0};
     bool m_hasPointNormal {false};
 
+    // Normal glyphs: point buffers exposed as texture buffers, fetched per instance
+    QOpenGLVertexArrayObject m_vaoNormals; // empty VAO; core profile requires one bound
+    GLuint m_tboPositions {0};
+    GLuint m_tboNormals {0};
+    float m_normalLength {0.02f}; // world units, derived from the cloud's bounding box
+
     // Mesh
     QOpenGLVertexArrayObject m_vaoMesh;
     QOpenGLBuffer m_vboMesh { QOpenGLBuffer::VertexBuffer };
     QOpenGLBuffer m_iboMesh { QOpenGLBuffer::IndexBuffer };
     GLsizei m_indexCount {0};
 
+    // Picking (ID buffer)
+    QOpenGLShaderProgram* m_progPick {nullptr};
+    int m_locMvpP {-1};
+    int m_locPointSizeP {-1};
+    int m_locClipPlaneP {-1};
+    int m_locIdOffsetP {-1};
+    int m_locUsePrimitiveIdP {-1};
+    std::unique_ptr<QOpenGLFramebufferObject> m_pickFbo;
+    // Inputs of the last ID pass; the pass is re-rendered only when one of them changes
+    struct PickPassKey {
+        QMatrix4x4 mvp;
+        QSize viewport;
+        QVector4D clipPlane;
+        bool clipEnabled {false};
+        bool showPoints {false};
+        bool showMesh {false};
+        int pointSize {0};
+    };
+    PickPassKey m_pickKey;
+    bool m_pickDirty {true};
+
+    // Selection highlight: indices into the point VBO
+    QOpenGLVertexArrayObject m_vaoSelection;
+    QOpenGLBuffer m_iboSelection { QOpenGLBuffer::IndexBuffer };
+    GLsizei m_selectionCount {0};
+
+    // Overlay (pick markers / measurement segment)
+    QOpenGLVertexArrayObject m_vaoOverlay;
+    QOpenGLBuffer m_vboOverlay { QOpenGLBuffer::VertexBuffer };
+    GLsizei m_overlayCount {0};
+
     void setupPointVAO();
     void setupMeshVAO();
+    void setupOverlayVAO();
+    void setupSelectionVAO();
+    void renderPickPass(const QMatrix4x4& mvp, const RenderSettings& cfg, const QSize& viewport);
+    // Re-render the ID pass if its inputs changed since the last one
+    void ensurePickPass(const QMatrix4x4& mvp, const RenderSettings& cfg, const QSize& viewport);
+    void attachPointTextureBuffers();
+    // Stride so that at most one glyph is drawn per kNormalGlyphSpacingPx² screen pixels
+    [[nodiscard]] GLsizei normalGlyphStride(const QSize& viewport) const;
 };
@@ -13,7 +13,9 @@
 #include <QFileDialog>
 #include <QtGlobal>
 #include <QAction>
+#include <QActionGroup>
 #include <QDockWidget>
+#include <QStatusBar>
 #include <functional>
 
 #include "splitplanedocker.h"
@@ -43,6 +45,22 @@ MainWindow::MainWindow(QWidget *parent) : QMainWindow(parent), ui(std::make_uniq
     connect(m_controller, &PointCloudController::pointCloudUpdated, m_renderView, &RenderView::setPointCloud);
     connect(m_controller, &PointCloudController::meshUpdated, m_renderView, &RenderView::setMesh);
 
+    // Frame statistics from the render view's scheduler
+    connect(m_renderView, &RenderView::frameStatsUpdated, this, [this](const FrameStats& st){
+        statusBar()->showMessage(tr("%1 FPS | frame %2 ms").arg(st.fps, 0, 'f', 1).arg(st.frameTimeMs, 0, 'f', 2));
+    });
+
+    // Picking (Ctrl+Left click) and two-point measurement; only visible layers are pickable,
+    // so triangles are reported only while the mesh is shown
+    connect(m_renderView, &RenderView::picked, this, [this](const PickResult& r){
+        const QString what = r.kind == PickResult::Kind::Point ? tr("point") : tr("triangle");
+        m_logPanel->appendLog(tr("Picked %1 #%2 at (%3, %4, %5)").arg(what).arg(r.index)
+                              .arg(r.position.x(), 0, 'g', 6).arg(r.position.y(), 0, 'g', 6).arg(r.position.z(), 0, 'g', 6));
+    });
+    connect(m_renderView, &RenderView::measured, this, [this](const QVector3D&, const QVector3D&, float d){
+        m_logPanel->appendLog(tr("Distance: %1").arg(d, 0, 'g', 6));
+    });
+
     // Ensure reset action exists; disable until a file is imported
     if (auto reset = findChild<QAction*>("actionResetPointCloud")) reset->setEnabled(false);
 
@@ -65,6 +83,7 @@ MainWindow::MainWindow(QWidget *parent) : QMainWindow(parent), ui(std::make_uniq
     ConnectReconstructions();
     ConnectNormalEstimations();
     ConnectMeshTools();
+    ConnectSelectionTools();
 
     // Wire reset action to controller
     if (auto reset = findChild<QAction*>("actionResetPointCloud")) {
@@ -102,6 +121,14 @@ void MainWindow::ConnectSplitPlaneControls() {
     if (!m_splitPlaneDocker) {
         m_splitPlaneDocker = new SplitPlaneDocker(this, m_renderView);
         addDockWidget(Qt::LeftDockWidgetArea, m_splitPlaneDocker);
+        // Reduce the point cloud and the mesh to the visible side of the clip plane
+        connect(m_splitPlaneDocker, &SplitPlaneDocker::applyClipPlane, this, [this](const QVector4D& plane) {
+            if (!m_controller) return;
+            auto params = std::make_unique<HalfSpaceFilterParameter>();
+            params->nx = plane.x(); params->ny = plane.y(); params->nz = plane.z(); params->d = plane.w();
+            params->keepPositive = true;
+            m_controller->runApplyClipPlane(std::move(params));
+        });
 
         if (ui->menuView) {
             if (ui->actionSplitPlaneSettings) {
@@ -188,17 +215,61 @@ void MainWindow::ConnectReconstructions() {
             );
         });
     }
+    if (auto a = findChild<QAction*>("actionReconstructScreenedPoisson")) {
+        connect(a, &QAction::triggered, this, [this]{
+            openOrCreateParamDialog(
+                m_screenedPoissonParamDialog,
+                [this]() { return new ScreenedPoissonReconstructionParameter(this); },
+                [this](BaseInputParameter* p){
+                    if (!m_controller) return;
+                    std::unique_ptr<BaseInputParameter> snapshot;
+                    if (p) snapshot = p->clone();
+                    m_controller->runReconstructionWith(MeshGenerationMethod::SCREENED_POISSON_RECONSTRUCTION, std::move(snapshot));
+                }
+            );
+        });
+    }
+    if (auto a = findChild<QAction*>("actionReconstructVoxel")) {
+        connect(a, &QAction::triggered, this, [this]{
+            openOrCreateParamDialog(
+                m_voxelReconstructionParamDialog,
+                [this]() { return new VoxelReconstructionParameter(this); },
+                [this](BaseInputParameter* p){
+                    if (!m_controller) return;
+                    std::unique_ptr<BaseInputParameter> snapshot;
+                    if (p) snapshot = p->clone();
+                    m_controller->runReconstructionWith(MeshGenerationMethod::VOXEL_RECONSTRUCTION, std::move(snapshot));
+                }
+            );
+        });
+    }
 }
 
 void MainWindow::ConnectNormalEstimations() {
-    if (auto a = findChild<QAction*>("actionEstimateNormalsJet")) {
-        connect(a, &QAction::triggered, this, [this]{ if (m_controller) m_controller->runNormalEstimation(NormalEstimationMethod::JET_ESTIMATION); });
-    }
-    if (auto a = findChild<QAction*>("actionEstimateNormalsUniformCentroid")) {
-        connect(a, &QAction::triggered, this, [this]{ if (m_controller) m_controller->runNormalEstimation(NormalEstimationMethod::UNIFORM_VOLUME_CENTROID); });
-    }
-    if (auto a = findChild<QAction*>("actionEstimateNormalsVCM")) {
-        connect(a, &QAction::triggered, this, [this]{ if (m_controller) m_controller->runNormalEstimation(NormalEstimationMethod::VCM_ESTIMATION); });
+    // One persistent dialog per estimator; all share NormalEstimationParameter
+    const auto connectEstimator = [this](const char* actionName, QPointer<ParameterDialog>& slot, NormalEstimationMethod method) {
+        if (auto a = findChild<QAction*>(actionName)) {
+            connect(a, &QAction::triggered, this, [this, &slot, method]{
+                openOrCreateParamDialog(
+                    slot,
+                    [this]() { return new NormalEstimationParameter(this); },
+                    [this, method](BaseInputParameter* p){ if (m_controller) { auto s = p ? p->clone() : nullptr; m_controller->runNormalEstimation(method, std::move(s)); } }
+                );
+            });
+        }
+    };
+    connectEstimator("actionEstimateNormalsJet", m_normalJetDialog, NormalEstimationMethod::JET_ESTIMATION);
+    connectEstimator("actionEstimateNormalsUniformCentroid", m_normalCentroidDialog, NormalEstimationMethod::UNIFORM_VOLUME_CENTROID);
+    connectEstimator("actionEstimateNormalsVCM", m_normalVCMDialog, NormalEstimationMethod::VCM_ESTIMATION);
+    connectEstimator("actionEstimateNormalsPCA", m_normalPCADialog, NormalEstimationMethod::PCA_ESTIMATION);
+    if (auto a = findChild<QAction*>("actionOrientNormals")) {
+        connect(a, &QAction::triggered, this, [this]{
+            openOrCreateParamDialog(
+                m_orientNormalsDialog,
+                [this]() { return new NormalOrientationParameter(this); },
+                [this](BaseInputParameter* p){ if (m_controller) { auto s = p ? p->clone() : nullptr; m_controller->runOrientNormals(std::move(s)); } }
+            );
+        });
     }
 }
 
@@ -217,6 +288,20 @@ void MainWindow::ConnectMeshTools() {
             );
         });
     }
+    if (auto a = findChild<QAction*>("actionDecimateMesh")) {
+        connect(a, &QAction::triggered, this, [this]{
+            openOrCreateParamDialog(
+                m_decimateDialog,
+                [this]() { return new MeshDecimationParameter(this); },
+                [this](BaseInputParameter* p){
+                    if (!m_controller) return;
+                    std::unique_ptr<BaseInputParameter> snapshot;
+                    if (p) snapshot = p->clone();
+                    m_controller->runDecimateMesh(std::move(snapshot));
+                }
+            );
+        });
+    }
     // Wire Point Cloud tools as well
     if (auto a = findChild<QAction*>("actionVoxelDownsample")) {
         connect(a, &QAction::triggered, this, [this]{
@@ -227,6 +312,25 @@ void MainWindow::ConnectMeshTools() {
             );
         });
     }
+    // Point set simplification / smoothing, one dialog and parameter class per method
+    const auto connectResampling = [this](const char* actionName, QPointer<ParameterDialog>& slot, PointSetResamplingMethod method,
+                                          BaseInputParameter* (*create)(QObject*)) {
+        if (auto a = findChild<QAction*>(actionName)) {
+            connect(a, &QAction::triggered, this, [this, &slot, method, create]{
+                openOrCreateParamDialog(
+                    slot,
+                    [this, create]() { return create(this); },
+                    [this, method](BaseInputParameter* p){ if (m_controller) { auto s = p ? p->clone() : nullptr; m_controller->runResamplePointSet(method, std::move(s)); } }
+                );
+            });
+        }
+    };
+    connectResampling("actionHierarchySimplify", m_hierarchySimplifyDialog, PointSetResamplingMethod::HIERARCHY_SIMPLIFY,
+                      [](QObject* parent) -> BaseInputParameter* { return new HierarchySimplifyParameter(parent); });
+    connectResampling("actionWLOPSimplify", m_wlopSimplifyDialog, PointSetResamplingMethod::WLOP_SIMPLIFY,
+                      [](QObject* parent) -> BaseInputParameter* { return new WLOPSimplifyParameter(parent); });
+    connectResampling("actionBilateralSmooth", m_bilateralSmoothDialog, PointSetResamplingMethod::BILATERAL_SMOOTHING,
+                      [](QObject* parent) -> BaseInputParameter* { return new BilateralSmoothingParameter(parent); });
     if (auto a = findChild<QAction*>("actionFilterAABB")) {
         connect(a, &QAction::triggered, this, [this]{
             openOrCreateParamDialog(
@@ -245,6 +349,15 @@ void MainWindow::ConnectMeshTools() {
             );
         });
     }
+    if (auto a = findChild<QAction*>("actionFilterOrientedBox")) {
+        connect(a, &QAction::triggered, this, [this]{
+            openOrCreateParamDialog(
+                m_filterOrientedBoxDialog,
+                [this]() { return new OrientedBoxFilterParameter(this); },
+                [this](BaseInputParameter* p){ if (m_controller) { auto s = p ? p->clone() : nullptr; m_controller->runFilterOrientedBox(std::move(s)); } }
+            );
+        });
+    }
     if (auto a = findChild<QAction*>("actionFilterSurfaceFromUniformVolume")) {
         connect(a, &QAction::triggered, this, [this]{
             openOrCreateParamDialog(
@@ -254,4 +367,55 @@ void MainWindow::ConnectMeshTools() {
             );
         });
     }
+    if (auto a = findChild<QAction*>("actionRemoveOutliers")) {
+        connect(a, &QAction::triggered, this, [this]{
+            openOrCreateParamDialog(
+                m_outlierDialog,
+                [this]() { return new OutlierRemovalParameter(this); },
+                [this](BaseInputParameter* p){ if (m_controller) { auto s = p ? p->clone() : nullptr; m_controller->runRemoveOutliers(std::move(s)); } }
+            );
+        });
+    }
+}
+
+void MainWindow::ConnectSelectionTools() {
+    auto* box = findChild<QAction*>("actionBoxSelect");
+    auto* lasso = findChild<QAction*>("actionLassoSelect");
+    if (box && lasso) {
+        // At most one tool active; unchecking both returns the left button to orbiting
+        auto* group = new QActionGroup(this);
+        group->setExclusionPolicy(QActionGroup::ExclusionPolicy::ExclusiveOptional);
+        group->addAction(box);
+        group->addAction(lasso);
+        auto updateMode = [this, box, lasso]{
+            if (!m_renderView) return;
+            m_renderView->setSelectionMode(box->isChecked() ? SelectionMode::Box
+                                           : lasso->isChecked() ? SelectionMode::Lasso : SelectionMode::None);
+        };
+        connect(box, &QAction::toggled, this, updateMode);
+        connect(lasso, &QAction::toggled, this, updateMode);
+    }
+
+    auto runSelectionFilter = [this](bool keepSelected){
+        if (!m_controller || !m_renderView) return;
+        auto params = std::make_unique<SelectionMaskFilterParameter>();
+        params->mask = m_renderView->selectionMask();
+        params->cloudRevision = m_renderView->selectionRevision();
+        params->keepSelected = keepSelected;
+        m_controller->runFilterSelection(std::move(params));
+    };
+    if (auto a = findChild<QAction*>("actionDeleteSelected")) {
+        connect(a, &QAction::triggered, this, [runSelectionFilter]{ runSelectionFilter(false); });
+    }
+    if (auto a = findChild<QAction*>("actionKeepSelected")) {
+        connect(a, &QAction::triggered, this, [runSelectionFilter]{ runSelectionFilter(true); });
+    }
+    if (auto a = findChild<QAction*>("actionClearSelection")) {
+        connect(a, &QAction::triggered, this, [this]{ if (m_renderView) m_renderView->clearSelection(); });
+    }
+
+    connect(m_renderView, &RenderView::selectionChanged, this, [this](std::size_t selected, std::size_t total){
+        if (selected == 0) m_logPanel->appendLog(tr("Selection cleared."));
+        else m_logPanel->appendLog(tr("Selected %1 of %2 points.").arg(selected).arg(total));
+    });
 }
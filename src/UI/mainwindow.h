@@ -36,6 +36,7 @@ public:
     void ConnectReconstructions();
     void ConnectNormalEstimations();
     void ConnectMeshTools();
+    void ConnectSelectionTools();
 
     explicit MainWindow(QWidget *parent = nullptr);
     ~MainWindow() override;
@@ -52,13 +53,26 @@ private:
     QPointer<ParameterDialog> m_poissonParamDialog {nullptr};
     QPointer<ParameterDialog> m_scaleSpaceParamDialog {nullptr};
     QPointer<ParameterDialog> m_advancingFrontParamDialog {nullptr};
+    QPointer<ParameterDialog> m_screenedPoissonParamDialog {nullptr};
+    QPointer<ParameterDialog> m_voxelReconstructionParamDialog {nullptr};
     // Mesh post-process parameter dialog
     QPointer<ParameterDialog> m_postProcessParamDialog {nullptr};
+    QPointer<ParameterDialog> m_decimateDialog {nullptr};
     // Point cloud operation dialogs
     QPointer<ParameterDialog> m_voxelDownsampleDialog {nullptr};
+    QPointer<ParameterDialog> m_hierarchySimplifyDialog {nullptr};
+    QPointer<ParameterDialog> m_wlopSimplifyDialog {nullptr};
+    QPointer<ParameterDialog> m_bilateralSmoothDialog {nullptr};
     QPointer<ParameterDialog> m_filterAABBDialog {nullptr};
     QPointer<ParameterDialog> m_filterSphereDialog {nullptr};
+    QPointer<ParameterDialog> m_filterOrientedBoxDialog {nullptr};
     QPointer<ParameterDialog> m_uniformSurfaceDialog {nullptr};
+    QPointer<ParameterDialog> m_outlierDialog {nullptr};
+    QPointer<ParameterDialog> m_normalJetDialog {nullptr};
+    QPointer<ParameterDialog> m_normalCentroidDialog {nullptr};
+    QPointer<ParameterDialog> m_normalVCMDialog {nullptr};
+    QPointer<ParameterDialog> m_normalPCADialog {nullptr};
+    QPointer<ParameterDialog> m_orientNormalsDialog {nullptr};
 private:
     void ConnectViewSettings();
     void ConnectSplitPlaneControls();
@@ -37,6 +37,12 @@ void SplitPlaneDocker::BindUIWithRenderView() {
     connect(ui->loc_z, QOverload<double>::of(&QDoubleSpinBox::valueChanged), this, &SplitPlaneDocker::onTransformEdited);
 
     connect(ui->btnRest, &QPushButton::clicked, this, &SplitPlaneDocker::onResetClip);
+    // Applying only makes sense while the plane is shown clipping the view
+    ui->btnApplyClip->setEnabled(m_view && m_view->clipEnabled());
+    if (m_view) {
+        connect(ui->SplitPlaneEnable, &QCheckBox::toggled, ui->btnApplyClip, &QPushButton::setEnabled);
+        connect(ui->btnApplyClip, &QPushButton::clicked, this, [this]{ emit applyClipPlane(m_view->clipPlane()); });
+    }
     connect(ui->btnX, &QPushButton::clicked, this, &SplitPlaneDocker::onAlignToAxisX);
     connect(ui->btnY, &QPushButton::clicked, this, &SplitPlaneDocker::onALignToAxixY);
     connect(ui->btnZ, &QPushButton::clicked, this, &SplitPlaneDocker::onAlignToAxisZ);
@@ -6,6 +6,7 @@
 #define POINTTOMESH_SPLITPLANEDOCKER_H
 
 #include <QDockWidget>
+#include <QVector4D>
 
 
 class RenderView;
@@ -25,6 +26,10 @@ public:
 
     ~SplitPlaneDocker() override;
 
+signals:
+    // Apply button: the current clip plane (n, d); geometry with n·p + d >= 0 is the visible side
+    void applyClipPlane(const QVector4D& plane);
+
 private:
     void BindUIWithRenderView();
 